@@ -1,6 +1,8 @@
 #include "SX127x.h"
 #include "globals.h"
+#include "metrics.h"
 #include <SPI.h>
+#include <esp_timer.h>
 
 /* datarates in bps which will be cycled in NextDataRate() */
 /* static int _rates[] = { 4800, 6618, 8842, 9579, 17241 }; */
@@ -10,6 +12,10 @@ static int _rates[] = { 9579, 17241 };
 bool SX127x::ready()
 {
     byte flags = ReadReg(REG_IRQFLAGS2);
+    if (flags & RF_IRQFLAGS2_FIFOOVERRUN) {
+        metrics.fifo_overruns++;
+        WriteReg(REG_IRQFLAGS2, RF_IRQFLAGS2_FIFOOVERRUN);
+    }
     if (!(flags & RF_IRQFLAGS2_FIFOLEVEL))
         return false;
     if (!(flags & RF_IRQFLAGS2_PAYLOADREADY))
@@ -23,6 +29,7 @@ bool SX127x::Receive(byte &length)
     byte i = 0;
     if (! ready())
         return false;
+    m_rx_us = esp_timer_get_time();
 
     while (ReadReg(REG_IRQFLAGS2) & RF_IRQFLAGS2_PAYLOADREADY) {
         byte bt = GetByteFromFifo();
@@ -51,6 +58,12 @@ byte *SX127x::GetPayloadPointer()
     return &m_payload[0];
 }
 
+/* esp_timer_get_time() when PayloadReady was seen in the last Receive() */
+int64_t SX127x::GetReceiveTime()
+{
+    return m_rx_us;
+}
+
 void SX127x::SetFrequency(unsigned long kHz)
 {
     m_frequency = kHz;
@@ -162,6 +175,7 @@ SX127x::SX127x(byte ss, byte reset)
     m_datarate = 0;
     m_frequency = 868250;
     m_payloadready = false;
+    m_rx_us = 0;
     active_rate_count = 0;
     current_rate_index = 0;
     for (int i = 0; i < 3; i++) {
@@ -15,6 +15,7 @@ private:
     uint8_t m_payload[PAYLOAD_SIZE];
     bool m_payloadready;
     byte m_rssi;
+    int64_t m_rx_us;
     
     // Active data rates configuration
     int active_rates[3];
@@ -35,6 +36,7 @@ public:
     void EnableReceiver(bool enable, int len = 5);
     bool Receive(byte &length);
     byte *GetPayloadPointer();
+    int64_t GetReceiveTime();
     void SetupForLaCrosse();
     int GetDataRate();
     int8_t GetRSSI();
@@ -0,0 +1,242 @@
+/*
+ * Log-Ring: begrenzte MPSC-Queue mit festen Slots (Vyukov). Schreiber
+ * reservieren per CAS einen Slot, kopieren die Zeile und geben ihn frei;
+ * nur der Log-Task liest. Kein Mutex im Schreibpfad, bei vollem Ring
+ * wird die Zeile gezaehlt und verworfen.
+ */
+#include "asynclog.h"
+#include <stdarg.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/semphr.h>
+
+#define LOG_TASK_STACK 3072
+#define LOG_TASK_PRIO 1
+#define LOG_TASK_CORE 0
+#define LOG_DRAIN_MS 20
+#define LOG_LINE_SLOTS 8
+
+struct LogRecord {
+    uint32_t ms;
+    uint8_t level;
+    uint8_t len;
+    char text[LOG_LINE_MAX];
+};
+
+struct LogSlot {
+    volatile uint32_t turn;
+    LogRecord rec;
+};
+
+/* Zeilenpuffer fuer log_append(), einer je Task */
+struct LineBuf {
+    TaskHandle_t owner;
+    uint8_t level;
+    uint8_t len;
+    char text[LOG_LINE_MAX];
+};
+
+volatile uint8_t log_level = LL_INFO;
+volatile uint32_t log_lines = 0;
+volatile uint32_t log_dropped = 0;
+
+LogOut<LL_WARN> LogWarn;
+LogOut<LL_INFO> LogInfo;
+LogOut<LL_DEBUG> LogDebug;
+
+static LogSlot ring[LOG_RING_SIZE];
+static uint32_t ring_head;     // naechster Slot fuer Schreiber
+static uint32_t ring_tail;     // naechster Slot fuer den Log-Task
+static LineBuf lines[LOG_LINE_SLOTS];
+static log_sink_t log_sink;
+static bool started;
+
+static LogRecord tail[LOG_TAIL_SIZE];
+static uint32_t tail_seq;
+static SemaphoreHandle_t tail_mutex;
+
+static const char *level_names[] = { "error", "warn", "info", "debug" };
+
+void log_set_level(LogLevel level)
+{
+    log_level = level;
+}
+
+const char *log_level_name(LogLevel level)
+{
+    return level_names[level];
+}
+
+bool log_parse_level(const char *name, LogLevel *level)
+{
+    for (int l = LL_ERROR; l <= LL_DEBUG; l++) {
+        if (strcmp(name, level_names[l]) == 0) {
+            *level = (LogLevel)l;
+            return true;
+        }
+    }
+    return false;
+}
+
+void log_write(LogLevel level, const char *text, size_t len)
+{
+    if (level > log_level)
+        return;
+    if (len > LOG_LINE_MAX)
+        len = LOG_LINE_MAX;
+    if (!started) {
+        // vor log_start() (setup) direkt ausgeben
+        Serial.write((const uint8_t *)text, len);
+        Serial.write('\n');
+        return;
+    }
+
+    uint32_t pos = __atomic_load_n(&ring_head, __ATOMIC_RELAXED);
+    LogSlot *slot;
+    for (;;) {
+        slot = &ring[pos & (LOG_RING_SIZE - 1)];
+        uint32_t turn = __atomic_load_n(&slot->turn, __ATOMIC_ACQUIRE);
+        int32_t diff = (int32_t)(turn - pos);
+        if (diff == 0) {
+            if (__atomic_compare_exchange_n(&ring_head, &pos, pos + 1, false,
+                                            __ATOMIC_RELAXED, __ATOMIC_RELAXED))
+                break;
+        } else if (diff < 0) {
+            // Ring voll, der Log-Task kommt mit dem UART nicht hinterher
+            __atomic_fetch_add(&log_dropped, 1, __ATOMIC_RELAXED);
+            return;
+        } else {
+            pos = __atomic_load_n(&ring_head, __ATOMIC_RELAXED);
+        }
+    }
+    slot->rec.ms = millis();
+    slot->rec.level = level;
+    slot->rec.len = len;
+    memcpy(slot->rec.text, text, len);
+    __atomic_store_n(&slot->turn, pos + 1, __ATOMIC_RELEASE);
+}
+
+void log_line(LogLevel level, const char *fmt, ...)
+{
+    if (level > log_level)
+        return;
+    char buf[LOG_LINE_MAX + 1];
+    va_list ap;
+    va_start(ap, fmt);
+    int len = vsnprintf(buf, sizeof(buf), fmt, ap);
+    va_end(ap);
+    if (len < 0)
+        return;
+    log_write(level, buf, len < LOG_LINE_MAX ? len : LOG_LINE_MAX);
+}
+
+static LineBuf *line_for_task()
+{
+    TaskHandle_t me = xTaskGetCurrentTaskHandle();
+    for (int i = 0; i < LOG_LINE_SLOTS; i++)
+        if (lines[i].owner == me)
+            return &lines[i];
+    for (int i = 0; i < LOG_LINE_SLOTS; i++)
+        if (__sync_bool_compare_and_swap(&lines[i].owner, (TaskHandle_t)NULL, me))
+            return &lines[i];
+    return NULL;
+}
+
+void log_append(LogLevel level, const uint8_t *buf, size_t len)
+{
+    LineBuf *line = line_for_task();
+    if (!line) {
+        // mehr Tasks als Zeilenpuffer: Bruchstueck als eigene Zeile
+        log_write(level, (const char *)buf, len);
+        return;
+    }
+    // Zeile bekommt das schwerste Level ihrer Bruchstuecke
+    if (line->len == 0 || level < line->level)
+        line->level = level;
+    for (size_t i = 0; i < len; i++) {
+        char c = buf[i];
+        if (c == '\r')
+            continue;
+        if (c == '\n' || line->len == LOG_LINE_MAX) {
+            log_write((LogLevel)line->level, line->text, line->len);
+            line->len = 0;
+            line->level = level;
+            if (c == '\n')
+                continue;
+        }
+        line->text[line->len++] = c;
+    }
+}
+
+void log_set_sink(log_sink_t sink)
+{
+    log_sink = sink;
+}
+
+uint32_t log_tail(String &out, uint32_t since)
+{
+    char prefix[24];
+    if (!started)
+        return 0;
+    xSemaphoreTake(tail_mutex, portMAX_DELAY);
+    uint32_t first = tail_seq > LOG_TAIL_SIZE ? tail_seq - LOG_TAIL_SIZE : 0;
+    if (since > first)
+        first = since;
+    for (uint32_t seq = first; seq < tail_seq; seq++) {
+        const LogRecord &r = tail[seq % LOG_TAIL_SIZE];
+        snprintf(prefix, sizeof(prefix), "%lu %c ", (unsigned long)r.ms, toupper(level_names[r.level][0]));
+        out += prefix;
+        out.concat(r.text, r.len);
+        out += '\n';
+    }
+    uint32_t last = tail_seq;
+    xSemaphoreGive(tail_mutex);
+    return last;
+}
+
+static bool ring_pop(LogRecord *dst)
+{
+    LogSlot *slot = &ring[ring_tail & (LOG_RING_SIZE - 1)];
+    if (__atomic_load_n(&slot->turn, __ATOMIC_ACQUIRE) != ring_tail + 1)
+        return false;
+    memcpy(dst, &slot->rec, sizeof(LogRecord));
+    __atomic_store_n(&slot->turn, ring_tail + LOG_RING_SIZE, __ATOMIC_RELEASE);
+    ring_tail++;
+    return true;
+}
+
+static void log_task(void *arg)
+{
+    LogRecord r;
+    char text[LOG_LINE_MAX + 1];
+    for (;;) {
+        if (!ring_pop(&r)) {
+            delay(LOG_DRAIN_MS);
+            continue;
+        }
+        Serial.write((const uint8_t *)r.text, r.len);
+        Serial.write('\n');
+        log_lines++;
+
+        xSemaphoreTake(tail_mutex, portMAX_DELAY);
+        tail[tail_seq % LOG_TAIL_SIZE] = r;
+        tail_seq++;
+        xSemaphoreGive(tail_mutex);
+
+        if (log_sink && r.level <= LL_WARN && r.len > 0) {
+            memcpy(text, r.text, r.len);
+            text[r.len] = '\0';
+            log_sink((LogLevel)r.level, text);
+        }
+    }
+}
+
+void log_start()
+{
+    for (uint32_t i = 0; i < LOG_RING_SIZE; i++)
+        ring[i].turn = i;
+    tail_mutex = xSemaphoreCreateMutex();
+    started = true;
+    xTaskCreatePinnedToCore(log_task, "log", LOG_TASK_STACK, NULL,
+                            LOG_TASK_PRIO, NULL, LOG_TASK_CORE);
+}
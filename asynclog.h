@@ -0,0 +1,73 @@
+#ifndef _ASYNCLOG_H
+#define _ASYNCLOG_H
+
+#include <Arduino.h>
+
+/*
+ * Gepufferte Log-Ausgabe: Aufrufer formatieren nur in einen Zeilenpuffer
+ * und stellen die fertige Zeile in einen Ring, der Log-Task schreibt sie
+ * auf die serielle Schnittstelle. Ist der Ring voll, wird verworfen statt
+ * zu warten, der Empfang haengt so nie am UART (115200 baud ~ 87us/Zeichen).
+ */
+
+enum LogLevel {
+    LL_ERROR = 0,
+    LL_WARN,
+    LL_INFO,
+    LL_DEBUG
+};
+
+/* hoehere Level werden gar nicht erst uebersetzt */
+#ifndef LOG_LEVEL_MAX
+#define LOG_LEVEL_MAX LL_DEBUG
+#endif
+
+#define LOG_RING_SIZE 32        // Zweierpotenz
+#define LOG_LINE_MAX 160
+#define LOG_TAIL_SIZE 40        // Zeilen fuer /log.txt
+
+extern volatile uint8_t log_level;
+extern volatile uint32_t log_lines;
+extern volatile uint32_t log_dropped;
+
+void log_start();
+void log_set_level(LogLevel level);
+const char *log_level_name(LogLevel level);
+bool log_parse_level(const char *name, LogLevel *level);
+
+/* eine fertige Zeile (ohne '\n') */
+void log_write(LogLevel level, const char *text, size_t len);
+void log_line(LogLevel level, const char *fmt, ...) __attribute__((format(printf, 2, 3)));
+/* Bruchstueck, die Zeile geht beim '\n' raus (je Task ein Zeilenpuffer) */
+void log_append(LogLevel level, const uint8_t *buf, size_t len);
+
+/* Zeilen mit Level <= LL_WARN zusaetzlich hierhin, z.B. MQTT */
+typedef void (*log_sink_t)(LogLevel level, const char *text);
+void log_set_sink(log_sink_t sink);
+
+/* Zeilen mit laufender Nummer > since an out anhaengen, liefert die letzte Nummer */
+uint32_t log_tail(String &out, uint32_t since);
+
+#define LOGE(...) do { if (LL_ERROR <= LOG_LEVEL_MAX) log_line(LL_ERROR, __VA_ARGS__); } while (0)
+#define LOGW(...) do { if (LL_WARN <= LOG_LEVEL_MAX) log_line(LL_WARN, __VA_ARGS__); } while (0)
+#define LOGI(...) do { if (LL_INFO <= LOG_LEVEL_MAX) log_line(LL_INFO, __VA_ARGS__); } while (0)
+#define LOGD(...) do { if (LL_DEBUG <= LOG_LEVEL_MAX) log_line(LL_DEBUG, __VA_ARGS__); } while (0)
+
+/* Ersatz fuer Serial in bestehendem print()/printf()-Code */
+template <LogLevel L>
+class LogOut : public Print {
+public:
+    using Print::write;
+    size_t write(uint8_t c) override { return write(&c, 1); }
+    size_t write(const uint8_t *buf, size_t len) override {
+        if (L <= LOG_LEVEL_MAX && L <= log_level)
+            log_append(L, buf, len);
+        return len;
+    }
+};
+
+extern LogOut<LL_WARN> LogWarn;
+extern LogOut<LL_INFO> LogInfo;
+extern LogOut<LL_DEBUG> LogDebug;
+
+#endif
@@ -0,0 +1,240 @@
+/* generiert von web/embed.py aus web/charts.html, nicht von Hand aendern */
+#ifndef _CHARTS_HTML_H
+#define _CHARTS_HTML_H
+
+#include <Arduino.h>
+
+#define CHARTS_HTML_ETAG "\"ddbc4d7242fbdf00\""
+#define CHARTS_HTML_GZ_LEN 3621   // 9386 Bytes ungepackt
+
+static const uint8_t charts_html_gz[CHARTS_HTML_GZ_LEN] PROGMEM = {
+    0x1f, 0x8b, 0x08, 0x00, 0x00, 0x00, 0x00, 0x00, 0x02, 0x03, 0xb5, 0x5a, 0xeb, 0x72, 0xdb, 0xc6,
+    0x15, 0xfe, 0xaf, 0xa7, 0xd8, 0x30, 0x93, 0x00, 0xb0, 0x49, 0xf0, 0x22, 0x5a, 0x96, 0x45, 0x51,
+    0x19, 0x59, 0x76, 0x12, 0x4f, 0x6d, 0x47, 0xb1, 0x94, 0xba, 0x1d, 0x8d, 0xc6, 0x5d, 0x02, 0x4b,
+    0x02, 0x11, 0x08, 0x20, 0x8b, 0x25, 0x29, 0x5a, 0x51, 0xa7, 0xef, 0xd0, 0x17, 0xe9, 0xbf, 0xfe,
+    0xcf, 0xa3, 0xf4, 0x49, 0xfa, 0x9d, 0x5d, 0x5c, 0x29, 0x4a, 0x76, 0x33, 0xa9, 0x19, 0x1b, 0x8b,
+    0xdd, 0xb3, 0xe7, 0x9c, 0x3d, 0xf7, 0xb3, 0xc8, 0xe1, 0x17, 0x2f, 0x7e, 0x38, 0x39, 0xff, 0xeb,
+    0xe9, 0x4b, 0x16, 0xa8, 0x79, 0x74, 0xb4, 0x73, 0x58, 0x3c, 0x04, 0xf7, 0xf1, 0x98, 0x0b, 0xc5,
+    0x99, 0x17, 0x70, 0x99, 0x09, 0x35, 0x6e, 0xfd, 0x74, 0xfe, 0x6d, 0x67, 0xbf, 0x55, 0x4c, 0xc7,
+    0x7c, 0x2e, 0xc6, 0xad, 0x65, 0x28, 0x56, 0x69, 0x22, 0x55, 0x8b, 0x79, 0x49, 0xac, 0x44, 0x0c,
+    0xb0, 0x55, 0xe8, 0xab, 0x60, 0xec, 0x8b, 0x65, 0xe8, 0x89, 0x8e, 0x7e, 0x69, 0xb3, 0x30, 0x0e,
+    0x55, 0xc8, 0xa3, 0x4e, 0xe6, 0xf1, 0x48, 0x8c, 0xfb, 0x84, 0x44, 0x85, 0x2a, 0x12, 0x47, 0xaf,
+    0xf9, 0x89, 0x4c, 0xb2, 0x4c, 0x0c, 0xde, 0xfc, 0x78, 0x7e, 0xce, 0x4e, 0x40, 0x4a, 0x65, 0x87,
+    0x5d, 0xb3, 0xb6, 0x73, 0xf8, 0x45, 0xa7, 0xb3, 0xc3, 0xd8, 0x8f, 0x0b, 0x11, 0x45, 0x82, 0x4d,
+    0x17, 0x42, 0xb2, 0xae, 0xa7, 0x41, 0x5c, 0xe2, 0xd3, 0x65, 0x6f, 0xb9, 0x17, 0xb0, 0x63, 0x11,
+    0xfb, 0x42, 0x2e, 0xe2, 0x99, 0x88, 0xd9, 0xdf, 0xd2, 0xb5, 0x0a, 0x92, 0x78, 0x97, 0xad, 0xc4,
+    0xa4, 0x2b, 0xe6, 0x13, 0xe1, 0xbb, 0xe9, 0xfa, 0x6f, 0xc0, 0xc1, 0x17, 0x19, 0xf6, 0x07, 0x52,
+    0xc4, 0x6d, 0xe6, 0xf3, 0x8c, 0x09, 0xf9, 0x51, 0x2c, 0x66, 0x8a, 0x19, 0x74, 0x1f, 0x34, 0xba,
+    0x80, 0xd9, 0xb3, 0x8f, 0x61, 0xda, 0x66, 0xa7, 0xef, 0x7e, 0xf8, 0xee, 0xcd, 0xcb, 0x37, 0x8e,
+    0x8b, 0x8d, 0xc7, 0x44, 0xfa, 0x05, 0xc7, 0xd1, 0xd8, 0x55, 0x32, 0x9f, 0xe3, 0xb1, 0x4c, 0x62,
+    0xd6, 0xe5, 0x69, 0xd8, 0x0d, 0xc2, 0x4c, 0x25, 0x72, 0xdd, 0x66, 0x33, 0x21, 0x35, 0x0f, 0x8a,
+    0xad, 0x42, 0xe9, 0xb3, 0x78, 0x21, 0x59, 0x38, 0x67, 0xcf, 0x65, 0xb2, 0xca, 0x84, 0x74, 0x77,
+    0x3a, 0x1d, 0x1c, 0x25, 0x53, 0x6b, 0x3a, 0xd2, 0x81, 0x4c, 0x12, 0xc5, 0x6e, 0x80, 0xb8, 0xd3,
+    0x49, 0x65, 0x38, 0xe7, 0x72, 0xdd, 0xf1, 0x92, 0x28, 0x91, 0x07, 0xec, 0xcb, 0xde, 0x2e, 0x7f,
+    0x36, 0x1d, 0x8e, 0xb0, 0x32, 0xe1, 0xb1, 0x5f, 0x4c, 0xcb, 0xd9, 0x84, 0xdb, 0xbb, 0x6d, 0xd6,
+    0xdf, 0x7b, 0xd6, 0x66, 0x83, 0xe1, 0xb0, 0xcd, 0x7a, 0x6e, 0x7f, 0xdf, 0x19, 0x35, 0x50, 0x4c,
+    0xb8, 0x77, 0x35, 0x93, 0xc9, 0xa2, 0xda, 0xf6, 0x65, 0x5f, 0xff, 0x21, 0x6c, 0x1e, 0x97, 0xfe,
+    0x56, 0x08, 0x8f, 0x7e, 0x4d, 0x44, 0x4a, 0x5c, 0xab, 0x12, 0x40, 0xf4, 0xe9, 0x47, 0x28, 0x32,
+    0x01, 0xf5, 0xfa, 0x77, 0x00, 0x9e, 0x4d, 0xe8, 0x47, 0x00, 0x7e, 0xb8, 0x0c, 0x21, 0x81, 0x72,
+    0x65, 0x30, 0xa5, 0xdf, 0x68, 0xe7, 0x76, 0xe7, 0xc2, 0xe7, 0x8a, 0x77, 0x54, 0x20, 0x60, 0x2e,
+    0x56, 0x14, 0xce, 0x02, 0x65, 0x5d, 0xde, 0x23, 0x80, 0xfe, 0xb3, 0xa7, 0x7b, 0xfe, 0x60, 0xab,
+    0x00, 0x06, 0x4f, 0x20, 0x81, 0xfe, 0x3e, 0x24, 0xd0, 0xef, 0x69, 0x09, 0x3c, 0xf9, 0xb4, 0x04,
+    0xa6, 0x9c, 0x7e, 0x0f, 0x49, 0x60, 0xaa, 0xff, 0x3c, 0x20, 0x81, 0x41, 0x9f, 0x7e, 0x0f, 0x48,
+    0xe0, 0xe9, 0x13, 0xfa, 0x6d, 0x93, 0x80, 0xe8, 0xd1, 0x8f, 0x24, 0xf0, 0x88, 0xdd, 0xb0, 0x49,
+    0x72, 0xdd, 0xc9, 0xc2, 0x8f, 0x61, 0x3c, 0x3b, 0xc0, 0x58, 0x12, 0x20, 0xa6, 0x46, 0xec, 0x76,
+    0x67, 0x92, 0xf8, 0x6b, 0x00, 0x4c, 0xe1, 0x3e, 0x9d, 0x29, 0x9f, 0x87, 0xd1, 0xfa, 0x80, 0x59,
+    0xef, 0x92, 0x49, 0xa2, 0x12, 0xab, 0xcd, 0x3a, 0x3c, 0x4d, 0x23, 0xd1, 0xc9, 0xd6, 0x99, 0x12,
+    0xf3, 0x36, 0xb3, 0xce, 0xc4, 0x2c, 0x11, 0xec, 0xa7, 0x57, 0x58, 0x3a, 0x96, 0xf0, 0xa8, 0x36,
+    0xcb, 0x78, 0x9c, 0x81, 0x3b, 0x19, 0x4e, 0x47, 0x0c, 0x07, 0x98, 0x85, 0xf1, 0x01, 0xeb, 0x8d,
+    0x58, 0xca, 0x7d, 0x5f, 0x53, 0xeb, 0x0f, 0xd2, 0x6b, 0x3a, 0x61, 0x75, 0xfc, 0x03, 0xb6, 0xe4,
+    0xd2, 0xbe, 0x5f, 0x74, 0xce, 0x88, 0xe5, 0x87, 0x68, 0xc2, 0x55, 0x07, 0x77, 0x88, 0xf1, 0xa0,
+    0x5f, 0xb0, 0x8d, 0x83, 0x89, 0x03, 0x36, 0x20, 0x42, 0x66, 0x62, 0x25, 0x48, 0xcf, 0x07, 0x6c,
+    0xd8, 0xeb, 0x55, 0x4c, 0x0d, 0xd3, 0x6b, 0xd6, 0x33, 0xec, 0x60, 0x37, 0xc7, 0xe6, 0xad, 0x54,
+    0x2a, 0x02, 0xee, 0x4c, 0x86, 0x3e, 0xc0, 0xfc, 0x30, 0x4b, 0x23, 0x0e, 0xb1, 0xd0, 0xfb, 0x48,
+    0xff, 0x0b, 0x5e, 0xe6, 0x98, 0x53, 0x82, 0xc0, 0x17, 0xf3, 0x38, 0x83, 0x99, 0x88, 0x54, 0x70,
+    0x65, 0xf3, 0x85, 0x4a, 0x3a, 0xd3, 0x30, 0x82, 0x64, 0xe6, 0x61, 0x3c, 0xe7, 0xd7, 0xf6, 0x60,
+    0xd8, 0x4b, 0xaf, 0x61, 0x3d, 0x53, 0xe9, 0x00, 0xed, 0x8c, 0xa7, 0x07, 0x25, 0x13, 0x2e, 0x19,
+    0x06, 0x69, 0xe7, 0x8e, 0x6c, 0xb6, 0x5a, 0x0c, 0xb6, 0x1b, 0xdd, 0x01, 0x03, 0x0e, 0x93, 0x25,
+    0x11, 0xf8, 0x33, 0xf0, 0x0d, 0xed, 0x97, 0x70, 0x1d, 0xc9, 0xfd, 0x70, 0x01, 0xe6, 0xf6, 0x89,
+    0x5e, 0x53, 0x25, 0x44, 0x3e, 0x4b, 0xb9, 0xbc, 0x22, 0x41, 0x2c, 0x64, 0x46, 0x92, 0x48, 0x93,
+    0x10, 0x41, 0x54, 0x56, 0x6b, 0x07, 0x41, 0xb2, 0x44, 0xd4, 0xbb, 0x29, 0xf0, 0x7d, 0x4a, 0x62,
+    0x06, 0xa1, 0x4b, 0xe1, 0xbb, 0x2e, 0xb8, 0x69, 0x24, 0x40, 0xf0, 0xe7, 0x45, 0xa6, 0xc2, 0x29,
+    0xc1, 0xeb, 0x48, 0x7d, 0xc0, 0x00, 0x8d, 0x10, 0x3d, 0x11, 0x6a, 0x25, 0x44, 0x3c, 0xaa, 0xeb,
+    0xb2, 0xbf, 0x4b, 0x1c, 0x36, 0xa8, 0x6d, 0x73, 0x80, 0x06, 0xd1, 0x25, 0x8f, 0x36, 0x0c, 0xa2,
+    0x47, 0x48, 0x1a, 0xea, 0xaf, 0xc1, 0x7b, 0x3c, 0x5e, 0x22, 0x10, 0xdf, 0x30, 0x9d, 0x22, 0x40,
+    0xb2, 0xd7, 0xfb, 0x6a, 0xc4, 0x82, 0xc2, 0x72, 0xb4, 0xc4, 0xca, 0x03, 0x4c, 0xa2, 0xc4, 0xbb,
+    0xa2, 0xcd, 0x5f, 0xfa, 0xc8, 0x3d, 0x21, 0x11, 0x32, 0x78, 0xe1, 0x45, 0x4a, 0x25, 0xf3, 0x42,
+    0xa6, 0xe5, 0x86, 0x38, 0x89, 0x45, 0x1d, 0xfe, 0x61, 0x6a, 0xbb, 0x86, 0xd5, 0x4d, 0x72, 0x85,
+    0x5a, 0x3c, 0x4a, 0x51, 0x01, 0x0f, 0x8d, 0x62, 0x26, 0x5c, 0xde, 0x95, 0x2d, 0xfd, 0xdb, 0x59,
+    0x49, 0x32, 0x2e, 0xfa, 0x77, 0xc4, 0x38, 0x42, 0x5d, 0xdc, 0x09, 0x61, 0xa7, 0x50, 0xbf, 0x27,
+    0x8c, 0x5a, 0xb5, 0xf1, 0xed, 0x55, 0x52, 0x29, 0xb9, 0xdf, 0xcf, 0x0d, 0x82, 0x70, 0xbb, 0x3a,
+    0xfb, 0x91, 0x28, 0x81, 0x13, 0x9c, 0x36, 0x15, 0xb3, 0x67, 0x20, 0x27, 0x0b, 0x6c, 0x8c, 0x37,
+    0x4c, 0xd7, 0x1c, 0xfa, 0xd3, 0xbe, 0xfb, 0x99, 0x46, 0x4c, 0x41, 0xa3, 0x69, 0xc6, 0xc3, 0x86,
+    0x19, 0x93, 0x46, 0xfb, 0x5a, 0x70, 0x5b, 0xec, 0xd7, 0x30, 0xe8, 0x1a, 0x1e, 0x3f, 0xc3, 0x78,
+    0x3f, 0x65, 0xd9, 0x01, 0x30, 0x37, 0xcd, 0xcb, 0x68, 0xfc, 0xf3, 0x6c, 0xf4, 0xb0, 0x9b, 0xe7,
+    0xdf, 0xc3, 0x6e, 0x5e, 0xda, 0x50, 0xd8, 0xa5, 0x42, 0xa7, 0x7f, 0x64, 0x8a, 0x0e, 0x76, 0x08,
+    0xb3, 0x8c, 0x99, 0x17, 0xf1, 0x2c, 0x1b, 0xb7, 0x88, 0x5a, 0xeb, 0xe8, 0x90, 0x33, 0x54, 0x0c,
+    0xd3, 0x71, 0xab, 0xdb, 0x3a, 0x22, 0x39, 0x1f, 0x76, 0xf9, 0x11, 0x30, 0x01, 0x0e, 0x0f, 0xec,
+    0xdc, 0x39, 0x84, 0xc4, 0x58, 0xe8, 0x8f, 0x5b, 0xc6, 0xca, 0x5a, 0xc5, 0x76, 0x8a, 0x1e, 0xa8,
+    0x71, 0x18, 0xd3, 0x00, 0xf9, 0x24, 0x74, 0xab, 0xe7, 0x58, 0x93, 0x94, 0xd6, 0x76, 0xcb, 0x60,
+    0x31, 0xe3, 0x82, 0x86, 0x81, 0xcd, 0x35, 0xad, 0xb3, 0xa8, 0x1c, 0xb7, 0x06, 0xfd, 0xbd, 0x5e,
+    0xaf, 0x75, 0xb4, 0xc7, 0x82, 0xc3, 0xae, 0x59, 0x3a, 0xda, 0x04, 0xd9, 0xdf, 0x1b, 0x12, 0xc8,
+    0x60, 0x58, 0x83, 0xd9, 0x8a, 0x6b, 0xaf, 0x37, 0xdc, 0x27, 0xc8, 0xa7, 0xcc, 0xbf, 0x17, 0xd9,
+    0xe0, 0xc9, 0xb3, 0x41, 0x8f, 0x80, 0x76, 0x7b, 0x35, 0xa8, 0x06, 0x3a, 0xcd, 0xba, 0x17, 0x25,
+    0x19, 0x58, 0xff, 0x5a, 0x85, 0x73, 0x91, 0x8d, 0xea, 0x80, 0x87, 0x5d, 0x08, 0x41, 0x0f, 0x72,
+    0x27, 0x34, 0xf0, 0x7a, 0x4c, 0x67, 0x35, 0xa3, 0x4d, 0x69, 0x69, 0x0d, 0x18, 0xd0, 0x30, 0x9e,
+    0x26, 0xad, 0x23, 0x5f, 0xf2, 0x19, 0x53, 0x09, 0xfb, 0x98, 0x24, 0x48, 0x84, 0x7e, 0xb2, 0x98,
+    0xc0, 0x49, 0xbc, 0x28, 0xf4, 0xae, 0x68, 0x56, 0x0a, 0x94, 0xa8, 0x39, 0xa5, 0xe2, 0x51, 0xc3,
+    0x46, 0x39, 0xc3, 0x60, 0xd3, 0xa3, 0xa3, 0x02, 0x24, 0xf3, 0x64, 0x98, 0xaa, 0xa3, 0x1d, 0x98,
+    0x4d, 0xa6, 0xd8, 0x02, 0x55, 0x6a, 0xc6, 0xc6, 0x30, 0x33, 0x4a, 0x2f, 0x48, 0xc3, 0xbf, 0xfd,
+    0xeb, 0x04, 0x89, 0x96, 0x5e, 0x3e, 0x78, 0xc1, 0xa0, 0x9c, 0x08, 0x16, 0xf3, 0x10, 0x2f, 0x5f,
+    0x61, 0xb8, 0x0a, 0x63, 0xff, 0x43, 0x96, 0x0a, 0x01, 0xf7, 0xb3, 0xae, 0xe6, 0xdd, 0xa0, 0x98,
+    0x9b, 0x21, 0xd8, 0x96, 0x53, 0x38, 0x9b, 0x9e, 0x9c, 0x08, 0x2e, 0xb5, 0xeb, 0x00, 0x11, 0x00,
+    0x25, 0xa7, 0xc0, 0x68, 0xcd, 0xe7, 0x18, 0xa7, 0xc9, 0x8a, 0x5c, 0xd2, 0x7a, 0x8f, 0xb1, 0x88,
+    0x85, 0x9c, 0x51, 0x19, 0x70, 0xf5, 0x9e, 0xf0, 0xa5, 0x38, 0x5c, 0xb6, 0x90, 0x30, 0x79, 0x2b,
+    0x38, 0xe5, 0x98, 0x58, 0x2c, 0x31, 0xc4, 0x53, 0x57, 0x53, 0x1f, 0xa2, 0x05, 0xa2, 0x84, 0x15,
+    0x5d, 0x5b, 0xec, 0x76, 0x94, 0x1f, 0xc4, 0xcb, 0xe8, 0x18, 0x31, 0x1b, 0x1f, 0xa1, 0x36, 0x55,
+    0x27, 0xc9, 0x3c, 0x5d, 0x28, 0xe1, 0x9f, 0x91, 0x0b, 0xd8, 0x7e, 0xe2, 0x2d, 0x50, 0xc6, 0x2a,
+    0x97, 0x3c, 0xc0, 0x71, 0xb1, 0x7e, 0x2a, 0x93, 0x14, 0xc5, 0xeb, 0xfa, 0xcf, 0x3c, 0x5a, 0x08,
+    0x3b, 0x76, 0x5c, 0x05, 0xf7, 0xb3, 0xe1, 0xff, 0x0d, 0x50, 0x17, 0x02, 0x3e, 0x56, 0x58, 0x82,
+    0x66, 0x85, 0x6d, 0x55, 0x55, 0x1d, 0x31, 0x92, 0xa0, 0xae, 0x3f, 0x43, 0x31, 0xcc, 0x67, 0x82,
+    0x30, 0xbe, 0x82, 0xc8, 0x6c, 0xcb, 0xac, 0x3a, 0xec, 0xd7, 0x5f, 0x19, 0xc0, 0xe5, 0x95, 0x05,
+    0x94, 0x3b, 0xd3, 0x45, 0xec, 0xa9, 0x10, 0x56, 0x13, 0xf1, 0x89, 0x88, 0xec, 0xcc, 0x81, 0xb4,
+    0xa5, 0x50, 0x0b, 0x19, 0x33, 0x3b, 0x73, 0xa9, 0xa9, 0x20, 0x78, 0xdb, 0x7a, 0xf5, 0x82, 0x59,
+    0xec, 0x31, 0xcb, 0xdc, 0xd0, 0x77, 0x1c, 0x0c, 0x2c, 0xf6, 0xdb, 0xbf, 0xf3, 0x19, 0xb4, 0x1f,
+    0x32, 0xf4, 0xc8, 0xad, 0x2b, 0x6c, 0x53, 0xa1, 0xbc, 0xe0, 0x0c, 0x55, 0x90, 0xc8, 0xec, 0xac,
+    0xcd, 0xa6, 0x92, 0x8c, 0x44, 0x25, 0x6d, 0x13, 0x92, 0x88, 0x0a, 0x74, 0x60, 0x84, 0x83, 0x4a,
+    0x2a, 0x85, 0x74, 0xde, 0x70, 0x15, 0xb8, 0x54, 0x1f, 0xf4, 0xdb, 0x66, 0xec, 0x89, 0x30, 0xb2,
+    0x6d, 0xd8, 0x52, 0x47, 0x6f, 0x77, 0x58, 0xb7, 0xd8, 0xac, 0x43, 0xa1, 0xd9, 0xfc, 0x0b, 0x76,
+    0x5a, 0xf5, 0xea, 0xff, 0x9b, 0x4c, 0xc4, 0x88, 0x7d, 0xe3, 0x82, 0x59, 0x62, 0xf5, 0x6b, 0xc3,
+    0xe1, 0xb8, 0xce, 0xae, 0x9e, 0x27, 0xbc, 0x7a, 0x96, 0x06, 0x7a, 0x46, 0x25, 0xfa, 0x1d, 0x54,
+    0xe9, 0x8d, 0x58, 0x33, 0xbb, 0x30, 0x20, 0xa2, 0xb9, 0x64, 0xf4, 0xe9, 0xec, 0x5f, 0xa0, 0x99,
+    0x40, 0xc4, 0xb6, 0x24, 0xbd, 0x4a, 0xf7, 0xe7, 0x2c, 0x89, 0x6d, 0x27, 0x9f, 0xf3, 0x69, 0x0e,
+    0xcd, 0x8e, 0x61, 0x78, 0xc4, 0x58, 0xb7, 0xcb, 0x2e, 0x94, 0xae, 0x81, 0xda, 0x8c, 0x2f, 0x67,
+    0x18, 0x71, 0x14, 0x41, 0x1e, 0x12, 0x85, 0xba, 0x44, 0x4d, 0xba, 0xd3, 0x7d, 0xc4, 0x4e, 0x72,
+    0x77, 0x8c, 0xd9, 0x77, 0x42, 0x72, 0x01, 0x92, 0xe1, 0xb5, 0x88, 0x62, 0xb2, 0x2b, 0x31, 0xa5,
+    0x6e, 0xe6, 0x4f, 0x54, 0x28, 0x5c, 0x93, 0x5f, 0xf8, 0xec, 0xe4, 0xec, 0xac, 0xf3, 0x9d, 0x4c,
+    0x60, 0x89, 0x82, 0x3d, 0xea, 0x56, 0x82, 0x87, 0x71, 0x22, 0x9d, 0x0b, 0xdb, 0x5b, 0xd6, 0x65,
+    0xec, 0xa7, 0x60, 0x52, 0xdb, 0x7c, 0xb2, 0x72, 0x4d, 0x2b, 0x78, 0x4a, 0xc8, 0xdf, 0x71, 0x6c,
+    0x22, 0x05, 0x43, 0xe8, 0x2b, 0x40, 0x78, 0x4b, 0x17, 0x2e, 0x0c, 0x13, 0x7b, 0x6f, 0xfa, 0xc4,
+    0xa0, 0x3e, 0xf7, 0xbd, 0xce, 0xce, 0x5a, 0xf6, 0x4b, 0x57, 0xe7, 0x6d, 0xc2, 0xc9, 0x1e, 0x11,
+    0xf6, 0x11, 0xcd, 0x99, 0xf4, 0x8d, 0xc9, 0x20, 0x9f, 0x2c, 0xe9, 0xcf, 0x0c, 0x1e, 0x6d, 0xfc,
+    0xfa, 0x0c, 0xb6, 0x35, 0xf0, 0x2d, 0xad, 0xc7, 0x19, 0x19, 0xf2, 0xb9, 0x44, 0xd5, 0x3c, 0x4d,
+    0xe4, 0xdc, 0xc6, 0x36, 0xf4, 0x13, 0xfa, 0xbf, 0x72, 0x98, 0xc3, 0x79, 0x11, 0xdc, 0xf5, 0x9d,
+    0xf0, 0x94, 0x6d, 0xd6, 0x57, 0xe0, 0xcf, 0xa9, 0x69, 0xe5, 0x86, 0xcd, 0xcc, 0x24, 0x39, 0x5e,
+    0xdd, 0x18, 0x81, 0x7c, 0x26, 0xec, 0x54, 0xd5, 0x0c, 0xd1, 0x08, 0x27, 0x12, 0x0a, 0xbe, 0x02,
+    0xde, 0x5e, 0xc5, 0x53, 0x6a, 0x89, 0xd1, 0x3b, 0x06, 0x21, 0x5e, 0x3b, 0xc5, 0x3b, 0x61, 0xc7,
+    0x3e, 0x17, 0xac, 0xbd, 0x44, 0x6f, 0x6b, 0xa7, 0xa4, 0xd6, 0x1b, 0xb3, 0xc7, 0x18, 0x6c, 0x18,
+    0xdb, 0x11, 0x99, 0xf5, 0x45, 0xff, 0x12, 0x6a, 0xd6, 0xbb, 0x4b, 0x4b, 0x0e, 0x42, 0x5a, 0xd8,
+    0xa5, 0x85, 0x5b, 0xcd, 0x68, 0x38, 0x65, 0x36, 0xed, 0x1d, 0x43, 0x44, 0xa1, 0x63, 0x10, 0x75,
+    0xc6, 0x54, 0x52, 0x60, 0xe3, 0x63, 0x3d, 0xb8, 0xad, 0x9f, 0xa7, 0x72, 0x1b, 0xa2, 0x01, 0x98,
+    0x8d, 0x83, 0xe9, 0xca, 0x2d, 0x0a, 0x63, 0x52, 0x77, 0x9b, 0x6d, 0x39, 0xa0, 0x91, 0x7e, 0x4d,
+    0x30, 0x60, 0xaf, 0x66, 0x21, 0x05, 0x4f, 0x5f, 0xd0, 0x19, 0x23, 0x11, 0xcf, 0x54, 0xe0, 0xe4,
+    0xd4, 0x2b, 0xdd, 0x91, 0xe5, 0x6c, 0x93, 0x60, 0x05, 0x71, 0x0d, 0x08, 0x45, 0x92, 0xb1, 0x15,
+    0x9c, 0x55, 0xba, 0x85, 0xbb, 0xda, 0xd2, 0xd5, 0xee, 0x5b, 0xcc, 0x3c, 0x22, 0x26, 0xd6, 0x00,
+    0x5e, 0x12, 0x70, 0x80, 0x95, 0x01, 0xfe, 0xda, 0x4b, 0x0d, 0x12, 0x25, 0xf9, 0x16, 0x1c, 0xb3,
+    0x78, 0x7f, 0xc4, 0x6c, 0x82, 0x1a, 0x16, 0x86, 0xa2, 0x64, 0x72, 0x25, 0x74, 0xd8, 0x24, 0x7b,
+    0xca, 0x32, 0xdb, 0xda, 0xa8, 0x4d, 0x2c, 0xea, 0x28, 0x5c, 0x92, 0xc8, 0xfb, 0xdc, 0x3e, 0xfb,
+    0xee, 0x13, 0x9a, 0x9a, 0x08, 0x94, 0x77, 0xa7, 0x50, 0x8c, 0xed, 0x6c, 0xea, 0xd4, 0x4e, 0xdb,
+    0x0c, 0xca, 0x00, 0x47, 0x21, 0xfb, 0x26, 0xdf, 0x7d, 0x9e, 0xd8, 0xd7, 0x76, 0x7a, 0xd1, 0xbb,
+    0x74, 0xc0, 0x30, 0x06, 0x83, 0x4b, 0x04, 0x3d, 0x34, 0x3c, 0xee, 0x1c, 0xf5, 0xff, 0xb6, 0xc5,
+    0x06, 0x87, 0x44, 0xa3, 0x11, 0x0c, 0xe7, 0xea, 0x1c, 0x69, 0xd8, 0x86, 0xff, 0x53, 0x21, 0xd1,
+    0x70, 0x4c, 0xca, 0x0b, 0x62, 0xa5, 0x6f, 0x34, 0x20, 0xbd, 0x47, 0x54, 0x08, 0xf7, 0x80, 0x37,
+    0x2d, 0xf2, 0xc5, 0x99, 0xa2, 0x0c, 0x45, 0x59, 0x00, 0x75, 0xde, 0x99, 0x42, 0x69, 0x64, 0x0f,
+    0xd0, 0x77, 0xf6, 0xac, 0x9a, 0xfc, 0x83, 0x39, 0xa9, 0xd5, 0xf6, 0xc9, 0xbf, 0xbe, 0x4f, 0x50,
+    0xfb, 0xd9, 0x26, 0x44, 0x1f, 0x50, 0xe8, 0xca, 0xe7, 0xdf, 0x84, 0x31, 0xf2, 0x04, 0xad, 0xd4,
+    0x3c, 0x46, 0xd7, 0x3d, 0x47, 0xac, 0xff, 0x74, 0x80, 0xba, 0x03, 0x87, 0xcf, 0x61, 0x35, 0x33,
+    0x06, 0x85, 0x5b, 0x47, 0x01, 0xd7, 0x85, 0xfc, 0x30, 0xd1, 0xaf, 0xd6, 0xec, 0x02, 0xc7, 0xa0,
+    0xf7, 0x6c, 0x4f, 0x23, 0xb1, 0x2c, 0x48, 0xca, 0xd2, 0xb9, 0x21, 0x98, 0x93, 0xd4, 0x82, 0xf9,
+    0x28, 0x8f, 0x70, 0x2f, 0x74, 0x59, 0x06, 0x57, 0x0f, 0x3d, 0x2a, 0xf3, 0xe1, 0x3c, 0x5d, 0xf8,
+    0x49, 0xe7, 0x39, 0x8f, 0x7d, 0x04, 0xfd, 0x50, 0x29, 0x11, 0xa1, 0x50, 0xcf, 0xd8, 0x6b, 0x38,
+    0x9f, 0x40, 0x47, 0xed, 0x05, 0x88, 0xe6, 0x14, 0xde, 0xcc, 0x39, 0xe9, 0x72, 0x4b, 0x97, 0x03,
+    0x28, 0x7d, 0xe3, 0x05, 0xb5, 0x94, 0x64, 0x57, 0x07, 0x14, 0x0b, 0x54, 0xa2, 0x1f, 0xd0, 0xeb,
+    0x01, 0xbb, 0xb8, 0x84, 0x9c, 0x45, 0x64, 0x60, 0xc8, 0x65, 0x2a, 0x4d, 0xa0, 0x68, 0x59, 0x19,
+    0x26, 0xec, 0xba, 0x16, 0x3c, 0x18, 0x24, 0x2b, 0xb3, 0x2b, 0x8e, 0xfa, 0x32, 0x12, 0x34, 0x7c,
+    0xbe, 0x7e, 0xe5, 0x23, 0xb5, 0x9a, 0x8a, 0xc8, 0x82, 0x5a, 0x1e, 0xf4, 0x24, 0x83, 0x2b, 0xd5,
+    0x25, 0x0b, 0xb1, 0xea, 0x6a, 0x7f, 0x79, 0x8d, 0xb7, 0xe1, 0x7e, 0x9b, 0x3d, 0xc7, 0x73, 0x40,
+    0x2c, 0xae, 0x74, 0xd4, 0xec, 0x60, 0x01, 0x96, 0x8d, 0xf7, 0x40, 0x07, 0xcc, 0x0e, 0x00, 0xf0,
+    0x7e, 0xaf, 0xdb, 0x69, 0x84, 0xc6, 0xf7, 0xf4, 0x70, 0xbb, 0x03, 0xbe, 0x26, 0x8d, 0x7c, 0xca,
+    0x09, 0xd3, 0xba, 0x17, 0x0e, 0x49, 0xbf, 0xc1, 0xa7, 0xdc, 0x30, 0x0d, 0x8c, 0x7d, 0x53, 0xb9,
+    0x4f, 0x19, 0xb7, 0xaf, 0x5b, 0x95, 0xf2, 0xa6, 0xc3, 0x22, 0x17, 0xa3, 0x26, 0x7f, 0xc3, 0x37,
+    0xb7, 0xd5, 0xff, 0xc6, 0x45, 0xb7, 0xba, 0x72, 0xa3, 0xdf, 0x29, 0xb2, 0x43, 0xc3, 0x99, 0x69,
+    0x0a, 0x7e, 0x8b, 0x28, 0x8a, 0xc8, 0x4d, 0xb1, 0x16, 0x1d, 0x6c, 0xc8, 0x0e, 0x21, 0x61, 0x3c,
+    0x1f, 0x3f, 0x36, 0x3a, 0x2d, 0xa4, 0x42, 0x4a, 0xa5, 0x03, 0x90, 0x4c, 0x36, 0xce, 0x13, 0xe2,
+    0x8c, 0x90, 0xfd, 0x7a, 0x5d, 0x84, 0x6b, 0xdd, 0xb1, 0xd9, 0x6b, 0x7b, 0xa9, 0xcd, 0xbe, 0x87,
+    0xa0, 0xa1, 0x11, 0x35, 0x03, 0x47, 0xe5, 0xff, 0xaf, 0x69, 0x6f, 0x19, 0x6b, 0x30, 0xb1, 0x32,
+    0xca, 0xcc, 0x27, 0xab, 0x30, 0x60, 0x90, 0xd0, 0xe9, 0x8f, 0xa9, 0x01, 0x25, 0xd9, 0x49, 0x7d,
+    0xe7, 0x56, 0x48, 0xec, 0x9c, 0x92, 0xe1, 0x12, 0x2a, 0xfa, 0x16, 0xf9, 0xd8, 0xb7, 0xfb, 0x4e,
+    0xbb, 0x30, 0x0c, 0x30, 0xf7, 0x38, 0x0f, 0x7d, 0xb7, 0x3b, 0x77, 0xb0, 0x98, 0x16, 0xd6, 0xba,
+    0x57, 0x20, 0x4f, 0xb6, 0x08, 0x44, 0x69, 0x81, 0xe4, 0xb5, 0xce, 0x5d, 0xbb, 0x20, 0xa1, 0x94,
+    0xe7, 0x2e, 0x79, 0xab, 0x05, 0xaf, 0xe6, 0x8e, 0x76, 0x95, 0x01, 0xcb, 0x8c, 0x77, 0x6d, 0x2b,
+    0x7d, 0x80, 0xc7, 0x30, 0x75, 0xa7, 0xad, 0xcd, 0x7c, 0x30, 0x74, 0xda, 0xac, 0x8a, 0xe2, 0xb7,
+    0x79, 0xca, 0xa9, 0x67, 0x9c, 0x9b, 0x1a, 0xcd, 0x0d, 0x93, 0xa8, 0x2e, 0x1e, 0x8d, 0xdd, 0x6c,
+    0xc4, 0xf1, 0xff, 0x3d, 0x92, 0xef, 0x3e, 0x14, 0xc9, 0x77, 0x8b, 0x48, 0xbe, 0x21, 0xd4, 0x8a,
+    0x59, 0x9c, 0xa3, 0x4f, 0x12, 0x3e, 0x32, 0x92, 0xee, 0x74, 0x9c, 0x06, 0x1d, 0x95, 0x5d, 0x84,
+    0x97, 0x25, 0x3e, 0xf3, 0x86, 0xc2, 0xc0, 0xa9, 0x4b, 0xb5, 0x32, 0x8b, 0x3f, 0x2e, 0x9f, 0xfd,
+    0xbf, 0x32, 0x1a, 0xdb, 0x30, 0xe6, 0x42, 0x7b, 0x3a, 0x04, 0x21, 0xc6, 0x7e, 0xbe, 0xee, 0x6a,
+    0x60, 0xba, 0x84, 0x2b, 0x6d, 0xa7, 0x40, 0x05, 0xea, 0x79, 0x68, 0xa3, 0x97, 0x3e, 0xb1, 0x32,
+    0xcc, 0x4d, 0x8c, 0x4f, 0x32, 0xbb, 0xb6, 0x02, 0x1d, 0xd4, 0x36, 0x51, 0xb2, 0x0c, 0x4a, 0xe6,
+    0x4c, 0x6c, 0xa4, 0x78, 0x88, 0x00, 0xa5, 0xcb, 0xf2, 0xc2, 0xdc, 0xf1, 0x8e, 0x98, 0xab, 0xbb,
+    0x08, 0xaa, 0x59, 0x37, 0xcc, 0xbf, 0x99, 0xb0, 0xa3, 0x84, 0xfb, 0x79, 0x9a, 0x68, 0xd6, 0x53,
+    0x65, 0x14, 0x2e, 0xe2, 0xc6, 0x34, 0x4a, 0x12, 0x69, 0x1b, 0x14, 0x45, 0x60, 0x2e, 0xd6, 0x74,
+    0x03, 0xd3, 0x88, 0xd3, 0x9f, 0x99, 0x67, 0xb4, 0x53, 0xd7, 0x1a, 0x28, 0x73, 0xda, 0x6d, 0x39,
+    0xa0, 0xe6, 0x83, 0x4f, 0x7a, 0x48, 0x2e, 0xcd, 0xfa, 0xbd, 0x68, 0x46, 0x4c, 0xd5, 0xaa, 0x35,
+    0x50, 0xe4, 0x25, 0x12, 0xd0, 0xa8, 0x91, 0x0e, 0x8d, 0x86, 0xee, 0x67, 0x8e, 0xba, 0x7e, 0xcb,
+    0xd1, 0x41, 0xe8, 0xc4, 0x5c, 0x58, 0x12, 0x8e, 0xc2, 0x2d, 0xa8, 0x21, 0x34, 0xcd, 0x0e, 0xf5,
+    0x85, 0x9f, 0x71, 0x37, 0xa0, 0x23, 0xd7, 0xed, 0x86, 0xdc, 0xd1, 0xf7, 0xc6, 0x39, 0x3f, 0x59,
+    0xbd, 0x56, 0x32, 0x02, 0x00, 0xbd, 0x2c, 0x17, 0xb2, 0x2e, 0x3a, 0xc6, 0x1a, 0x82, 0xf0, 0xdc,
+    0xcf, 0xb5, 0x46, 0x06, 0xb6, 0xf5, 0x75, 0x93, 0x9b, 0x5f, 0x12, 0x52, 0xfc, 0xd4, 0x57, 0x8a,
+    0xd6, 0xc3, 0x9b, 0xf5, 0xf5, 0xcf, 0x9d, 0x33, 0x97, 0x8d, 0x32, 0x8c, 0x4a, 0xdf, 0x50, 0x5c,
+    0x14, 0x3d, 0xe5, 0x25, 0x55, 0x3f, 0xe8, 0x95, 0xb1, 0xb2, 0xb9, 0x00, 0xf9, 0x38, 0xba, 0x2e,
+    0x32, 0xda, 0x2d, 0x69, 0xfe, 0xb2, 0x10, 0x72, 0x7d, 0x26, 0x22, 0xb8, 0x44, 0x22, 0x8f, 0x11,
+    0x1c, 0xac, 0xe2, 0x86, 0xd4, 0x5c, 0xd8, 0x98, 0xaf, 0x35, 0xf2, 0x12, 0x5c, 0x14, 0xde, 0x3d,
+    0x21, 0x6d, 0x4e, 0x5c, 0x7d, 0x93, 0xf2, 0x1a, 0x4d, 0x2f, 0xcc, 0x60, 0x36, 0x8b, 0x84, 0x6d,
+    0x25, 0x31, 0x5a, 0xff, 0xc7, 0x13, 0x97, 0xb6, 0x40, 0xc2, 0xae, 0xd4, 0x8d, 0x86, 0x96, 0x62,
+    0xcd, 0x06, 0xe3, 0x84, 0x0a, 0x10, 0x2a, 0xf1, 0x5c, 0x0c, 0x6d, 0x72, 0x08, 0xaa, 0x39, 0x09,
+    0xa0, 0x66, 0xf6, 0x04, 0xd5, 0xd1, 0x7b, 0xdb, 0xb4, 0x43, 0xef, 0xcf, 0xdb, 0xc7, 0xcc, 0x93,
+    0x09, 0x72, 0x43, 0x62, 0xe7, 0xad, 0x19, 0x14, 0x68, 0x97, 0x1a, 0xfc, 0x3d, 0x65, 0x55, 0xad,
+    0x76, 0x22, 0xc7, 0x15, 0x74, 0x3e, 0x91, 0xdb, 0xf1, 0x5f, 0xc0, 0x85, 0x69, 0x1c, 0x9f, 0x53,
+    0x86, 0x46, 0x29, 0x7c, 0xa2, 0xe7, 0x75, 0x0c, 0x71, 0x60, 0x7d, 0xd3, 0xa2, 0x21, 0xe5, 0xbe,
+    0xff, 0x72, 0x89, 0x15, 0x12, 0x09, 0x5d, 0xd8, 0xd8, 0xd6, 0x3c, 0x59, 0x64, 0x02, 0x1c, 0x93,
+    0x58, 0x84, 0x69, 0xdc, 0x8a, 0xb8, 0x01, 0x32, 0x17, 0xe9, 0xb5, 0x2d, 0x28, 0x78, 0xd0, 0xe3,
+    0xb2, 0xe8, 0xd0, 0xee, 0x47, 0x44, 0x71, 0xb2, 0x42, 0xb4, 0x11, 0x04, 0xeb, 0x81, 0x4b, 0xc7,
+    0x1e, 0xe0, 0xdc, 0x70, 0x2f, 0x54, 0x8c, 0xb7, 0x75, 0x31, 0xde, 0x43, 0x66, 0x91, 0x82, 0x88,
+    0xed, 0x54, 0x1e, 0xab, 0xfb, 0xb3, 0x8a, 0x54, 0xd5, 0x9d, 0x15, 0x42, 0xe3, 0x45, 0xb9, 0xa9,
+    0xae, 0x3f, 0x23, 0xaa, 0xe2, 0xc4, 0x93, 0x3b, 0x1b, 0x90, 0xb9, 0xef, 0xdf, 0x30, 0xaa, 0x02,
+    0x87, 0x91, 0x1c, 0x95, 0xd5, 0xa3, 0x92, 0xb7, 0x09, 0x34, 0xc4, 0xd1, 0x00, 0xec, 0xf5, 0x9c,
+    0xba, 0x01, 0x71, 0xd0, 0xc1, 0xa1, 0x45, 0x94, 0x89, 0x3b, 0x61, 0xe6, 0x01, 0x51, 0xfb, 0x93,
+    0x48, 0xc7, 0x89, 0x52, 0x08, 0xb5, 0x90, 0xd0, 0x08, 0x83, 0x95, 0x59, 0xff, 0x01, 0xbe, 0x94,
+    0xc4, 0x26, 0x38, 0x8d, 0xef, 0x27, 0x5a, 0xf7, 0xab, 0x0d, 0xba, 0x77, 0x0d, 0x9b, 0xee, 0x5e,
+    0x41, 0x65, 0x13, 0xed, 0xcd, 0xef, 0x09, 0x54, 0xf4, 0x11, 0x01, 0xd5, 0xe2, 0xed, 0x83, 0xa6,
+    0x83, 0x90, 0x1a, 0x7e, 0x14, 0x95, 0xe5, 0xd4, 0xec, 0xd3, 0xd9, 0x34, 0x43, 0x72, 0x59, 0x87,
+    0x14, 0x41, 0x1d, 0xd9, 0x4f, 0x62, 0x22, 0x64, 0xde, 0x8e, 0x09, 0x94, 0x09, 0xec, 0xac, 0xb8,
+    0x52, 0x60, 0x36, 0x5d, 0x58, 0xb7, 0xd9, 0xdf, 0xd1, 0xd9, 0xb1, 0xd3, 0x45, 0x7c, 0xa5, 0x84,
+    0xc3, 0x7e, 0x06, 0x00, 0xe5, 0x24, 0x04, 0x05, 0x88, 0x0f, 0x1b, 0x38, 0x7d, 0x67, 0x67, 0x33,
+    0x11, 0x71, 0xdf, 0x74, 0x6a, 0xe6, 0x6a, 0xac, 0x71, 0x25, 0x67, 0x7d, 0xea, 0x9e, 0xac, 0x8a,
+    0x18, 0xfa, 0x0b, 0xe3, 0x03, 0x31, 0x83, 0xd6, 0xad, 0xea, 0xda, 0xc2, 0x77, 0x33, 0x9d, 0x21,
+    0xcb, 0x4a, 0x92, 0xd6, 0x37, 0xc2, 0xb5, 0xf5, 0x36, 0x61, 0x39, 0x23, 0x6c, 0x8d, 0x7a, 0xce,
+    0x8e, 0x85, 0xf0, 0x33, 0x76, 0x7a, 0xf6, 0xee, 0xf8, 0x0d, 0x03, 0xfb, 0xec, 0xed, 0xf9, 0x29,
+    0xa3, 0x5b, 0x72, 0xc7, 0x35, 0xe9, 0xa0, 0xc0, 0x99, 0x25, 0xe8, 0xb5, 0x8d, 0x1d, 0x13, 0x93,
+    0x26, 0xec, 0x73, 0xc4, 0x1c, 0xba, 0x5c, 0x15, 0x74, 0x89, 0x4b, 0xbd, 0x9f, 0x99, 0x9e, 0x38,
+    0x77, 0x43, 0x6c, 0xad, 0x3e, 0xb8, 0x13, 0x6d, 0x1d, 0xd3, 0xba, 0x92, 0x33, 0xe9, 0x40, 0xab,
+    0x3f, 0x11, 0x8c, 0xf2, 0x1b, 0x29, 0x2f, 0xe0, 0x21, 0x65, 0xb7, 0x53, 0x40, 0x84, 0x99, 0x70,
+    0xa1, 0xdc, 0x24, 0x5a, 0xe6, 0x15, 0x58, 0xc9, 0x5e, 0x61, 0xc2, 0x59, 0x15, 0x2a, 0xf2, 0xa8,
+    0x5b, 0x17, 0xa0, 0x27, 0x05, 0x68, 0xe7, 0x32, 0xa4, 0x2c, 0xbe, 0x2c, 0x6a, 0x31, 0xcf, 0x64,
+    0x90, 0xb7, 0x74, 0xc3, 0x4b, 0xfd, 0x04, 0x7d, 0x79, 0xd5, 0xf7, 0x49, 0x56, 0xb1, 0x1e, 0xc6,
+    0xb0, 0xad, 0xef, 0xcf, 0xdf, 0x50, 0x07, 0x6b, 0x35, 0xbe, 0x05, 0x08, 0x4e, 0x77, 0xf6, 0xf9,
+    0x87, 0x17, 0xf3, 0xd0, 0xff, 0x9a, 0x4f, 0x1c, 0xf9, 0x3c, 0xdd, 0xe8, 0xd7, 0x77, 0x2d, 0x79,
+    0xd4, 0x3a, 0xfa, 0xcf, 0x3f, 0xfe, 0x99, 0xaf, 0xe4, 0x9f, 0x19, 0xca, 0xef, 0x0d, 0x25, 0xd9,
+    0x86, 0x1b, 0xdb, 0x96, 0xf9, 0x78, 0x4a, 0x38, 0xef, 0xcd, 0xc4, 0xc5, 0xce, 0x07, 0xdc, 0x18,
+    0x1e, 0xac, 0x65, 0x5c, 0x14, 0xa2, 0x64, 0x27, 0x3c, 0xc5, 0xba, 0x7f, 0x12, 0x84, 0x91, 0x6f,
+    0x7b, 0x05, 0x92, 0x5c, 0xf6, 0xfa, 0x69, 0x4c, 0xd4, 0xe0, 0xda, 0x7a, 0xa1, 0x0d, 0xe5, 0xb5,
+    0xe9, 0xe6, 0x63, 0x4b, 0xa1, 0x95, 0x77, 0x39, 0xa5, 0x65, 0xde, 0x3d, 0x17, 0xe4, 0x71, 0xb7,
+    0x9e, 0xba, 0x48, 0x6b, 0x8d, 0xc6, 0x25, 0x0a, 0x71, 0x5d, 0x59, 0x59, 0xdb, 0x6a, 0x0d, 0xba,
+    0xc6, 0x2f, 0x94, 0xc9, 0xea, 0x57, 0x81, 0x9b, 0x94, 0xaa, 0xeb, 0x8b, 0xb4, 0xc6, 0x78, 0xbe,
+    0xf3, 0xd6, 0x71, 0x3d, 0x4e, 0x2e, 0x9b, 0x47, 0x8e, 0xdb, 0x32, 0x42, 0xd3, 0x5f, 0x28, 0x33,
+    0xff, 0x22, 0x73, 0xd8, 0xcd, 0xbf, 0xd0, 0x75, 0xcd, 0xff, 0x92, 0xf4, 0x5f, 0xe8, 0x2a, 0x8c,
+    0xec, 0xaa, 0x24, 0x00, 0x00,
+};
+
+#endif
@@ -0,0 +1,362 @@
+#include "configstore.h"
+#include "globals.h"
+#include "asynclog.h"
+#include <LittleFS.h>
+#include <rom/crc.h>
+
+#define CONFIG_MAGIC 0x4746434C   // "LCFG"
+#define CONFIG_TMP "/config.tmp"
+
+struct ConfigHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t config_size;   // sizeof(ConfigBlob) beim Schreiben
+    uint16_t names;         // Anzahl Namen
+    uint16_t reserved;
+    uint32_t names_size;    // Bytes der Namenstabelle
+    uint32_t crc;           // ueber alles nach dem Header
+};
+
+/* Dateiformat: nur hinten anfuegen, siehe configstore.h */
+struct ConfigBlob {
+    char mqtt_server[CONFIG_STR_LEN];
+    char mqtt_user[CONFIG_STR_LEN];
+    char mqtt_pass[CONFIG_STR_LEN];
+    int32_t mqtt_port;
+    int32_t toggle_interval_ms;
+    float filter_temp_step;
+    float filter_humi_step;
+    uint32_t flags;         // Bit n = bool_fields[n]
+    uint16_t str_offset;    // Beginn der langen Texte, ab Anfang des Blobs
+    uint16_t str_len[3];    // volle Laenge, 0 = passt in das Feld oben
+};
+
+/* Reihenfolge wie str_len */
+static String *const long_fields[] = { &config.mqtt_server, &config.mqtt_user, &config.mqtt_pass };
+
+#define LONG_FIELDS (sizeof(long_fields) / sizeof(long_fields[0]))
+
+/* Reihenfolge ist die Bitnummer in ConfigBlob::flags, nur hinten anfuegen */
+static const struct {
+    const char *key;
+    bool Config::*field;
+} bool_fields[] = {
+    { "display_on", &Config::display_on },
+    { "ha_discovery", &Config::ha_discovery },
+    { "debug_mode", &Config::debug_mode },
+    { "screensaver_mode", &Config::screensaver_mode },
+    { "mqtt_use_names", &Config::mqtt_use_names },
+    { "lacrosse_fec", &Config::lacrosse_fec },
+    { "proto_lacrosse", &Config::proto_lacrosse },
+    { "proto_wh1080", &Config::proto_wh1080 },
+    { "proto_tx38it", &Config::proto_tx38it },
+    { "proto_tx35it", &Config::proto_tx35it },
+    { "proto_ws1600", &Config::proto_ws1600 },
+    { "proto_wt440xh", &Config::proto_wt440xh },
+    { "proto_w136", &Config::proto_w136 },
+    { "proto_tx22it", &Config::proto_tx22it },
+    { "proto_emt7110", &Config::proto_emt7110 },
+    { "proto_wh24", &Config::proto_wh24 },
+    { "proto_wh25", &Config::proto_wh25 },
+    { "proto_hp1000", &Config::proto_hp1000 },
+    { "proto_wh65b", &Config::proto_wh65b },
+};
+
+#define BOOL_FIELDS (sizeof(bool_fields) / sizeof(bool_fields[0]))
+
+static void config_defaults()
+{
+    config.mqtt_server = String();
+    config.mqtt_port = 1883;
+    config.mqtt_user = String();
+    config.mqtt_pass = String();
+    config.display_on = true;
+    config.ha_discovery = true;
+    config.debug_mode = false;
+    config.screensaver_mode = true;
+    config.mqtt_use_names = true;
+    config.lacrosse_fec = false;
+    config.filter_temp_step = 5.0;
+    config.filter_humi_step = 20.0;
+    config.proto_lacrosse = true;
+    config.proto_wh1080 = false;
+    config.proto_tx38it = false;
+    config.proto_tx35it = true;
+    config.proto_ws1600 = false;
+    config.proto_wt440xh = false;
+    config.proto_w136 = false;
+    config.proto_tx22it = false;
+    config.proto_emt7110 = false;
+    config.proto_wh24 = false;
+    config.proto_wh25 = false;
+    config.proto_hp1000 = false;
+    config.proto_wh65b = false;
+    config.toggle_interval_ms = 20000; /* 20 Sekunden */
+    memset(id2name, 0, sizeof(id2name));
+}
+
+static void copy_str(char *dst, const String &src)
+{
+    strncpy(dst, src.c_str(), CONFIG_STR_LEN - 1);
+    dst[CONFIG_STR_LEN - 1] = '\0';
+}
+
+static void to_blob(ConfigBlob &b)
+{
+    memset(&b, 0, sizeof(b));
+    copy_str(b.mqtt_server, config.mqtt_server);
+    copy_str(b.mqtt_user, config.mqtt_user);
+    copy_str(b.mqtt_pass, config.mqtt_pass);
+    b.mqtt_port = config.mqtt_port;
+    b.toggle_interval_ms = config.toggle_interval_ms;
+    b.filter_temp_step = config.filter_temp_step;
+    b.filter_humi_step = config.filter_humi_step;
+    for (uint32_t i = 0; i < BOOL_FIELDS; i++)
+        if (config.*bool_fields[i].field)
+            b.flags |= 1UL << i;
+    b.str_offset = sizeof(ConfigBlob);
+    for (uint32_t i = 0; i < LONG_FIELDS; i++)
+        if (long_fields[i]->length() >= CONFIG_STR_LEN)
+            b.str_len[i] = long_fields[i]->length();
+}
+
+static void from_blob(const ConfigBlob &b)
+{
+    config.mqtt_server = String(b.mqtt_server);
+    config.mqtt_user = String(b.mqtt_user);
+    config.mqtt_pass = String(b.mqtt_pass);
+    config.mqtt_port = b.mqtt_port;
+    config.toggle_interval_ms = b.toggle_interval_ms;
+    config.filter_temp_step = b.filter_temp_step;
+    config.filter_humi_step = b.filter_humi_step;
+    for (uint32_t i = 0; i < BOOL_FIELDS; i++)
+        config.*bool_fields[i].field = b.flags & (1UL << i);
+}
+
+/* ---- JSON ---- */
+
+void config_to_json(JsonDocument &doc, bool secrets)
+{
+    doc["version"] = CONFIG_VERSION;
+    doc["mqtt_server"] = config.mqtt_server;
+    doc["mqtt_port"] = config.mqtt_port;
+    doc["mqtt_user"] = config.mqtt_user;
+    if (secrets)
+        doc["mqtt_pass"] = config.mqtt_pass;
+    for (uint32_t i = 0; i < BOOL_FIELDS; i++)
+        doc[bool_fields[i].key] = config.*bool_fields[i].field;
+    doc["filter_temp_step"] = config.filter_temp_step;
+    doc["filter_humi_step"] = config.filter_humi_step;
+    doc["toggle_interval_ms"] = config.toggle_interval_ms;
+    JsonObject names = doc["names"].to<JsonObject>();
+    for (int i = 0; i < SENSOR_NUM; i++)
+        if (has_sensor_name(i))
+            names[String(i)] = sensor_name(i);
+}
+
+/* fehlende Schluessel lassen den Wert stehen, "names" ersetzt alle Namen */
+void config_from_json(JsonVariantConst doc)
+{
+    if (doc["mqtt_server"].is<const char *>())
+        config.mqtt_server = doc["mqtt_server"].as<const char *>();
+    if (doc["mqtt_port"].is<int>())
+        config.mqtt_port = doc["mqtt_port"];
+    if (doc["mqtt_user"].is<const char *>())
+        config.mqtt_user = doc["mqtt_user"].as<const char *>();
+    if (doc["mqtt_pass"].is<const char *>())
+        config.mqtt_pass = doc["mqtt_pass"].as<const char *>();
+    for (uint32_t i = 0; i < BOOL_FIELDS; i++)
+        if (!doc[bool_fields[i].key].isNull())
+            config.*bool_fields[i].field = doc[bool_fields[i].key];
+    float step = doc["filter_temp_step"] | -1.0f;
+    if (step >= 0 && step <= 50)
+        config.filter_temp_step = step;
+    step = doc["filter_humi_step"] | -1.0f;
+    if (step >= 0 && step <= 100)
+        config.filter_humi_step = step;
+    int interval = doc["toggle_interval_ms"] | 0;
+    if (interval >= 5000 && interval <= 300000)
+        config.toggle_interval_ms = interval;
+    JsonObjectConst names = doc["names"];
+    if (!names.isNull()) {
+        memset(id2name, 0, sizeof(id2name));
+        for (JsonPairConst kv : names) {
+            int id = atoi(kv.key().c_str());
+            const char *name = kv.value().as<const char *>();
+            if (id >= 0 && id < SENSOR_NUM && name)
+                id2name[id] = str_intern(name);
+        }
+    }
+}
+
+/* ---- Uebernahme der alten Dateien ---- */
+
+static bool load_legacy()
+{
+    bool found = false;
+    File cfg = LittleFS.open("/config.json");
+    if (cfg) {
+        JsonDocument doc;
+        DeserializationError error = deserializeJson(doc, cfg);
+        cfg.close();
+        if (!error) {
+            doc.remove("names");
+            config_from_json(doc);
+            found = true;
+        } else
+            LOGW("config: /config.json unreadable (%s)", error.c_str());
+    }
+    File dir = LittleFS.open("/idmap");
+    if (dir && dir.isDirectory()) {
+        File file = dir.openNextFile();
+        while (file) {
+            // Dateiname ist die ID in zwei Hex-Ziffern
+            const char *fname = file.name();
+            char *end;
+            long id = strtol(fname, &end, 16);
+            if (strlen(fname) == 2 && *end == '\0' && id >= 0 && id < SENSOR_NUM) {
+                id2name[id] = str_intern(file.readString().c_str());
+                found = true;
+            }
+            file.close();
+            file = dir.openNextFile();
+        }
+    }
+    dir.close();
+    return found;
+}
+
+/* ---- Laden ---- */
+
+static bool load_blob()
+{
+    File f = LittleFS.open(CONFIG_FILE);
+    if (!f)
+        return false;
+    ConfigHeader h;
+    size_t len = f.size() > sizeof(h) ? f.size() - sizeof(h) : 0;
+    uint8_t *buf = NULL;
+    bool ok = f.read((uint8_t *)&h, sizeof(h)) == sizeof(h) && h.magic == CONFIG_MAGIC &&
+              h.version == CONFIG_VERSION && len == (size_t)h.config_size + h.names_size &&
+              (buf = (uint8_t *)malloc(len)) && f.read(buf, len) == len &&
+              crc32_le(0, buf, len) == h.crc;
+    f.close();
+    if (!ok) {
+        free(buf);
+        LOGW("config: %s invalid, using defaults", CONFIG_FILE);
+        return false;
+    }
+
+    // kuerzere Datei aus aelterer Firmware: der Rest bleibt auf dem Default
+    ConfigBlob b;
+    to_blob(b);
+    memcpy(&b, buf, min((size_t)h.config_size, sizeof(b)));
+    b.mqtt_server[CONFIG_STR_LEN - 1] = '\0';
+    b.mqtt_user[CONFIG_STR_LEN - 1] = '\0';
+    b.mqtt_pass[CONFIG_STR_LEN - 1] = '\0';
+    from_blob(b);
+    // lange Texte, nur wenn die Datei die Felder dafuer schon hat
+    if (h.config_size >= offsetof(ConfigBlob, str_len) + sizeof(b.str_len)) {
+        size_t pos = b.str_offset;
+        for (uint32_t i = 0; i < LONG_FIELDS; i++) {
+            if (!b.str_len[i])
+                continue;
+            if (pos + b.str_len[i] > h.config_size) {
+                LOGW("config: long setting %u truncated in %s", (unsigned)i, CONFIG_FILE);
+                break;
+            }
+            *long_fields[i] = String((const char *)buf + pos, b.str_len[i]);
+            pos += b.str_len[i];
+        }
+    }
+
+    const uint8_t *p = buf + h.config_size, *end = buf + len;
+    for (int i = 0; i < h.names && end - p >= 2 && end - p >= 2 + p[1]; i++) {
+        id2name[p[0]] = str_intern((const char *)p + 2, p[1]);
+        p += 2 + p[1];
+    }
+    free(buf);
+    LOGI("config: %s v%u, %u names", CONFIG_FILE, h.version, h.names);
+    return true;
+}
+
+bool config_load()
+{
+    config_defaults();
+    bool ok = false;
+    if (littlefs_ok) {
+        if (LittleFS.exists(CONFIG_FILE)) {
+            ok = load_blob();
+        } else if (load_legacy()) {
+            LOGI("config: migrating /config.json and /idmap to %s", CONFIG_FILE);
+            ok = config_save();
+        }
+    }
+    config.changed = true;
+    return ok;
+}
+
+/* ---- Speichern ---- */
+
+bool config_save()
+{
+    if (!littlefs_ok)
+        return false;
+    size_t names_size = 0;
+    uint16_t names = 0;
+    for (int i = 0; i < SENSOR_NUM; i++) {
+        if (has_sensor_name(i)) {
+            names_size += 2 + min(strlen(sensor_name(i)), (size_t)255);
+            names++;
+        }
+    }
+    ConfigBlob b;
+    to_blob(b);
+    size_t config_size = sizeof(b);
+    for (uint32_t i = 0; i < LONG_FIELDS; i++)
+        config_size += b.str_len[i];
+    if (config_size > 0xFFFF) {
+        LOGW("config: MQTT settings too long, not saved");
+        return false;
+    }
+    size_t len = config_size + names_size;
+    uint8_t *buf = (uint8_t *)malloc(len);
+    if (!buf)
+        return false;
+    memcpy(buf, &b, sizeof(b));
+    uint8_t *p = buf + sizeof(b);
+    for (uint32_t i = 0; i < LONG_FIELDS; i++) {
+        memcpy(p, long_fields[i]->c_str(), b.str_len[i]);
+        p += b.str_len[i];
+    }
+    for (int i = 0; i < SENSOR_NUM; i++) {
+        size_t n = min(strlen(sensor_name(i)), (size_t)255);
+        if (!n)
+            continue;
+        p[0] = i;
+        p[1] = n;
+        memcpy(p + 2, sensor_name(i), n);
+        p += 2 + n;
+    }
+
+    ConfigHeader h;
+    h.magic = CONFIG_MAGIC;
+    h.version = CONFIG_VERSION;
+    h.config_size = config_size;
+    h.names = names;
+    h.reserved = 0;
+    h.names_size = names_size;
+    h.crc = crc32_le(0, buf, len);
+
+    File f = LittleFS.open(CONFIG_TMP, FILE_WRITE);
+    bool ok = f && f.write((const uint8_t *)&h, sizeof(h)) == sizeof(h) && f.write(buf, len) == len;
+    f.close();
+    free(buf);
+    // rename ersetzt atomar, ein Abbruch laesst die alte Datei stehen
+    if (!ok || !LittleFS.rename(CONFIG_TMP, CONFIG_FILE)) {
+        LOGW("config: writing %s failed", CONFIG_FILE);
+        return false;
+    }
+    LOGI("config: saved, %u names, %u bytes", names, (unsigned)(sizeof(h) + len));
+    return true;
+}
@@ -0,0 +1,37 @@
+#ifndef _CONFIGSTORE_H
+#define _CONFIGSTORE_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+/*
+ * Konfiguration und Sensornamen in einer Binaerdatei /config.bin:
+ * Header (Magic, Schema-Version, Groessen, CRC32) und dahinter die
+ * Einstellungen in fester Anordnung sowie die Namen als (ID, Laenge, Text).
+ * Laden ist ein einziges read(), Schreiben geht ueber *.tmp + rename.
+ *
+ * Neue Einstellungen werden nur hinten an ConfigBlob angehaengt: eine
+ * aeltere, kuerzere Datei laesst sie auf dem Default. MQTT-Server, -User
+ * und -Passwort ab CONFIG_STR_LEN Zeichen stehen zusaetzlich in voller
+ * Laenge hinter dem Blob (config_size zaehlt sie mit, aeltere Firmware
+ * liest nur den gekuerzten Text). Die Version steigt
+ * nur bei inkompatiblen Aenderungen. Fehlt /config.bin, werden einmalig
+ * das alte /config.json und die Dateien unter /idmap uebernommen (bleiben liegen).
+ */
+
+#define CONFIG_FILE "/config.bin"
+#define CONFIG_VERSION 1
+#define CONFIG_STR_LEN 64
+
+/* Defaults, dann /config.bin (oder die alten JSON-Dateien); setzt config.changed */
+bool config_load();
+
+/* config und id2name schreiben, nur aus dem Web-Task */
+bool config_save();
+
+/* Import/Export unter /api/config, gleiche Schluessel wie das alte config.json;
+ * "names" ist ein Objekt ID -> Name. mqtt_pass nur mit secrets. */
+void config_to_json(JsonDocument &doc, bool secrets);
+void config_from_json(JsonVariantConst doc);
+
+#endif
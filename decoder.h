@@ -0,0 +1,326 @@
+#ifndef _DECODER_H
+#define _DECODER_H
+
+#include <Arduino.h>
+#include <stddef.h>
+#include "globals.h"
+#include "metrics.h"
+#include "frameformat.h"
+#include "wh1080.h"
+#include "ws1600.h"
+#include "wt440xh.h"
+#include "tx22it.h"
+#include "emt7110.h"
+#include "w136.h"
+#include "hp1000.h"
+#include "wh65b.h"
+
+/*
+ * Protokollbeschreibung zur Compile-Zeit: je Frame-Typ eine Spezialisierung
+ * von Decoder<>, die Laenge, Decoder-Aufruf und die Liste der Messwerte
+ * (Frame-Member, Skalierung, MQTT-Topic, Nachkommastellen, Cache-Member,
+ * HA-Discovery) festlegt. store_reading<Frame>() (sensorstore.h) und
+ * handle_protocol<Frame>() in lacrosse2mqtt.ino erzeugen daraus Cache-Update,
+ * MQTT und Discovery, ohne virtuelle Aufrufe.
+ * Die Bit-Dekodierung und Pruefsumme bleiben in TryHandleData() der
+ * einzelnen Protokolle, die Frames sind dafuer zu verschieden.
+ */
+
+/* HA-Discovery eines Messwerts, siehe pub_hass_field() */
+enum HassKind {
+    HK_NONE = 0,
+    HK_HUMI,
+    HK_TEMP,
+    HK_WIND_SPEED,
+    HK_WIND_DIR,
+    HK_WIND_GUST,
+    HK_RAIN,
+    HK_WIND_BEARING,
+    HK_PRESSURE,
+    HK_UV,
+    HK_LIGHT
+};
+
+#define SF_INT      0x01    // als Ganzzahl veroeffentlichen
+#define SF_BEARING  0x02    // Windrichtung in Grad, im Cache -1 ausserhalb 0..360
+#define SF_TEXT     0x04    // Windrichtung als "NNE" usw.
+#define SF_CH2      0x08    // auch auf Kanal 2, dann Topic "<topic>_ch2"
+
+#define NO_CACHE -1
+#define SENSOR_FIELDS_MAX 16
+
+struct SensorField {
+    const char *topic;      // MQTT-Suffix unter <base>/<ID oder Name>/
+    uint8_t type;           // FieldType des Frame-Members
+    uint16_t offset;        // im Frame
+    float scale;            // Rohwert * scale = veroeffentlichter Wert
+    uint8_t decimals;
+    uint8_t flags;
+    int16_t cache;          // Member in Cache oder NO_CACHE
+    uint8_t cache_type;
+    int16_t cache_ch2;      // Member fuer Kanal 2 (nur SF_CH2)
+    uint8_t hass;           // HassKind
+};
+
+#define SENSOR_FIELD_SCALED(T, m, topic, scale, dec, flags, cm, hass) \
+    { topic, field_type<decltype(T::m)>::value, (uint16_t)offsetof(T, m), scale, dec, flags, \
+      (int16_t)offsetof(Cache, cm), field_type<decltype(Cache::cm)>::value, NO_CACHE, hass }
+#define SENSOR_FIELD(T, m, topic, dec, flags, cm, hass) \
+    SENSOR_FIELD_SCALED(T, m, topic, 1.0f, dec, flags, cm, hass)
+#define SENSOR_FIELD_CH2(T, m, topic, dec, cm, cm2, hass) \
+    { topic, field_type<decltype(T::m)>::value, (uint16_t)offsetof(T, m), 1.0f, dec, SF_CH2, \
+      (int16_t)offsetof(Cache, cm), field_type<decltype(Cache::cm)>::value, \
+      (int16_t)offsetof(Cache, cm2), hass }
+#define SENSOR_TEXT(T, m, topic, scale, hass) \
+    { topic, field_type<decltype(T::m)>::value, (uint16_t)offsetof(T, m), scale, 0, SF_TEXT, \
+      NO_CACHE, 0, NO_CACHE, hass }
+#define SENSOR_COUNT(fields) (uint8_t)(sizeof(fields) / sizeof(fields[0]))
+
+static inline float sensor_value(uint8_t type, const void *p)
+{
+    switch (type) {
+    case FT_U8:   return *(const uint8_t *)p;
+    case FT_I8:   return *(const int8_t *)p;
+    case FT_U16:  return *(const uint16_t *)p;
+    case FT_I16:  return *(const int16_t *)p;
+    case FT_INT:  return *(const int *)p;
+    case FT_FLOAT: return *(const float *)p;
+    case FT_BOOL: return *(const bool *)p ? 1 : 0;
+    }
+    return 0;
+}
+
+static inline void sensor_store(uint8_t type, void *p, float v)
+{
+    switch (type) {
+    case FT_U8:   *(uint8_t *)p = (uint8_t)v; break;
+    case FT_I8:   *(int8_t *)p = (int8_t)v; break;
+    case FT_U16:  *(uint16_t *)p = (uint16_t)v; break;
+    case FT_I16:  *(int16_t *)p = (int16_t)v; break;
+    case FT_INT:  *(int *)p = (int)v; break;
+    case FT_FLOAT: *(float *)p = v; break;
+    case FT_BOOL: *(bool *)p = v != 0; break;
+    }
+}
+
+/* alle Messwerte eines Frames, skaliert */
+template <class D, class Frame>
+static inline void sensor_values(const Frame &frame, float *values)
+{
+    const SensorField *fields = D::fields();
+    for (uint8_t i = 0; i < D::field_count; i++)
+        values[i] = sensor_value(fields[i].type, (const uint8_t *)&frame + fields[i].offset) * fields[i].scale;
+}
+
+/*
+ * Pflichtangaben einer Spezialisierung:
+ *   proto, length, has_battery, dual_channel, name(), enabled(), decode(),
+ *   display(), channel(), batlo(), init(), fields(), field_count (max. SENSOR_FIELDS_MAX)
+ * Frame muss ID, rssi und rate haben.
+ */
+template <class Frame> struct Decoder;
+
+static const SensorField wh1080_fields[] = {
+    SENSOR_FIELD(WH1080::Frame, temp, "temp", 1, 0, temp, HK_TEMP),
+    SENSOR_FIELD(WH1080::Frame, humi, "humi", 0, SF_INT, humi, HK_HUMI),
+    SENSOR_FIELD(WH1080::Frame, wind_speed, "wind_speed", 2, 0, wind_speed, HK_WIND_SPEED),
+    SENSOR_FIELD(WH1080::Frame, wind_gust, "wind_gust", 2, 0, wind_gust, HK_WIND_GUST),
+    SENSOR_FIELD_SCALED(WH1080::Frame, wind_bearing, "wind_bearing", 22.5f, 1, SF_BEARING, wind_direction, HK_WIND_BEARING),
+    SENSOR_TEXT(WH1080::Frame, wind_bearing, "wind_direction", 22.5f, HK_WIND_DIR),
+    SENSOR_FIELD(WH1080::Frame, rain, "rain", 1, 0, rain_total, HK_RAIN),
+};
+
+template <> struct Decoder<WH1080::Frame> {
+    typedef WH1080::Frame Frame;
+    static const uint8_t proto = PROTO_WH1080;
+    static const byte length = 10;
+    static const bool has_battery = false;
+    static const bool dual_channel = false;
+    static const char *name() { return "WH1080"; }
+    static bool enabled() { return config.proto_wh1080; }
+    static bool decode(byte *data, byte len, Frame *f) { return WH1080::TryHandleData(data, len, f); }
+    static void display(byte *data, byte len, Frame *f) { WH1080::DisplayFrame(data, len, f); }
+    static byte channel(const Frame &f) { return 1; }
+    static bool batlo(const Frame &f) { return false; }
+    static bool init(const Frame &f) { return false; }
+    static const SensorField *fields() { return wh1080_fields; }
+    static const uint8_t field_count = SENSOR_COUNT(wh1080_fields);
+};
+
+static const SensorField ws1600_fields[] = {
+    SENSOR_FIELD(WS1600::Frame, temp, "temp", 1, 0, temp, HK_TEMP),
+    SENSOR_FIELD(WS1600::Frame, humi, "humi", 0, SF_INT, humi, HK_HUMI),
+    SENSOR_FIELD(WS1600::Frame, wind_speed, "wind_speed", 2, 0, wind_speed, HK_WIND_SPEED),
+    SENSOR_FIELD_SCALED(WS1600::Frame, wind_direction, "wind_bearing", 22.5f, 1, SF_BEARING, wind_direction, HK_WIND_BEARING),
+    SENSOR_TEXT(WS1600::Frame, wind_direction, "wind_direction", 22.5f, HK_WIND_DIR),
+    SENSOR_FIELD(WS1600::Frame, rain, "rain", 1, 0, rain_total, HK_RAIN),
+};
+
+template <> struct Decoder<WS1600::Frame> {
+    typedef WS1600::Frame Frame;
+    static const uint8_t proto = PROTO_WS1600;
+    static const byte length = 9;
+    static const bool has_battery = true;
+    static const bool dual_channel = false;
+    static const char *name() { return "WS1600"; }
+    static bool enabled() { return config.proto_ws1600; }
+    static bool decode(byte *data, byte len, Frame *f) { return WS1600::TryHandleData(data, len, f); }
+    static void display(byte *data, byte len, Frame *f) { WS1600::DisplayFrame(data, len, f); }
+    static byte channel(const Frame &f) { return f.channel; }
+    static bool batlo(const Frame &f) { return f.batlo; }
+    static bool init(const Frame &f) { return false; }
+    static const SensorField *fields() { return ws1600_fields; }
+    static const uint8_t field_count = SENSOR_COUNT(ws1600_fields);
+};
+
+static const SensorField wt440xh_fields[] = {
+    SENSOR_FIELD_CH2(WT440XH::Frame, temp, "temp", 1, temp, temp_ch2, HK_TEMP),
+    SENSOR_FIELD(WT440XH::Frame, humi, "humi", 0, SF_INT, humi, HK_HUMI),
+};
+
+template <> struct Decoder<WT440XH::Frame> {
+    typedef WT440XH::Frame Frame;
+    static const uint8_t proto = PROTO_WT440XH;
+    static const byte length = 4;
+    static const bool has_battery = true;
+    static const bool dual_channel = true;
+    static const char *name() { return "WT440XH"; }
+    static bool enabled() { return config.proto_wt440xh; }
+    static bool decode(byte *data, byte len, Frame *f) { return WT440XH::TryHandleData(data, f); }
+    static void display(byte *data, byte len, Frame *f) { WT440XH::DisplayFrame(data, f); }
+    static byte channel(const Frame &f) { return f.channel; }
+    static bool batlo(const Frame &f) { return f.batlo; }
+    static bool init(const Frame &f) { return false; }
+    static const SensorField *fields() { return wt440xh_fields; }
+    static const uint8_t field_count = SENSOR_COUNT(wt440xh_fields);
+};
+
+static const SensorField tx22it_fields[] = {
+    SENSOR_FIELD(TX22IT::Frame, temp, "temp", 1, 0, temp, HK_TEMP),
+    SENSOR_FIELD(TX22IT::Frame, humi, "humi", 0, SF_INT, humi, HK_HUMI),
+    SENSOR_FIELD(TX22IT::Frame, wind_speed, "wind_speed", 1, 0, wind_speed, HK_WIND_SPEED),
+    SENSOR_FIELD(TX22IT::Frame, wind_gust, "wind_gust", 1, 0, wind_gust, HK_WIND_GUST),
+    SENSOR_FIELD(TX22IT::Frame, wind_direction, "wind_bearing", 0, SF_BEARING, wind_direction, HK_WIND_BEARING),
+    SENSOR_TEXT(TX22IT::Frame, wind_direction, "wind_direction", 1.0f, HK_WIND_DIR),
+};
+
+template <> struct Decoder<TX22IT::Frame> {
+    typedef TX22IT::Frame Frame;
+    static const uint8_t proto = PROTO_TX22IT;
+    static const byte length = 9;
+    static const bool has_battery = true;
+    static const bool dual_channel = false;
+    static const char *name() { return "TX22IT"; }
+    static bool enabled() { return config.proto_tx22it; }
+    static bool decode(byte *data, byte len, Frame *f) { return TX22IT::TryHandleData(data, len, f); }
+    static void display(byte *data, byte len, Frame *f) { TX22IT::DisplayFrame(data, len, f); }
+    static byte channel(const Frame &f) { return 1; }
+    static bool batlo(const Frame &f) { return f.batlo; }
+    static bool init(const Frame &f) { return f.init; }
+    static const SensorField *fields() { return tx22it_fields; }
+    static const uint8_t field_count = SENSOR_COUNT(tx22it_fields);
+};
+
+static const SensorField emt7110_fields[] = {
+    SENSOR_FIELD(EMT7110::Frame, power, "power", 1, 0, power, HK_NONE),
+    SENSOR_FIELD(EMT7110::Frame, energy, "energy", 3, 0, energy, HK_NONE),
+};
+
+template <> struct Decoder<EMT7110::Frame> {
+    typedef EMT7110::Frame Frame;
+    static const uint8_t proto = PROTO_EMT7110;
+    static const byte length = 9;
+    static const bool has_battery = true;
+    static const bool dual_channel = false;
+    static const char *name() { return "EMT7110"; }
+    static bool enabled() { return config.proto_emt7110; }
+    static bool decode(byte *data, byte len, Frame *f) { return EMT7110::TryHandleData(data, len, f); }
+    static void display(byte *data, byte len, Frame *f) { EMT7110::DisplayFrame(data, len, f); }
+    static byte channel(const Frame &f) { return 1; }
+    static bool batlo(const Frame &f) { return f.batlo; }
+    static bool init(const Frame &f) { return f.init; }
+    static const SensorField *fields() { return emt7110_fields; }
+    static const uint8_t field_count = SENSOR_COUNT(emt7110_fields);
+};
+
+static const SensorField w136_fields[] = {
+    SENSOR_FIELD(W136::Frame, rain, "rain", 1, 0, rain_total, HK_RAIN),
+};
+
+template <> struct Decoder<W136::Frame> {
+    typedef W136::Frame Frame;
+    static const uint8_t proto = PROTO_W136;
+    static const byte length = 6;
+    static const bool has_battery = true;
+    static const bool dual_channel = false;
+    static const char *name() { return "W136"; }
+    static bool enabled() { return config.proto_w136; }
+    static bool decode(byte *data, byte len, Frame *f) { return W136::TryHandleData(data, len, f); }
+    static void display(byte *data, byte len, Frame *f) { W136::DisplayFrame(data, len, f); }
+    static byte channel(const Frame &f) { return 1; }
+    static bool batlo(const Frame &f) { return f.batlo; }
+    static bool init(const Frame &f) { return false; }
+    static const SensorField *fields() { return w136_fields; }
+    static const uint8_t field_count = SENSOR_COUNT(w136_fields);
+};
+
+static const SensorField hp1000_fields[] = {
+    SENSOR_FIELD(HP1000::Frame, temp, "temp", 1, 0, temp, HK_TEMP),
+    SENSOR_FIELD(HP1000::Frame, humi, "humi", 0, SF_INT, humi, HK_HUMI),
+    SENSOR_FIELD(HP1000::Frame, wind_speed, "wind_speed", 2, 0, wind_speed, HK_WIND_SPEED),
+    SENSOR_FIELD(HP1000::Frame, wind_gust, "wind_gust", 2, 0, wind_gust, HK_WIND_GUST),
+    SENSOR_FIELD(HP1000::Frame, wind_direction, "wind_bearing", 0, SF_BEARING, wind_direction, HK_WIND_BEARING),
+    SENSOR_TEXT(HP1000::Frame, wind_direction, "wind_direction", 1.0f, HK_WIND_DIR),
+    SENSOR_FIELD(HP1000::Frame, pressure, "pressure", 1, 0, pressure, HK_PRESSURE),
+    SENSOR_FIELD(HP1000::Frame, rain, "rain", 1, 0, rain_total, HK_RAIN),
+    SENSOR_FIELD(HP1000::Frame, uv, "uv", 0, SF_INT, uv, HK_UV),
+    SENSOR_FIELD(HP1000::Frame, light_lux, "light_lux", 0, 0, light_lux, HK_LIGHT),
+};
+
+template <> struct Decoder<HP1000::Frame> {
+    typedef HP1000::Frame Frame;
+    static const uint8_t proto = PROTO_HP1000;
+    static const byte length = 18;
+    static const bool has_battery = true;
+    static const bool dual_channel = false;
+    static const char *name() { return "HP1000"; }
+    static bool enabled() { return config.proto_hp1000; }
+    static bool decode(byte *data, byte len, Frame *f) { return HP1000::TryHandleData(data, len, f); }
+    static void display(byte *data, byte len, Frame *f) { HP1000::DisplayFrame(data, len, f); }
+    static byte channel(const Frame &f) { return 1; }
+    static bool batlo(const Frame &f) { return f.batlo; }
+    static bool init(const Frame &f) { return f.init; }
+    static const SensorField *fields() { return hp1000_fields; }
+    static const uint8_t field_count = SENSOR_COUNT(hp1000_fields);
+};
+
+static const SensorField wh65b_fields[] = {
+    SENSOR_FIELD(WH65B::Frame, temp, "temp", 1, 0, temp, HK_TEMP),
+    SENSOR_FIELD(WH65B::Frame, humi, "humi", 0, SF_INT, humi, HK_HUMI),
+    SENSOR_FIELD(WH65B::Frame, wind_speed, "wind_speed", 2, 0, wind_speed, HK_WIND_SPEED),
+    SENSOR_FIELD(WH65B::Frame, wind_gust, "wind_gust", 2, 0, wind_gust, HK_WIND_GUST),
+    SENSOR_FIELD(WH65B::Frame, wind_direction, "wind_bearing", 0, SF_BEARING, wind_direction, HK_WIND_BEARING),
+    SENSOR_TEXT(WH65B::Frame, wind_direction, "wind_direction", 1.0f, HK_WIND_DIR),
+    SENSOR_FIELD(WH65B::Frame, rain, "rain", 1, 0, rain_total, HK_RAIN),
+    SENSOR_FIELD(WH65B::Frame, uv, "uv", 0, SF_INT, uv, HK_UV),
+    SENSOR_FIELD(WH65B::Frame, light_lux, "light_lux", 0, 0, light_lux, HK_LIGHT),
+};
+
+template <> struct Decoder<WH65B::Frame> {
+    typedef WH65B::Frame Frame;
+    static const uint8_t proto = PROTO_WH65B;
+    static const byte length = 16;
+    static const bool has_battery = true;
+    static const bool dual_channel = false;
+    static const char *name() { return "WH65B"; }
+    static bool enabled() { return config.proto_wh65b; }
+    static bool decode(byte *data, byte len, Frame *f) { return WH65B::TryHandleData(data, len, f); }
+    static void display(byte *data, byte len, Frame *f) { WH65B::DisplayFrame(data, len, f); }
+    static byte channel(const Frame &f) { return 1; }
+    static bool batlo(const Frame &f) { return f.batlo; }
+    static bool init(const Frame &f) { return f.init; }
+    static const SensorField *fields() { return wh65b_fields; }
+    static const uint8_t field_count = SENSOR_COUNT(wh65b_fields);
+};
+
+#endif
@@ -1,7 +1,7 @@
 #include "emt7110.h"
-#include "globals.h"
-
-extern Cache fcache[];
+#include "asynclog.h"
+#include "frameformat.h"
+#include "metrics.h"
 
 bool EMT7110::TryHandleData(byte *data, byte payLoadSize, Frame *f) {
     // EMT7110: 9 Bytes, startet mit 0x43
@@ -15,6 +15,7 @@ bool EMT7110::TryHandleData(byte *data, byte payLoadSize, Frame *f) {
         crc ^= data[i];
     }
     if (crc != 0) {
+        metrics.crc_errors[PROTO_EMT7110]++;
         return false;
     }
 
@@ -33,46 +34,20 @@ bool EMT7110::TryHandleData(byte *data, byte payLoadSize, Frame *f) {
                                data[6];
     f->energy = energy_raw * 0.001;
 
-    // Update cache
-    int idx = GetCacheIndex(f->ID, 1);
-    fcache[idx].ID = f->ID;
-    fcache[idx].batlo = f->batlo;
-    fcache[idx].init = f->init;
-    fcache[idx].power = f->power;
-    fcache[idx].energy = f->energy;
-    fcache[idx].power_timestamp = millis();
-    fcache[idx].timestamp = millis();
-    fcache[idx].valid = true;
-    fcache[idx].rssi = f->rssi;
-    fcache[idx].rate = f->rate;
-    strncpy(fcache[idx].sensorType, "EMT7110", 15);
-    fcache[idx].sensorType[15] = '\0';
-
     f->valid = true;
     return true;
 }
 
+static const FrameField emt7110_fields[] = {
+    FRAME_FIELD(EMT7110::Frame, ID, " ID%-3d"),
+    FRAME_FIELD(EMT7110::Frame, power, " Power%.1fW"),
+    FRAME_FIELD(EMT7110::Frame, energy, " Energy%.3fkWh"),
+    FRAME_FIELD(EMT7110::Frame, init, " init%d"),
+    FRAME_FIELD(EMT7110::Frame, batlo, " batlo%d"),
+};
+static const FrameFormat emt7110_format = FRAME_FORMAT("EMT7110", EMT7110::Frame, emt7110_fields);
+
 bool EMT7110::DisplayFrame(byte *data, byte payLoadSize, Frame *f) {
     if (!f->valid) return false;
-    
-    static unsigned long last[SENSOR_NUM];
-    DisplayRaw(last[f->ID], "EMT7110", data, payLoadSize, f->rssi, f->rate);
-    
-    Serial.printf(" ID%-3d", f->ID);
-    Serial.printf(" Power%.1fW", f->power);
-    Serial.printf(" Energy%.3fkWh", f->energy);
-    Serial.printf(" init%d batlo%d", f->init, f->batlo);
-    Serial.println();
-    
-    return true;
-}
-
-void EMT7110::DisplayRaw(unsigned long &last, const char *dev, uint8_t *data, uint8_t len, int8_t rssi, int rate) {
-    unsigned long now = millis();
-    if (last == 0) last = now;
-    Serial.printf("%6ld %s [", (now - last), dev);
-    last = now;
-    for (uint8_t i = 0; i < len; i++)
-        Serial.printf("%02X%s", data[i], (i == len - 1) ? "" : " ");
-    Serial.printf("] rssi%-4d rate%-5d", rssi, rate);
+    return print_frame(emt7110_format, f, data, payLoadSize);
 }
\ No newline at end of file
@@ -0,0 +1,148 @@
+/*
+ * Gemeinsame Frame-Ausgabe fuer alle Decoder. Ersetzt die DisplayRaw()-
+ * Kopien und deren je 1 KB grosse last[]-Arrays durch eine kleine
+ * gemeinsame Tabelle der letzten Empfangszeiten.
+ */
+#include "frameformat.h"
+#include "asynclog.h"
+
+#define FRAME_LINE_MAX 160
+#define GAP_SLOTS 64            // Zweierpotenz
+
+struct GapSlot {
+    const void *key;
+    uint16_t id;
+    unsigned long last;
+};
+
+static GapSlot gaps[GAP_SLOTS];
+static frame_sink_t frame_sink;
+
+void frame_set_sink(frame_sink_t sink)
+{
+    frame_sink = sink;
+}
+
+/* offene Adressierung; ist die Tabelle voll, wird der Heimat-Slot
+ * ueberschrieben und der verdraengte Sensor faengt wieder bei 0 an */
+unsigned long frame_gap(const void *key, uint16_t id)
+{
+    unsigned long now = millis();
+    uint32_t h = ((uint32_t)(uintptr_t)key >> 2) * 31 + id;
+    h ^= h >> 7;
+    for (int i = 0; i < GAP_SLOTS; i++) {
+        GapSlot &s = gaps[(h + i) & (GAP_SLOTS - 1)];
+        if (s.key == key && s.id == id) {
+            unsigned long gap = now - s.last;
+            s.last = now;
+            return gap;
+        }
+        if (s.key == NULL) {
+            s.key = key;
+            s.id = id;
+            s.last = now;
+            return 0;
+        }
+    }
+    GapSlot &s = gaps[h & (GAP_SLOTS - 1)];
+    s.key = key;
+    s.id = id;
+    s.last = now;
+    return 0;
+}
+
+static int field_int(const FrameField &f, const void *frame)
+{
+    const uint8_t *p = (const uint8_t *)frame + f.offset;
+    switch (f.type) {
+    case FT_U8:   return *(const uint8_t *)p;
+    case FT_I8:   return *(const int8_t *)p;
+    case FT_U16:  return *(const uint16_t *)p;
+    case FT_I16:  return *(const int16_t *)p;
+    case FT_INT:  return *(const int *)p;
+    case FT_BOOL: return *(const bool *)p ? 1 : 0;
+    case FT_FLOAT: return (int)*(const float *)p;
+    }
+    return 0;
+}
+
+size_t format_raw(char *buf, size_t size, const uint8_t *data, uint8_t len)
+{
+    static const char hex[] = "0123456789ABCDEF";
+    size_t n = 0;
+    if (size == 0)
+        return 0;
+    for (uint8_t i = 0; i < len && n + 3 < size; i++) {
+        if (i)
+            buf[n++] = ' ';
+        buf[n++] = hex[data[i] >> 4];
+        buf[n++] = hex[data[i] & 0x0F];
+    }
+    buf[n] = '\0';
+    return n;
+}
+
+static size_t append(char *buf, size_t size, size_t n, int r)
+{
+    if (r < 0)
+        return n;
+    n += r;
+    return n < size ? n : size - 1;
+}
+
+static size_t format_head(char *buf, size_t size, unsigned long gap, const char *name,
+                          const uint8_t *data, uint8_t len, int rssi, int rate)
+{
+    size_t n = append(buf, size, 0, snprintf(buf, size, "%6ld %s [", (long)gap, name));
+    n += format_raw(buf + n, size - n, data, len);
+    return append(buf, size, n, snprintf(buf + n, size - n, "] rssi%-4d rate%-5d", rssi, rate));
+}
+
+size_t format_frame(char *buf, size_t size, const FrameFormat &fmt, const void *frame,
+                    const uint8_t *data, uint8_t len)
+{
+    uint16_t id = field_int(fmt.id, frame);
+    size_t n = format_head(buf, size, frame_gap(&fmt, id), fmt.name, data, len,
+                           field_int(fmt.rssi, frame), field_int(fmt.rate, frame));
+
+    for (uint8_t i = 0; i < fmt.count; i++) {
+        const FrameField &f = fmt.fields[i];
+        int r;
+        if (f.type == FT_TEXT) {
+            r = snprintf(buf + n, size - n, f.fmt, f.text(frame));
+        } else if (f.type == FT_FLOAT) {
+            r = snprintf(buf + n, size - n, f.fmt, *(const float *)((const uint8_t *)frame + f.offset));
+        } else {
+            int v = field_int(f, frame);
+            if ((f.flags & FF_HUMI) && (v <= 0 || v > 100))
+                continue;
+            r = snprintf(buf + n, size - n, f.fmt, v);
+        }
+        n = append(buf, size, n, r);
+    }
+    return n;
+}
+
+static void emit(const char *line, size_t len)
+{
+    log_write(LL_INFO, line, len);
+    if (frame_sink)
+        frame_sink(line);
+}
+
+bool print_frame(const FrameFormat &fmt, const void *frame, const uint8_t *data, uint8_t len)
+{
+    if (log_level < LL_INFO && !frame_sink)
+        return true;
+    char line[FRAME_LINE_MAX];
+    emit(line, format_frame(line, sizeof(line), fmt, frame, data, len));
+    return true;
+}
+
+void print_raw(const char *name, const uint8_t *data, uint8_t len, int rssi, int rate)
+{
+    if (log_level < LL_INFO && !frame_sink)
+        return;
+    char line[FRAME_LINE_MAX];
+    emit(line, format_head(line, sizeof(line), frame_gap(name, 0), name, data, len, rssi, rate));
+}
@@ -0,0 +1,85 @@
+#ifndef _FRAMEFORMAT_H
+#define _FRAMEFORMAT_H
+
+#include <Arduino.h>
+#include <stddef.h>
+
+/*
+ * Einheitliche Textausgabe dekodierter Frames:
+ *   "  gap_ms NAME [AA BB ..] rssi-80 rate17241 <Felder>"
+ * Jeder Decoder beschreibt seine Felder nur noch als Tabelle
+ * (printf-Fragment + Position im Frame-Struct), der Typ wird vom
+ * Compiler aus dem Struct-Member abgeleitet.
+ */
+
+enum FieldType {
+    FT_U8 = 0,
+    FT_I8,
+    FT_U16,
+    FT_I16,
+    FT_INT,
+    FT_FLOAT,
+    FT_BOOL,
+    FT_TEXT
+};
+
+template <typename T> struct field_type;
+template <> struct field_type<uint8_t>  { static const uint8_t value = FT_U8; };
+template <> struct field_type<int8_t>   { static const uint8_t value = FT_I8; };
+template <> struct field_type<uint16_t> { static const uint8_t value = FT_U16; };
+template <> struct field_type<int16_t>  { static const uint8_t value = FT_I16; };
+template <> struct field_type<int>      { static const uint8_t value = FT_INT; };
+template <> struct field_type<float>    { static const uint8_t value = FT_FLOAT; };
+template <> struct field_type<bool>     { static const uint8_t value = FT_BOOL; };
+
+/* Feld nur ausgeben, wenn es eine gueltige Luftfeuchte ist (1..100) */
+#define FF_HUMI 0x01
+
+typedef const char *(*field_text_t)(const void *frame);
+
+struct FrameField {
+    const char *fmt;        // printf-Fragment mit genau einer Umwandlung
+    uint8_t type;
+    uint8_t flags;
+    uint16_t offset;
+    field_text_t text;      // nur FT_TEXT
+};
+
+struct FrameFormat {
+    const char *name;
+    FrameField id;
+    FrameField rssi;
+    FrameField rate;
+    const FrameField *fields;
+    uint8_t count;
+};
+
+#define FRAME_FIELD(T, m, fmt) \
+    { fmt, field_type<decltype(T::m)>::value, 0, (uint16_t)offsetof(T, m), NULL }
+#define FRAME_FIELD_IF(T, m, fmt, flags) \
+    { fmt, field_type<decltype(T::m)>::value, flags, (uint16_t)offsetof(T, m), NULL }
+#define FRAME_TEXT(fmt, fn) \
+    { fmt, FT_TEXT, 0, 0, fn }
+#define FRAME_FORMAT(name, T, fields) \
+    { name, FRAME_FIELD(T, ID, NULL), FRAME_FIELD(T, rssi, NULL), FRAME_FIELD(T, rate, NULL), \
+      fields, sizeof(fields) / sizeof(fields[0]) }
+
+/* "AA BB CC", liefert die Laenge */
+size_t format_raw(char *buf, size_t size, const uint8_t *data, uint8_t len);
+
+/* vollstaendige Zeile in buf, liefert die Laenge */
+size_t format_frame(char *buf, size_t size, const FrameFormat &fmt, const void *frame,
+                    const uint8_t *data, uint8_t len);
+
+/* Zeile formatieren und ausgeben (Log und ggf. frame_sink) */
+bool print_frame(const FrameFormat &fmt, const void *frame, const uint8_t *data, uint8_t len);
+void print_raw(const char *name, const uint8_t *data, uint8_t len, int rssi, int rate);
+
+/* zusaetzlicher Ausgang fuer jede Zeile, z.B. MQTT im Debug-Modus */
+typedef void (*frame_sink_t)(const char *line);
+void frame_set_sink(frame_sink_t sink);
+
+/* ms seit dem letzten Frame desselben Sensors, 0 beim ersten */
+unsigned long frame_gap(const void *key, uint16_t id);
+
+#endif
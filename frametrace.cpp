@@ -0,0 +1,71 @@
+/*
+ * Latenz eines Frames vom Auslesen im Radio-Task bis zum Socket, als
+ * Histogramm je Station (perfstats.h). Alle Stationen ausser TRACE_WRITTEN
+ * werden vom Decode-Task geschrieben, TRACE_WRITTEN vom Netzwerk-Task.
+ */
+#include "frametrace.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+
+static PerfHist hists[TRACE_NUM];
+
+static const char *stage_names[TRACE_NUM] = {
+    "dequeued", "decoded", "cached", "enqueued", "written"
+};
+
+static TaskHandle_t owner;
+static int64_t cur_rx_us;
+static bool marked[TRACE_NUM];
+
+void trace_begin(int64_t rx_us)
+{
+    owner = xTaskGetCurrentTaskHandle();
+    cur_rx_us = rx_us;
+    memset(marked, 0, sizeof(marked));
+    trace_mark(TRACE_DEQUEUED);
+}
+
+void trace_mark(TraceStage s)
+{
+    if (cur_rx_us == 0 || marked[s] || xTaskGetCurrentTaskHandle() != owner)
+        return;
+    marked[s] = true;
+    perf_hist_add(hists[s], (uint32_t)(esp_timer_get_time() - cur_rx_us));
+}
+
+void trace_end()
+{
+    cur_rx_us = 0;
+}
+
+void trace_written(int64_t rx_us)
+{
+    static int64_t last_rx_us;
+    // nur die erste Nachricht eines Frames, die weiteren warten hinter ihr
+    if (rx_us == 0 || rx_us == last_rx_us)
+        return;
+    last_rx_us = rx_us;
+    perf_hist_add(hists[TRACE_WRITTEN], (uint32_t)(esp_timer_get_time() - rx_us));
+}
+
+const PerfHist &trace_hist(TraceStage s)
+{
+    return hists[s];
+}
+
+const char *trace_stage_name(TraceStage s)
+{
+    return stage_names[s];
+}
+
+void trace_report(JsonObject obj)
+{
+    for (int s = 0; s < TRACE_NUM; s++) {
+        const PerfHist &h = hists[s];
+        JsonObject st = obj[stage_names[s]].to<JsonObject>();
+        st["count"] = h.count;
+        st["p50"] = perf_hist_percentile(h, 0.50);
+        st["p99"] = perf_hist_percentile(h, 0.99);
+        st["max"] = h.max_us;
+    }
+}
@@ -0,0 +1,36 @@
+#ifndef _FRAMETRACE_H
+#define _FRAMETRACE_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+#include "perfstats.h"
+
+/* Stationen eines Frames vom Funk bis zum Broker. Gemessen wird jeweils
+ * die Zeit seit dem Auslesen im SX127x, so bleiben die Werte auch dann
+ * vergleichbar, wenn ein Decoder den Cache schon vor der Rueckmeldung
+ * "dekodiert" schreibt. */
+enum TraceStage {
+    TRACE_DEQUEUED = 0, // Decode-Task hat den Frame aus der Raw-Queue
+    TRACE_DECODED,      // ein Decoder hat den Frame angenommen
+    TRACE_CACHED,       // fcache aktualisiert
+    TRACE_ENQUEUED,     // erste MQTT-Nachricht in der Publish-Queue
+    TRACE_WRITTEN,      // erste MQTT-Nachricht in den Socket geschrieben
+    TRACE_NUM
+};
+
+/* Decode-Task, je Frame. Nur Aufrufe aus diesem Task werden gezaehlt,
+ * je Station der erste pro Frame. */
+void trace_begin(int64_t rx_us);
+void trace_mark(TraceStage s);
+void trace_end();
+
+/* Netzwerk-Task, je gesendeter Nachricht */
+void trace_written(int64_t rx_us);
+
+const PerfHist &trace_hist(TraceStage s);
+const char *trace_stage_name(TraceStage s);
+
+/* p50/p99/max/count in us je Station, fuer API und MQTT */
+void trace_report(JsonObject obj);
+
+#endif
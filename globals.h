@@ -1,6 +1,9 @@
 #ifndef _GLOBALS_H
 #define _GLOBALS_H
 
+#include "frametrace.h"
+#include "strtab.h"
+
 #define LACROSSE2MQTT_VERSION "v2026.2.5"
 
 /* if not heltec_lora_32_v2 board... */
@@ -57,6 +60,10 @@ static const uint8_t LED_BUILTIN = 2;
 #define HASS_CFG_UV (1 << 10)             // NEU für UV-Index
 #define HASS_CFG_LIGHT (1 << 11)          // NEU für Lichtintensität
 
+/* Sprung gegenueber dem vorherigen Wert klein genug fuer HA-Discovery */
+#define PLAUSIBLE_TEMP (1 << 0)   // max. 2.0 °C
+#define PLAUSIBLE_HUMI (1 << 1)   // max. 10 %
+
 #define BASE_SENSOR_TIMEOUT 300000   // 5 Minuten Basis-Timeout
 #define TIMEOUT_PER_PROTOCOL 60000   // +1 Minute pro aktiviertem Protokoll
 
@@ -68,17 +75,19 @@ struct Cache {
     uint8_t data[FRAME_LENGTH];
     float temp;
     byte humi;
+    unsigned long temp_timestamp;   // 0 = Sensor ohne Temperatur (EMT7110, W136)
     bool batlo;
     bool init;
     bool valid;
     byte channel;
-    char sensorType[16];
+    StrId type;           // Sensortyp, str_get()
     
     // Kanal 2 Daten (nur Temperatur!)
     float temp_ch2;
     unsigned long timestamp_ch2;
     
     // Wetterstation Daten (bestehend)
+    // *_timestamp: letzte Aktualisierung, 0 = Sensor liefert den Wert nicht
     float wind_speed;
     int wind_direction;
     float rain;
@@ -106,6 +115,12 @@ struct Cache {
     float light_lux;      // Lichtintensität in Lux
     unsigned long uv_timestamp;
     unsigned long light_timestamp;
+
+    // Update-Sequenz der letzten Änderung (fuer /sensors.json?since=)
+    uint32_t seq;
+
+    // PLAUSIBLE_* des letzten Frames, Vergleich mit den vorherigen Werten
+    uint8_t plausible;
 };
 
 // Hilfsfunktion für Cache-Index
@@ -123,6 +138,9 @@ struct Config {
     bool debug_mode;
     bool screensaver_mode;
     bool mqtt_use_names;
+    bool lacrosse_fec;       // LaCrosse IT+ Einzelbitfehler korrigieren
+    float filter_temp_step;  // Ausreisserfilter, max. Sprung je Frame in Grad, 0 = aus
+    float filter_humi_step;  // dito in %
     bool changed;
     bool proto_lacrosse;
     bool proto_wh1080;
@@ -144,12 +162,87 @@ extern int num_datarates;
 extern unsigned long last_toggle_time;
 extern Config config;
 extern Cache fcache[];
-extern String id2name[SENSOR_NUM];
+extern StrId id2name[SENSOR_NUM];     // vergebene Namen, strtab.h
+
+/* Name des Sensors, "" wenn keiner vergeben; der Zeiger bleibt gueltig */
+static inline const char *sensor_name(int id) { return str_get(id2name[id]); }
+static inline bool has_sensor_name(int id) { return id2name[id] != STR_NONE; }
 extern uint8_t hass_cfg[SENSOR_NUM];
 extern uint16_t hass_published[SENSOR_NUM];
 extern bool littlefs_ok;
 extern bool mqtt_ok;
 
+/* Startablauf in ms seit dem Boot, 0 = noch nicht erreicht (/api/system) */
+struct BootTimes {
+    uint32_t radio;         // Empfaenger laeuft
+    uint32_t first_frame;   // erster Frame vom Funkmodul
+    uint32_t wifi;
+    uint32_t ntp;
+    uint32_t mqtt;
+};
+extern BootTimes boot_times;
+
+/* monotonically increasing update sequence, one step per cache change.
+ * seq_log remembers which cache index got which sequence number, so
+ * delta requests only need to look at the entries changed since then */
+#define SEQ_LOG_SIZE 64
+extern uint32_t sensor_seq;
+extern uint8_t seq_log[SEQ_LOG_SIZE];
+/* zufaellig je Start, sensor_seq beginnt nach einem Neustart wieder bei 0 */
+extern uint32_t boot_epoch;
+
+static inline void mark_sensor_changed(int idx) {
+    uint32_t seq = sensor_seq + 1;
+    seq_log[seq % SEQ_LOG_SIZE] = idx;
+    fcache[idx].seq = seq;
+    sensor_seq = seq;
+    trace_mark(TRACE_CACHED);
+}
+
+/* fcache hat genau einen Schreiber: den Decode-Task (handle_frame(),
+ * expire_cache()); snapshot_restore() schreibt nur in setup(), bevor die
+ * Tasks laufen. Webserver, Netzwerk und Display lesen parallel. Seqlock: cache_gen ist waehrend eines
+ * Schreibvorgangs ungerade, Leser kopieren den Eintrag und versuchen es
+ * erneut, falls sich cache_gen dabei geaendert hat. Der Schreiber wartet nie. */
+extern volatile uint32_t cache_gen;
+
+static inline void cache_write_begin() {
+    cache_gen = cache_gen + 1;
+    __sync_synchronize();
+}
+
+static inline void cache_write_end() {
+    __sync_synchronize();
+    cache_gen = cache_gen + 1;
+}
+
+static inline void cache_read(int idx, Cache *dst) {
+    for (int tries = 0; ; tries++) {
+        uint32_t gen = cache_gen;
+        __sync_synchronize();
+        if (!(gen & 1)) {
+            memcpy(dst, (const void *)&fcache[idx], sizeof(Cache));
+            __sync_synchronize();
+            if (cache_gen == gen)
+                return;
+        }
+        if (tries > 8)
+            delay(1);
+    }
+}
+
+/* Alter eines gelesenen Eintrags; er kann nach "now" geschrieben worden sein */
+static inline unsigned long cache_age(const Cache &c, unsigned long now) {
+    return (long)(now - c.timestamp) > 0 ? now - c.timestamp : 0;
+}
+
+/* Lock fuer id2name[] und die Strings in config, die der Webserver aendert
+ * (die Namen selbst liegen unveraenderlich in strtab, nur die Zuordnung).
+ * Der Webserver haelt ihn nur fuer die Zuweisungen (nie waehrend LittleFS-
+ * Schreibzugriffen), der Empfang fuer die Bearbeitung eines Frames. */
+void state_lock();
+void state_unlock();
+
 static inline uint32_t uptime_sec() { return (esp_timer_get_time()/(int64_t)1000000); }
 
 int get_current_datarate();
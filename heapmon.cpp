@@ -0,0 +1,141 @@
+#include "heapmon.h"
+#include "heaptrace.h"
+#include "snapshot.h"
+#include "asynclog.h"
+#include <Update.h>
+#include <esp_system.h>
+
+#define HEAP_RTC_MAGIC 0x48454150   // "HEAP"
+
+HeapStats heap_stats;
+
+struct HeapSample {
+    uint32_t uptime;        // s
+    uint32_t free;
+    uint32_t largest;
+};
+
+static HeapSample samples[HEAP_HISTORY];
+static uint8_t sample_pos, sample_count;
+
+/* ueberlebt ESP.restart(), nicht das Ausschalten */
+struct HeapRtc {
+    uint32_t magic;
+    uint16_t restarts;
+    uint32_t largest;       // groesster Block beim letzten geplanten Neustart
+};
+
+RTC_NOINIT_ATTR static HeapRtc heap_rtc;
+
+// update_check.h
+extern bool updateCheckInProgress;
+extern bool updateInstallInProgress;
+
+static bool heap_low()
+{
+    return (HEAP_RESTART_LARGEST && heap_stats.largest < HEAP_RESTART_LARGEST) ||
+           (HEAP_RESTART_FREE && heap_stats.free < HEAP_RESTART_FREE);
+}
+
+static void planned_restart()
+{
+    LOGW("heap: largest block %lu, free %lu below limit for %lu s, restarting",
+         (unsigned long)heap_stats.largest, (unsigned long)heap_stats.free,
+         (unsigned long)(HEAP_RESTART_HOLD_MS / 1000));
+    heap_rtc.magic = HEAP_RTC_MAGIC;
+    heap_rtc.restarts = heap_stats.planned_restarts + 1;
+    heap_rtc.largest = heap_stats.largest;
+    snapshot_save();
+    delay(200);     // Log noch hinaus lassen
+    ESP.restart();
+}
+
+void heap_poll()
+{
+    static unsigned long last_sample, last_history;
+    static bool started;
+    unsigned long now = millis();
+    if (!started) {
+        started = true;
+        if (esp_reset_reason() == ESP_RST_POWERON || heap_rtc.magic != HEAP_RTC_MAGIC)
+            heap_rtc.restarts = 0;
+        heap_stats.planned_restarts = heap_rtc.restarts;
+        heap_stats.largest_min = UINT32_MAX;
+    } else if (now - last_sample < HEAP_SAMPLE_MS) {
+        return;
+    }
+    last_sample = now;
+
+    heap_stats.free = ESP.getFreeHeap();
+    heap_stats.min_free = ESP.getMinFreeHeap();
+    heap_stats.largest = ESP.getMaxAllocHeap();
+    if (heap_stats.largest < heap_stats.largest_min)
+        heap_stats.largest_min = heap_stats.largest;
+
+    if (sample_count == 0 || now - last_history >= HEAP_HISTORY_MS) {
+        last_history = now;
+        samples[sample_pos] = { (uint32_t)(now / 1000), heap_stats.free, heap_stats.largest };
+        sample_pos = (sample_pos + 1) % HEAP_HISTORY;
+        if (sample_count < HEAP_HISTORY)
+            sample_count++;
+    }
+
+    if (!heap_low()) {
+        heap_stats.low_since = 0;
+        return;
+    }
+    if (!heap_stats.low_since) {
+        heap_stats.low_since = now ? now : 1;
+        LOGW("heap: largest block %lu, free %lu below limit", (unsigned long)heap_stats.largest,
+             (unsigned long)heap_stats.free);
+    }
+    bool busy = Update.isRunning() || updateCheckInProgress || updateInstallInProgress;
+    if (!busy && now - heap_stats.low_since >= HEAP_RESTART_HOLD_MS)
+        planned_restart();
+}
+
+void heap_report(JsonObject out, bool history)
+{
+    out["free"] = heap_stats.free;
+    out["min_free"] = heap_stats.min_free;
+    out["largest"] = heap_stats.largest;
+    out["largest_min"] = heap_stats.largest_min;
+    out["low_for_s"] = heap_stats.low_since ? (millis() - heap_stats.low_since) / 1000 : 0;
+    out["planned_restarts"] = heap_stats.planned_restarts;
+    if (heap_stats.planned_restarts)
+        out["restart_largest"] = heap_rtc.largest;
+    if (!history)
+        return;
+
+    // [uptime s, free, largest], aelteste zuerst
+    JsonArray hist = out["history"].to<JsonArray>();
+    for (int i = 0; i < sample_count; i++) {
+        const HeapSample &s = samples[(sample_pos + HEAP_HISTORY - sample_count + i) % HEAP_HISTORY];
+        JsonArray p = hist.add<JsonArray>();
+        p.add(s.uptime);
+        p.add(s.free);
+        p.add(s.largest);
+    }
+
+#ifdef HEAP_TRACE
+    HeapTraceTotals t;
+    heap_trace_totals(&t);
+    JsonObject trace = out["trace"].to<JsonObject>();
+    trace["allocs"] = t.allocs;
+    trace["frees"] = t.frees;
+    trace["bytes"] = t.bytes;
+    trace["failed"] = t.failed;
+    trace["untracked"] = t.untracked;
+    static HeapTraceSite top[16];
+    int n = heap_trace_sites(top, 16);
+    JsonArray sites = trace["sites"].to<JsonArray>();
+    for (int i = 0; i < n; i++) {
+        char addr[12];
+        snprintf(addr, sizeof(addr), "0x%08lx", (unsigned long)top[i].site);
+        JsonObject s = sites.add<JsonObject>();
+        s["site"] = addr;
+        s["allocs"] = top[i].allocs;
+        s["bytes"] = top[i].bytes;
+    }
+#endif
+}
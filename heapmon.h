@@ -0,0 +1,44 @@
+#ifndef _HEAPMON_H
+#define _HEAPMON_H
+
+#include <Arduino.h>
+#include <ArduinoJson.h>
+
+/*
+ * Heap-Ueberwachung: alle HEAP_SAMPLE_MS freier Heap, Minimum seit dem
+ * Start und groesster freier Block (Fragmentierung), dazu ein Verlauf
+ * mit einem Wert je HEAP_HISTORY_MS fuer /api/system.
+ *
+ * Bleibt der groesste Block oder der freie Heap HEAP_RESTART_HOLD_MS
+ * lang unter der Schwelle, wird geplant neu gestartet: Snapshot
+ * schreiben (warmer Neustart, siehe snapshot.h), dann ESP.restart().
+ * Nicht waehrend eines Updates. Die Zahl dieser Neustarts ueberlebt im
+ * RTC-Speicher bis zum naechsten Einschalten.
+ */
+
+#define HEAP_SAMPLE_MS 10000
+#define HEAP_HISTORY 60
+#define HEAP_HISTORY_MS 60000
+#define HEAP_RESTART_LARGEST 20000    // Bytes, 0 = aus; TLS fuer update_check.h braucht ~16 KB am Stueck
+#define HEAP_RESTART_FREE 24000       // Bytes, 0 = aus
+#define HEAP_RESTART_HOLD_MS 900000
+
+struct HeapStats {
+    uint32_t free;
+    uint32_t min_free;          // ESP.getMinFreeHeap()
+    uint32_t largest;
+    uint32_t largest_min;       // kleinster groesster Block seit dem Start
+    uint32_t low_since;         // millis() seit Unterschreitung, 0 = ok
+    uint16_t planned_restarts;  // seit dem Einschalten
+};
+
+extern HeapStats heap_stats;
+
+/* aus loop() */
+void heap_poll();
+
+/* aktuelle Werte, mit history auch der Verlauf und (HEAP_TRACE) die
+ * Aufrufstellen; fuer /api/system und das Diagnose-Topic */
+void heap_report(JsonObject out, bool history);
+
+#endif
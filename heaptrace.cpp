@@ -0,0 +1,115 @@
+#include "heaptrace.h"
+
+#ifdef HEAP_TRACE
+
+#include <string.h>
+
+/* Tabelle ohne Lock: Eintraege werden per CAS belegt, Zaehler atomar
+ * erhoeht. Hier darf nichts allozieren, sonst ruft sich malloc selbst. */
+static HeapTraceSite sites[HEAP_TRACE_SITES];
+static HeapTraceTotals totals;
+
+#define ADD(var, n) __atomic_fetch_add(&(var), (n), __ATOMIC_RELAXED)
+
+static void record(uintptr_t site, size_t n)
+{
+    ADD(totals.allocs, 1);
+    ADD(totals.bytes, (uint32_t)n);
+    uint32_t h = (uint32_t)(site >> 2) * 2654435761u;
+    for (int i = 0; i < HEAP_TRACE_SITES; i++) {
+        HeapTraceSite &s = sites[(h + i) % HEAP_TRACE_SITES];
+        uintptr_t cur = __atomic_load_n(&s.site, __ATOMIC_RELAXED);
+        if (cur == 0) {
+            uintptr_t expected = 0;
+            if (__atomic_compare_exchange_n(&s.site, &expected, site, false, __ATOMIC_RELAXED,
+                                            __ATOMIC_RELAXED))
+                cur = site;
+            else
+                cur = expected;
+        }
+        if (cur == site) {
+            ADD(s.allocs, 1);
+            ADD(s.bytes, (uint32_t)n);
+            return;
+        }
+    }
+    ADD(totals.untracked, 1);
+}
+
+extern "C" {
+void *__real_malloc(size_t n);
+void *__real_calloc(size_t n, size_t size);
+void *__real_realloc(void *p, size_t n);
+void __real_free(void *p);
+
+void *__wrap_malloc(size_t n)
+{
+    void *p = __real_malloc(n);
+    if (p)
+        record((uintptr_t)__builtin_return_address(0), n);
+    else
+        ADD(totals.failed, 1);
+    return p;
+}
+
+void *__wrap_calloc(size_t n, size_t size)
+{
+    void *p = __real_calloc(n, size);
+    if (p)
+        record((uintptr_t)__builtin_return_address(0), n * size);
+    else
+        ADD(totals.failed, 1);
+    return p;
+}
+
+void *__wrap_realloc(void *old, size_t n)
+{
+    void *p = __real_realloc(old, n);
+    if (p)
+        record((uintptr_t)__builtin_return_address(0), n);
+    else if (n)
+        ADD(totals.failed, 1);
+    return p;
+}
+
+void __wrap_free(void *p)
+{
+    if (p)
+        ADD(totals.frees, 1);
+    __real_free(p);
+}
+}
+
+int heap_trace_sites(HeapTraceSite *out, int max)
+{
+    int n = 0;
+    for (int i = 0; i < HEAP_TRACE_SITES; i++) {
+        HeapTraceSite s;
+        s.site = __atomic_load_n(&sites[i].site, __ATOMIC_RELAXED);
+        if (!s.site)
+            continue;
+        s.allocs = __atomic_load_n(&sites[i].allocs, __ATOMIC_RELAXED);
+        s.bytes = __atomic_load_n(&sites[i].bytes, __ATOMIC_RELAXED);
+        // einsortieren, die kleinsten fallen hinten raus
+        int k = n < max ? n++ : max;
+        while (k > 0 && out[k - 1].bytes < s.bytes) {
+            if (k < max)
+                out[k] = out[k - 1];
+            k--;
+        }
+        if (k < max)
+            out[k] = s;
+    }
+    return n;
+}
+
+void heap_trace_totals(HeapTraceTotals *out)
+{
+    out->allocs = __atomic_load_n(&totals.allocs, __ATOMIC_RELAXED);
+    out->frees = __atomic_load_n(&totals.frees, __ATOMIC_RELAXED);
+    out->bytes = __atomic_load_n(&totals.bytes, __ATOMIC_RELAXED);
+    out->failed = __atomic_load_n(&totals.failed, __ATOMIC_RELAXED);
+    out->untracked = __atomic_load_n(&totals.untracked, __ATOMIC_RELAXED);
+}
+
+#endif
@@ -0,0 +1,43 @@
+#ifndef _HEAPTRACE_H
+#define _HEAPTRACE_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+/*
+ * Allokationen nach Aufrufstelle zaehlen, nur im Debug-Build mit
+ * -DHEAP_TRACE und den Linker-Optionen
+ *   -Wl,--wrap=malloc -Wl,--wrap=calloc -Wl,--wrap=realloc -Wl,--wrap=free
+ * (platformio.ini: env ttgo-lora32-v21-heaptrace). Ohne HEAP_TRACE ist
+ * nichts davon im Image.
+ *
+ * Die Aufrufstelle ist die Ruecksprungadresse des malloc()-Aufrufs, bei
+ * String also meist String::changeBuffer, bei new der operator new;
+ * Adressen mit addr2line (xtensa-esp32-elf-addr2line -e firmware.elf)
+ * aufloesen. Der Code hier braucht weder Arduino noch FreeRTOS, ein
+ * Host-Build mit denselben Linker-Optionen zaehlt genauso.
+ */
+
+#define HEAP_TRACE_SITES 64
+
+struct HeapTraceSite {
+    uintptr_t site;         // 0 = frei
+    uint32_t allocs;
+    uint32_t bytes;
+};
+
+struct HeapTraceTotals {
+    uint32_t allocs;
+    uint32_t frees;
+    uint32_t bytes;
+    uint32_t failed;        // malloc lieferte NULL
+    uint32_t untracked;     // Tabelle voll
+};
+
+#ifdef HEAP_TRACE
+/* Kopie der Tabelle, nach bytes absteigend; liefert die Anzahl */
+int heap_trace_sites(HeapTraceSite *out, int max);
+void heap_trace_totals(HeapTraceTotals *out);
+#endif
+
+#endif
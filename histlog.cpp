@@ -0,0 +1,438 @@
+#include "histlog.h"
+#include "history.h"
+#include "globals.h"
+#include "asynclog.h"
+#include <LittleFS.h>
+#include <time.h>
+
+HistLogStats histlog_stats;
+
+struct Segment {
+    uint32_t seq;
+    char kind;              // 'r' Rohwerte, 'h' Stundenwerte
+    uint32_t size;
+    uint32_t newest;        // juengster Eintrag, 0 = unbekannt
+};
+
+static Segment segs[HISTLOG_SEGS_MAX];
+static uint8_t nsegs;
+
+/* RAM-Puffer zwischen Decode-Task und Schreib-Task */
+static HistLogEntry pending[HISTLOG_PENDING];
+static uint16_t pend_head, pend_tail;
+static portMUX_TYPE pend_mux = portMUX_INITIALIZER_UNLOCKED;
+
+/* nur im Schreib-Task (bzw. vorher in histlog_start) */
+static HistLogPage page;
+static uint32_t page_since;     // millis() des ersten Eintrags
+static uint32_t cur_seq;
+static uint16_t cur_pages;
+static HistLogPage io_page;
+static HistLogPage out_page;
+static volatile bool recovering;
+
+static uint32_t crc32_page(const HistLogPage &p)
+{
+    const uint8_t *d = (const uint8_t *)p.e;
+    size_t len = p.n * sizeof(HistLogEntry);
+    uint32_t crc = 0xFFFFFFFF;
+    for (size_t i = 0; i < len; i++) {
+        crc ^= d[i];
+        for (int k = 0; k < 8; k++)
+            crc = (crc >> 1) ^ (0xEDB88320 & -(crc & 1));
+    }
+    return ~crc;
+}
+
+static String seg_path(char kind, uint32_t seq, const char *ext = "log")
+{
+    char buf[32];
+    snprintf(buf, sizeof(buf), HISTLOG_DIR "/%c%08lu.%s", kind, (unsigned long)seq, ext);
+    return String(buf);
+}
+
+static void drop_segment(int i);
+
+static bool seg_before(uint32_t seq, char kind, const Segment &s)
+{
+    return seq < s.seq || (seq == s.seq && kind == 'h' && s.kind == 'r');
+}
+
+static void add_segment(uint32_t seq, char kind, uint32_t size, uint32_t newest)
+{
+    if (nsegs == HISTLOG_SEGS_MAX) {
+        // Tabelle voll: das aelteste Segment faellt weg, notfalls das neue
+        histlog_stats.evicted++;
+        if (seg_before(seq, kind, segs[0])) {
+            LOGW("histlog: segment table full, removing %c%08lu", kind, (unsigned long)seq);
+            LittleFS.remove(seg_path(kind, seq));
+            return;
+        }
+        LOGW("histlog: segment table full, removing %c%08lu", segs[0].kind, (unsigned long)segs[0].seq);
+        drop_segment(0);
+    }
+    // nach seq sortiert halten, Stunden- vor Rohsegment gleicher Nummer
+    int i = nsegs;
+    while (i > 0 && seg_before(seq, kind, segs[i - 1])) {
+        segs[i] = segs[i - 1];
+        i--;
+    }
+    segs[i].seq = seq;
+    segs[i].kind = kind;
+    segs[i].size = size;
+    segs[i].newest = newest;
+    nsegs++;
+}
+
+static void drop_segment(int i)
+{
+    LittleFS.remove(seg_path(segs[i].kind, segs[i].seq));
+    nsegs--;
+    memmove(&segs[i], &segs[i + 1], (nsegs - i) * sizeof(Segment));
+}
+
+static void update_stats()
+{
+    uint32_t bytes = 0;
+    for (int i = 0; i < nsegs; i++)
+        bytes += segs[i].size;
+    histlog_stats.bytes = bytes + cur_pages * HISTLOG_PAGE;
+    histlog_stats.segments = nsegs + (cur_pages > 0);
+}
+
+/* aelteste Segmente loeschen, bis das Budget passt */
+static void enforce_budget()
+{
+    update_stats();
+    while (nsegs > 0 && histlog_stats.bytes > HISTLOG_MAX_BYTES) {
+        drop_segment(0);
+        update_stats();
+    }
+}
+
+static bool page_ok(const HistLogPage &p)
+{
+    return p.magic == HISTLOG_MAGIC && p.n <= HISTLOG_PAGE_ENTRIES && p.crc == crc32_page(p);
+}
+
+static bool write_page(const String &path, HistLogPage &p)
+{
+    p.magic = HISTLOG_MAGIC;
+    p.crc = crc32_page(p);
+    File f = LittleFS.open(path, FILE_APPEND);
+    bool ok = f && f.write((const uint8_t *)&p, HISTLOG_PAGE) == HISTLOG_PAGE;
+    f.close();
+    return ok;
+}
+
+/* ---- Einlesen beim Start ---- */
+
+/* Rohwerte in Zeitfolge: der Ring behaelt selbst nur die letzten 24 h,
+ * aeltere gehen noch in Minuten- und Stundenwerte ein */
+static void replay_entry(const HistLogEntry &e)
+{
+    const char *metric = history_metric_name(e.metric);
+    if (!metric)
+        return;
+    if (e.count == 0) {
+        static const float div[] = { 1.0f, 10.0f, 100.0f, 1000.0f };
+        history_add_at(e.sensor, metric, e.decimals, e.t, e.v / div[e.decimals & 3], false);
+    } else {
+        history_restore_hour(e.sensor, metric, e.decimals, e.t, e.v - e.dmin, e.v + e.dmax, e.v, e.count);
+    }
+    histlog_stats.recovered++;
+}
+
+/* liefert den juengsten Zeitstempel */
+static uint32_t replay_segment(const Segment &s)
+{
+    uint32_t newest = 0;
+    File f = LittleFS.open(seg_path(s.kind, s.seq));
+    if (!f)
+        return 0;
+    while (f.read((uint8_t *)&io_page, HISTLOG_PAGE) == HISTLOG_PAGE) {
+        if (!page_ok(io_page)) {
+            histlog_stats.bad_pages++;
+            continue;
+        }
+        for (int i = 0; i < io_page.n; i++) {
+            replay_entry(io_page.e[i]);
+            if (io_page.e[i].t > newest)
+                newest = io_page.e[i].t;
+        }
+    }
+    f.close();
+    return newest;
+}
+
+static void scan_dir()
+{
+    File dir = LittleFS.open(HISTLOG_DIR);
+    if (!dir || !dir.isDirectory()) {
+        LittleFS.mkdir(HISTLOG_DIR);
+        return;
+    }
+    File file = dir.openNextFile();
+    while (file) {
+        String name = String(file.name());
+        uint32_t size = file.size();
+        file.close();
+        char kind = name.length() ? name.charAt(0) : 0;
+        uint32_t seq = strtoul(name.c_str() + 1, NULL, 10);
+        if (name.endsWith(".tmp") || (kind != 'r' && kind != 'h')) {
+            // abgebrochene Verdichtung
+            LittleFS.remove(String(HISTLOG_DIR "/") + name);
+        } else {
+            add_segment(seq, kind, size, 0);
+        }
+        file = dir.openNextFile();
+    }
+    // Verdichtung fertig, nur das remove fehlte noch
+    for (int i = 0; i + 1 < nsegs; i++)
+        if (segs[i].seq == segs[i + 1].seq && segs[i].kind == 'h' && segs[i + 1].kind == 'r')
+            drop_segment(i + 1);
+}
+
+/* ---- Schreib-Task ---- */
+
+void histlog_append(uint8_t sensor, uint8_t metric, uint8_t decimals, uint32_t t, int32_t v)
+{
+    portENTER_CRITICAL(&pend_mux);
+    uint16_t next = (pend_head + 1) % HISTLOG_PENDING;
+    if (next == pend_tail) {
+        portEXIT_CRITICAL(&pend_mux);
+        histlog_stats.dropped++;
+        return;
+    }
+    HistLogEntry &e = pending[pend_head];
+    e.t = t;
+    e.v = v;
+    e.dmin = e.dmax = 0;
+    e.sensor = sensor;
+    e.metric = metric;
+    e.decimals = decimals;
+    e.count = 0;
+    pend_head = next;
+    portEXIT_CRITICAL(&pend_mux);
+}
+
+static void flush_page()
+{
+    if (page.n == 0)
+        return;
+    if (write_page(seg_path('r', cur_seq), page)) {
+        histlog_stats.pages++;
+        if (++cur_pages == HISTLOG_SEG_PAGES) {
+            add_segment(cur_seq, 'r', cur_pages * HISTLOG_PAGE, page.e[page.n - 1].t);
+            cur_seq++;
+            cur_pages = 0;
+            enforce_budget();
+        }
+    } else {
+        histlog_stats.dropped += page.n;
+    }
+    page.n = 0;
+    update_stats();
+}
+
+static void drain_pending()
+{
+    for (;;) {
+        portENTER_CRITICAL(&pend_mux);
+        bool empty = pend_tail == pend_head;
+        if (!empty) {
+            if (page.n == 0)
+                page_since = millis();
+            page.e[page.n++] = pending[pend_tail];
+            pend_tail = (pend_tail + 1) % HISTLOG_PENDING;
+        }
+        portEXIT_CRITICAL(&pend_mux);
+        if (empty)
+            return;
+        if (page.n == HISTLOG_PAGE_ENTRIES)
+            flush_page();
+    }
+}
+
+struct HourAcc {
+    uint32_t hour;
+    uint8_t sensor;
+    uint8_t metric;
+    uint8_t decimals;
+    int32_t min;
+    int32_t max;
+    int64_t sum;
+    uint32_t count;
+};
+
+#define HOUR_ACC_NUM 48
+static HourAcc accs[HOUR_ACC_NUM];
+static uint8_t naccs;
+
+static int16_t clamp16(int32_t v)
+{
+    return v > 32767 ? 32767 : v < -32768 ? -32768 : v;
+}
+
+/* Stunden vor <before> schreiben (abgeschlossen, die Rohwerte kommen in
+ * Zeitfolge), die anderen bleiben offen */
+static bool emit_accs(const String &tmp, uint32_t before)
+{
+    bool ok = true;
+    int keep = 0;
+    for (int i = 0; i < naccs; i++) {
+        const HourAcc &a = accs[i];
+        if (a.hour >= before) {
+            accs[keep++] = a;
+            continue;
+        }
+        HistLogEntry &e = out_page.e[out_page.n++];
+        e.t = a.hour;
+        e.v = (int32_t)(a.sum / (int64_t)a.count);
+        e.dmin = clamp16(e.v - a.min);
+        e.dmax = clamp16(a.max - e.v);
+        e.sensor = a.sensor;
+        e.metric = a.metric;
+        e.decimals = a.decimals;
+        e.count = a.count > 255 ? 255 : a.count;
+        if (out_page.n == HISTLOG_PAGE_ENTRIES) {
+            ok &= write_page(tmp, out_page);
+            out_page.n = 0;
+        }
+    }
+    naccs = keep;
+    return ok;
+}
+
+static void acc_add(const HistLogEntry &e, const String &tmp, bool *ok)
+{
+    uint32_t hour = e.t - e.t % 3600;
+    int i;
+    for (i = 0; i < naccs; i++)
+        if (accs[i].hour == hour && accs[i].sensor == e.sensor && accs[i].metric == e.metric)
+            break;
+    if (i == naccs) {
+        if (naccs == HOUR_ACC_NUM)
+            *ok &= emit_accs(tmp, hour);
+        // alles noch offen (Zeitsprung zurueck): Teilwerte, beim Einlesen
+        // fuehrt history_restore_hour() sie wieder zusammen
+        if (naccs == HOUR_ACC_NUM)
+            *ok &= emit_accs(tmp, UINT32_MAX);
+        i = naccs++;
+        accs[i].hour = hour;
+        accs[i].sensor = e.sensor;
+        accs[i].metric = e.metric;
+        accs[i].decimals = e.decimals;
+        accs[i].min = accs[i].max = e.v;
+        accs[i].sum = 0;
+        accs[i].count = 0;
+    }
+    HourAcc &a = accs[i];
+    if (e.v < a.min)
+        a.min = e.v;
+    if (e.v > a.max)
+        a.max = e.v;
+    a.sum += e.v;
+    a.count++;
+}
+
+/* Rohsegment i zu Stundenwerten: h*.tmp schreiben, umbenennen, r*.log weg */
+static void compact_segment(int i)
+{
+    Segment s = segs[i];
+    String tmp = seg_path('h', s.seq, "tmp");
+    LittleFS.remove(tmp);
+    File f = LittleFS.open(seg_path('r', s.seq));
+    if (!f)
+        return;
+    bool ok = true;
+    naccs = 0;
+    out_page.n = 0;
+    while (f.read((uint8_t *)&io_page, HISTLOG_PAGE) == HISTLOG_PAGE) {
+        if (!page_ok(io_page))
+            continue;
+        for (int k = 0; k < io_page.n; k++)
+            acc_add(io_page.e[k], tmp, &ok);
+    }
+    f.close();
+    ok &= emit_accs(tmp, UINT32_MAX);
+    if (out_page.n > 0)
+        ok &= write_page(tmp, out_page);
+    File check = LittleFS.open(tmp);
+    uint32_t size = check ? check.size() : 0;
+    check.close();
+    if (!ok || !LittleFS.rename(tmp, seg_path('h', s.seq))) {
+        LittleFS.remove(tmp);
+        LOGW("histlog: compacting segment %lu failed", (unsigned long)s.seq);
+        return;
+    }
+    drop_segment(i);
+    add_segment(s.seq, 'h', size, s.newest);
+    histlog_stats.compactions++;
+    update_stats();
+}
+
+static void compact()
+{
+    uint32_t now = time(nullptr);
+    if (now < HIST_MIN_EPOCH)
+        return;
+    for (int i = 0; i < nsegs; i++) {
+        if (segs[i].kind == 'r' && segs[i].newest && segs[i].newest + HIST_RAW_SECONDS < now) {
+            compact_segment(i);
+            return;     // eins pro Durchlauf, der Task soll kurz bleiben
+        }
+    }
+}
+
+/* Log einlesen; der Empfang laeuft schon, history_add() puffert so lange */
+static void recover()
+{
+    uint32_t start = millis();
+    // Stundensegmente sind aelter (kleinere Nummer) und kommen zuerst
+    for (int i = 0; i < nsegs; i++)
+        segs[i].newest = replay_segment(segs[i]);
+    histlog_stats.recover_ms = millis() - start;
+    recovering = false;
+    LOGI("histlog: %u segments, %lu entries recovered in %lu ms, %lu bad pages",
+         histlog_stats.segments, (unsigned long)histlog_stats.recovered,
+         (unsigned long)histlog_stats.recover_ms, (unsigned long)histlog_stats.bad_pages);
+}
+
+bool histlog_recovering()
+{
+    return recovering;
+}
+
+static void histlog_task(void *arg)
+{
+    recover();
+    uint32_t last_compact = millis();
+    for (;;) {
+        vTaskDelay(pdMS_TO_TICKS(1000));
+        drain_pending();
+        if (page.n > 0 && millis() - page_since > HISTLOG_FLUSH_S * 1000UL)
+            flush_page();
+        if (millis() - last_compact > HISTLOG_COMPACT_S * 1000UL) {
+            last_compact = millis();
+            compact();
+        }
+    }
+}
+
+void histlog_start()
+{
+    if (!littlefs_ok)
+        return;
+    scan_dir();
+    enforce_budget();
+
+    // nie an ein altes Segment anhaengen, ein halber Seitenrest bleibt zu
+    cur_seq = nsegs ? segs[nsegs - 1].seq + 1 : 1;
+    cur_pages = 0;
+    update_stats();
+
+    recovering = true;
+    xTaskCreatePinnedToCore(histlog_task, "histlog", HISTLOG_TASK_STACK, NULL,
+                            HISTLOG_TASK_PRIO, NULL, HISTLOG_TASK_CORE);
+}
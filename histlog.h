@@ -0,0 +1,88 @@
+#ifndef _HISTLOG_H
+#define _HISTLOG_H
+
+#include <Arduino.h>
+
+/*
+ * Verlauf auf LittleFS: Rohwerte, die history.cpp im Ring ablegt, gehen
+ * zusaetzlich in ein Log aus Segmentdateien unter /hist, damit nach einem
+ * Neustart der Verlauf wieder da ist.
+ *
+ *  - Der Decode-Task stellt nur in einen RAM-Puffer (histlog_append(),
+ *    wartet nie). Ein eigener Task mit niedriger Prioritaet sammelt
+ *    daraus Seiten zu 512 Byte und haengt sie an (wenig Flash-Abnutzung).
+ *  - Jede Seite hat Magic und CRC, eine beim Absturz halb geschriebene
+ *    Seite wird beim Einlesen uebersprungen. Nach dem Start wird immer
+ *    ein neues Segment angefangen, alte werden nie mehr veraendert.
+ *  - Rohsegmente rollen nach 64 KB. Sind sie aelter als 24 h, werden sie
+ *    zu Stundenwerten verdichtet (r*.log -> h*.log ueber *.tmp, danach
+ *    rename/remove; ein Abbruch dazwischen wird beim Start aufgeraeumt).
+ *  - Ueber HISTLOG_MAX_BYTES oder HISTLOG_SEGS_MAX Segmenten werden die
+ *    aeltesten geloescht, das Einlesen beim Start ist damit nach oben
+ *    begrenzt.
+ */
+
+#define HISTLOG_DIR "/hist"
+#define HISTLOG_PAGE 512
+#define HISTLOG_SEG_PAGES 128          // 64 KB je Segment
+#define HISTLOG_MAX_BYTES (768 * 1024)
+#define HISTLOG_SEGS_MAX 48
+#define HISTLOG_FLUSH_S 600            // angefangene Seite spaetestens dann schreiben
+#define HISTLOG_COMPACT_S 3600
+#define HISTLOG_PENDING 256
+
+#define HISTLOG_TASK_PRIO 1
+#define HISTLOG_TASK_STACK 4096
+#define HISTLOG_TASK_CORE 0
+
+/* ein Rohwert (count 0) oder ein Stundenwert (count Messungen, bei mehr
+ * als 255 gekappt; v ist das Mittel, min/max als Abstand dazu) */
+struct HistLogEntry {
+    uint32_t t;
+    int32_t v;
+    int16_t dmin;
+    int16_t dmax;
+    uint8_t sensor;
+    uint8_t metric;         // history_metric_id()
+    uint8_t decimals;
+    uint8_t count;
+};
+
+#define HISTLOG_MAGIC 0x4C48      // "HL"
+
+#define HISTLOG_PAGE_ENTRIES ((HISTLOG_PAGE - 8) / sizeof(HistLogEntry))
+
+struct HistLogPage {
+    uint16_t magic;
+    uint16_t n;
+    uint32_t crc;           // ueber e[0..n-1]
+    HistLogEntry e[HISTLOG_PAGE_ENTRIES];
+    uint8_t pad[HISTLOG_PAGE - 8 - HISTLOG_PAGE_ENTRIES * sizeof(HistLogEntry)];
+};
+
+struct HistLogStats {
+    uint32_t pages;         // geschrieben seit dem Start
+    uint32_t bytes;         // Segmente auf dem Dateisystem
+    uint16_t segments;
+    uint32_t dropped;       // RAM-Puffer voll oder Schreibfehler
+    uint32_t recovered;     // beim Start eingelesene Eintraege
+    uint32_t bad_pages;
+    uint32_t compactions;
+    uint32_t recover_ms;
+    uint32_t evicted;       // Segmente geloescht, weil die Tabelle voll war
+};
+
+extern HistLogStats histlog_stats;
+
+/* Segmente auflisten und den Schreib-Task starten, der zuerst das Log
+ * einliest (begrenzt durch HISTLOG_MAX_BYTES). Blockiert nicht, der
+ * Empfang laeuft dabei schon. Nach history_init() und LittleFS.begin(). */
+void histlog_start();
+
+/* true, solange der Task das Log noch einliest */
+bool histlog_recovering();
+
+/* aus history.cpp, nie blockierend */
+void histlog_append(uint8_t sensor, uint8_t metric, uint8_t decimals, uint32_t t, int32_t v);
+
+#endif
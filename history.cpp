@@ -0,0 +1,464 @@
+#include "history.h"
+#include "globals.h"
+#include "asynclog.h"
+#include "histlog.h"
+#include <time.h>
+#include <esp_heap_caps.h>
+
+struct HistSeries {
+    uint8_t sensor;
+    uint8_t decimals;
+    int8_t next;            // naechste Serie desselben Sensors, -1 = Ende
+    char metric[HIST_METRIC_LEN];
+    HistBlock *blocks;      // Ring, HIST_RAW_BLOCKS
+    HistAgg *aggs[HT_NUM];  // [HT_MINUTE], [HT_HOUR]
+    uint16_t first;         // aeltester Block
+    uint16_t nblocks;
+    uint32_t last_t;        // letzte abgelegte Rohmessung
+    int32_t last_v;
+    uint32_t agg_first;     // aeltester/juengster Wert in den Verdichtungen,
+    uint32_t agg_last;      // auch ohne Rohwerte (aus Stundensegmenten)
+    uint32_t samples;
+};
+
+HistStats hist_stats;
+
+static HistSeries series[HIST_SERIES_MAX];
+static int8_t sensor_series[SENSOR_NUM];
+static SemaphoreHandle_t hist_mutex;
+static bool hist_enabled;
+
+static const uint32_t tier_len[HT_NUM] = { 0, 60, 3600 };
+static const uint32_t tier_slots[HT_NUM] = { 0, HIST_MINUTES, HIST_HOURS };
+static const float pow10f_tab[] = { 1.0f, 10.0f, 100.0f, 1000.0f };
+
+/* Reihenfolge ist das Dateiformat von histlog, nur hinten anfuegen */
+static const char *metric_names[] = {
+    "temp", "temp_ch2", "humi", "wind_speed", "wind_gust", "wind_bearing",
+    "rain", "power", "energy", "pressure", "uv", "light_lux"
+};
+
+int history_metric_id(const char *metric)
+{
+    for (uint8_t i = 0; i < sizeof(metric_names) / sizeof(metric_names[0]); i++)
+        if (strcmp(metric_names[i], metric) == 0)
+            return i;
+    return -1;
+}
+
+const char *history_metric_name(uint8_t id)
+{
+    if (id >= sizeof(metric_names) / sizeof(metric_names[0]))
+        return NULL;
+    return metric_names[id];
+}
+
+void history_init()
+{
+    memset(sensor_series, -1, sizeof(sensor_series));
+    hist_mutex = xSemaphoreCreateMutex();
+    hist_enabled = psramFound();
+    if (!hist_enabled)
+        LOGW("history: no PSRAM, history disabled");
+    else
+        LOGI("history: %d series x %u bytes", HIST_SERIES_MAX, (unsigned)HIST_SERIES_BYTES);
+}
+
+static int find_series(int sensor, const char *metric)
+{
+    for (int i = sensor_series[sensor]; i >= 0; i = series[i].next)
+        if (strcmp(series[i].metric, metric) == 0)
+            return i;
+    return -1;
+}
+
+static int new_series(int sensor, const char *metric, uint8_t decimals)
+{
+    if (hist_stats.series >= HIST_SERIES_MAX)
+        return -1;
+    uint8_t *mem = (uint8_t *)heap_caps_calloc(1, HIST_SERIES_BYTES, MALLOC_CAP_SPIRAM);
+    if (!mem)
+        return -1;
+    int i = hist_stats.series;
+    HistSeries &s = series[i];
+    s.sensor = sensor;
+    s.decimals = decimals > 3 ? 3 : decimals;
+    strncpy(s.metric, metric, HIST_METRIC_LEN - 1);
+    s.metric[HIST_METRIC_LEN - 1] = '\0';
+    s.blocks = (HistBlock *)mem;
+    s.aggs[HT_RAW] = NULL;
+    s.aggs[HT_MINUTE] = (HistAgg *)(mem + HIST_RAW_BLOCKS * sizeof(HistBlock));
+    s.aggs[HT_HOUR] = s.aggs[HT_MINUTE] + HIST_MINUTES;
+    s.first = 0;
+    s.nblocks = 0;
+    s.last_t = 0;
+    s.agg_first = s.agg_last = 0;
+    s.samples = 0;
+    s.next = sensor_series[sensor];
+    sensor_series[sensor] = i;
+    hist_stats.series++;
+    hist_stats.bytes += HIST_SERIES_BYTES;
+    return i;
+}
+
+static inline HistBlock &block_at(HistSeries &s, uint16_t i)
+{
+    return s.blocks[(s.first + i) % HIST_RAW_BLOCKS];
+}
+
+static void agg_add(HistAgg *ring, uint32_t len, uint32_t slots, uint32_t t, int32_t v)
+{
+    uint32_t start = t - t % len;
+    HistAgg &a = ring[(t / len) % slots];
+    if (a.t != start) {
+        a.t = start;
+        a.min = a.max = v;
+        a.sum = v;
+        a.count = 1;
+        return;
+    }
+    if (v < a.min)
+        a.min = v;
+    if (v > a.max)
+        a.max = v;
+    a.sum += v;
+    if (a.count < 0xFFFF)
+        a.count++;
+}
+
+static void agg_span(HistSeries &s, uint32_t t)
+{
+    if (!s.agg_first || t < s.agg_first)
+        s.agg_first = t;
+    if (t > s.agg_last)
+        s.agg_last = t;
+}
+
+static void raw_new_block(HistSeries &s, uint32_t t, int32_t v)
+{
+    if (s.nblocks == HIST_RAW_BLOCKS) {
+        s.first = (s.first + 1) % HIST_RAW_BLOCKS;
+        s.nblocks--;
+    }
+    // Bloecke, die komplett aelter als 24 h sind, freigeben
+    while (s.nblocks > 1 && block_at(s, 1).t0 + HIST_RAW_SECONDS <= t) {
+        s.first = (s.first + 1) % HIST_RAW_BLOCKS;
+        s.nblocks--;
+    }
+    HistBlock &b = block_at(s, s.nblocks);
+    b.t0 = t;
+    b.v0 = v;
+    b.used = 0;
+    b.count = 1;
+    s.nblocks++;
+}
+
+#define DT_LONG 0xFF    // dt-Byte: 4 Byte Sekunden folgen
+
+/* Delta (dt, dv) anhaengen; dt DT_LONG kennzeichnet eine folgende 32-Bit-
+ * Zeitdifferenz, dv -128 einen folgenden Absolutwert.
+ * false: unveraendert, nicht abgelegt */
+static bool raw_add(HistSeries &s, uint32_t t, int32_t v)
+{
+    if (s.nblocks > 0 && v == s.last_v && t - s.last_t < HIST_KEEPALIVE_S)
+        return false;
+    if (s.nblocks == 0) {
+        raw_new_block(s, t, v);
+    } else {
+        HistBlock *b = &block_at(s, s.nblocks - 1);
+        uint32_t dt = t - s.last_t;
+        int32_t dv = v - s.last_v;
+        bool small = dv > -128 && dv <= 127;
+        bool long_dt = dt >= DT_LONG;
+        if (b->used + (long_dt ? 5 : 1) + (small ? 1 : 5) > sizeof(b->data)) {
+            raw_new_block(s, t, v);
+        } else {
+            if (long_dt) {
+                b->data[b->used++] = DT_LONG;
+                memcpy(b->data + b->used, &dt, 4);
+                b->used += 4;
+            } else {
+                b->data[b->used++] = dt;
+            }
+            if (small) {
+                b->data[b->used++] = (uint8_t)(int8_t)dv;
+            } else {
+                b->data[b->used++] = 0x80;
+                memcpy(b->data + b->used, &v, 4);
+                b->used += 4;
+            }
+            b->count++;
+        }
+    }
+    s.last_t = t;
+    s.last_v = v;
+    hist_stats.stored++;
+    return true;
+}
+
+void history_add_at(int sensor, const char *metric, uint8_t decimals, uint32_t t, float v,
+                    bool persist)
+{
+    if (!hist_enabled || sensor < 0 || sensor >= SENSOR_NUM || isnan(v))
+        return;
+    // nie auf den Webserver warten, lieber den Wert verwerfen; das Einlesen
+    // des Logs laeuft im histlog-Task und darf nichts verlieren
+    if (t < HIST_MIN_EPOCH || xSemaphoreTake(hist_mutex, persist ? 1 : portMAX_DELAY) != pdTRUE) {
+        hist_stats.dropped++;
+        return;
+    }
+    int i = find_series(sensor, metric);
+    if (i < 0)
+        i = new_series(sensor, metric, decimals);
+    if (i < 0) {
+        hist_stats.dropped++;
+        xSemaphoreGive(hist_mutex);
+        return;
+    }
+    HistSeries &s = series[i];
+    // Uhr zurueckgestellt: Reihenfolge im Ring bleibt erhalten
+    if (s.nblocks > 0 && t < s.last_t) {
+        hist_stats.dropped++;
+        xSemaphoreGive(hist_mutex);
+        return;
+    }
+    int32_t x = lroundf(v * pow10f_tab[s.decimals]);
+    if (raw_add(s, t, x) && persist) {
+        int id = history_metric_id(s.metric);
+        if (id >= 0)
+            histlog_append(sensor, id, s.decimals, t, x);
+    }
+    agg_add(s.aggs[HT_MINUTE], tier_len[HT_MINUTE], tier_slots[HT_MINUTE], t, x);
+    agg_add(s.aggs[HT_HOUR], tier_len[HT_HOUR], tier_slots[HT_HOUR], t, x);
+    agg_span(s, t);
+    s.samples++;
+    hist_stats.samples++;
+    xSemaphoreGive(hist_mutex);
+}
+
+/* mehrere Teilwerte derselben Stunde (Segmentgrenze, Rohwerte dieser
+ * Stunde aus dem naechsten Segment) werden zusammengefuehrt */
+void history_restore_hour(int sensor, const char *metric, uint8_t decimals, uint32_t t,
+                          int32_t min, int32_t max, int32_t avg, uint16_t count)
+{
+    if (!hist_enabled || sensor < 0 || sensor >= SENSOR_NUM || count == 0)
+        return;
+    xSemaphoreTake(hist_mutex, portMAX_DELAY);
+    int i = find_series(sensor, metric);
+    if (i < 0)
+        i = new_series(sensor, metric, decimals);
+    if (i >= 0) {
+        uint32_t start = t - t % tier_len[HT_HOUR];
+        HistAgg &a = series[i].aggs[HT_HOUR][(t / tier_len[HT_HOUR]) % tier_slots[HT_HOUR]];
+        if (a.t != start) {
+            a.t = start;
+            a.min = min;
+            a.max = max;
+            a.sum = 0;
+            a.count = 0;
+        }
+        if (min < a.min)
+            a.min = min;
+        if (max > a.max)
+            a.max = max;
+        a.sum += (int64_t)avg * count;
+        a.count = a.count + count > 0xFFFF ? 0xFFFF : a.count + count;
+        agg_span(series[i], start);
+    }
+    xSemaphoreGive(hist_mutex);
+}
+
+/* Werte aus der Zeit vor NTP, das Funkmodul startet vor dem WLAN */
+struct HistEarly {
+    uint32_t ms;
+    float v;
+    uint8_t sensor;
+    uint8_t metric;
+    uint8_t decimals;
+};
+
+static HistEarly early[HIST_EARLY_MAX];
+static uint8_t early_n;
+
+void history_add(int sensor, const char *metric, uint8_t decimals, float v)
+{
+    if (!hist_enabled)
+        return;
+    uint32_t t = (uint32_t)time(nullptr);
+    if (t < HIST_MIN_EPOCH || histlog_recovering()) {
+        int id = history_metric_id(metric);
+        if (id < 0 || early_n >= HIST_EARLY_MAX || sensor < 0 || sensor >= SENSOR_NUM) {
+            hist_stats.dropped++;
+            return;
+        }
+        early[early_n++] = { (uint32_t)millis(), v, (uint8_t)sensor, (uint8_t)id, decimals };
+        return;
+    }
+    if (early_n) {
+        uint32_t now = millis();
+        for (int i = 0; i < early_n; i++)
+            history_add_at(early[i].sensor, history_metric_name(early[i].metric), early[i].decimals,
+                           t - (now - early[i].ms) / 1000, early[i].v);
+        early_n = 0;
+    }
+    history_add_at(sensor, metric, decimals, t, v);
+}
+
+int history_find(int sensor, const char *metric)
+{
+    if (!hist_enabled || sensor < 0 || sensor >= SENSOR_NUM)
+        return -1;
+    xSemaphoreTake(hist_mutex, portMAX_DELAY);
+    int i = find_series(sensor, metric);
+    xSemaphoreGive(hist_mutex);
+    return i;
+}
+
+bool history_info(int i, HistInfo *info)
+{
+    if (i < 0 || i >= hist_stats.series)
+        return false;
+    xSemaphoreTake(hist_mutex, portMAX_DELAY);
+    HistSeries &s = series[i];
+    info->sensor = s.sensor;
+    info->decimals = s.decimals;
+    memcpy(info->metric, s.metric, HIST_METRIC_LEN);
+    info->raw_first = s.nblocks ? block_at(s, 0).t0 : 0;
+    info->raw_last = s.nblocks ? s.last_t : 0;
+    // der Stundenring reicht HIST_HOURS zurueck, aelteres ist ueberschrieben
+    uint32_t hour_oldest = s.agg_last - s.agg_last % 3600 - (HIST_HOURS - 1) * 3600UL;
+    info->first = s.agg_last > (HIST_HOURS - 1) * 3600UL && s.agg_first < hour_oldest ? hour_oldest
+                                                                                    : s.agg_first;
+    info->last = s.agg_last;
+    info->samples = s.samples;
+    xSemaphoreGive(hist_mutex);
+    return true;
+}
+
+uint32_t history_raw_retention()
+{
+    uint32_t span = HIST_RAW_SECONDS;
+    if (!hist_enabled)
+        return span;
+    xSemaphoreTake(hist_mutex, portMAX_DELAY);
+    for (int i = 0; i < hist_stats.series; i++) {
+        HistSeries &s = series[i];
+        if (s.nblocks == HIST_RAW_BLOCKS && s.last_t - block_at(s, 0).t0 < span)
+            span = s.last_t - block_at(s, 0).t0;
+    }
+    xSemaphoreGive(hist_mutex);
+    return span;
+}
+
+/* letzter Block mit t0 <= from (oder der erste) */
+static uint16_t raw_seek(HistSeries &s, uint32_t from)
+{
+    uint16_t lo = 0, hi = s.nblocks;
+    while (hi - lo > 1) {
+        uint16_t mid = (lo + hi) / 2;
+        if (block_at(s, mid).t0 <= from)
+            lo = mid;
+        else
+            hi = mid;
+    }
+    return lo;
+}
+
+static size_t read_raw(HistSeries &s, uint32_t from, uint32_t to,
+                       HistPoint *out, size_t max, uint32_t *next)
+{
+    size_t n = 0;
+    float div = pow10f_tab[s.decimals];
+    *next = to + 1;
+    for (uint16_t bi = raw_seek(s, from); bi < s.nblocks; bi++) {
+        const HistBlock &b = block_at(s, bi);
+        uint32_t t = b.t0;
+        int32_t v = b.v0;
+        uint16_t pos = 0;
+        for (uint16_t k = 0; k < b.count; k++) {
+            if (k > 0) {
+                uint32_t dt = b.data[pos++];
+                if (dt == DT_LONG) {
+                    memcpy(&dt, b.data + pos, 4);
+                    pos += 4;
+                }
+                t += dt;
+                int8_t dv = (int8_t)b.data[pos++];
+                if (dv == -128) {
+                    memcpy(&v, b.data + pos, 4);
+                    pos += 4;
+                } else {
+                    v += dv;
+                }
+            }
+            if (t < from)
+                continue;
+            if (t > to)
+                return n;
+            if (n == max) {
+                *next = t;
+                return n;
+            }
+            HistPoint &p = out[n++];
+            p.t = t;
+            p.min = p.max = p.avg = v / div;
+            p.count = 1;
+        }
+    }
+    return n;
+}
+
+static size_t read_agg(HistSeries &s, HistTier tier, uint32_t from, uint32_t to,
+                       HistPoint *out, size_t max, uint32_t *next)
+{
+    uint32_t len = tier_len[tier];
+    uint32_t slots = tier_slots[tier];
+    const HistAgg *ring = s.aggs[tier];
+    float div = pow10f_tab[s.decimals];
+    // was aelter als der Ring ist, kann nicht mehr drin sein; Minuten gibt
+    // es nur aus Rohwerten, Stunden auch aus dem Log
+    uint32_t last = tier == HT_HOUR ? s.agg_last : s.last_t;
+    uint32_t newest = last - last % len;
+    if (!last || from > newest)
+        return 0;
+    uint32_t oldest = newest > (slots - 1) * len ? newest - (slots - 1) * len : 0;
+    if (from < oldest)
+        from = oldest;
+    // nie ueber den juengsten Slot hinaus und hoechstens einmal um den Ring
+    uint32_t end = to < newest ? to : newest;
+    size_t n = 0;
+    uint32_t t = from - from % len;
+    for (uint32_t k = 0; k < slots && t <= end; k++, t += len) {
+        const HistAgg &a = ring[(t / len) % slots];
+        if (a.t != t || a.count == 0)
+            continue;
+        if (n == max) {
+            *next = t;
+            return n;
+        }
+        HistPoint &p = out[n++];
+        p.t = t;
+        p.min = a.min / div;
+        p.max = a.max / div;
+        p.avg = (float)((double)a.sum / a.count / div);
+        p.count = a.count;
+    }
+    *next = to + 1;
+    return n;
+}
+
+size_t history_read(int i, HistTier tier, uint32_t from, uint32_t to,
+                    HistPoint *out, size_t max, uint32_t *next)
+{
+    *next = to + 1;
+    if (i < 0 || i >= hist_stats.series || tier >= HT_NUM || from > to)
+        return 0;
+    xSemaphoreTake(hist_mutex, portMAX_DELAY);
+    HistSeries &s = series[i];
+    size_t n = 0;
+    if (tier == HT_RAW ? s.nblocks > 0 : s.agg_last > 0)
+        n = tier == HT_RAW ? read_raw(s, from, to, out, max, next)
+                           : read_agg(s, tier, from, to, out, max, next);
+    xSemaphoreGive(hist_mutex);
+    return n;
+}
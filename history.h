@@ -0,0 +1,133 @@
+#ifndef _HISTORY_H
+#define _HISTORY_H
+
+#include <Arduino.h>
+
+/*
+ * Verlauf je Sensor und Messwert im PSRAM, damit ein Ausfall von Broker
+ * oder Home Assistant keine Luecke hinterlaesst.
+ *
+ * Je Serie (Cache-Index + Messwert, z.B. "temp", "humi", "temp_ch2"):
+ *  - Rohwerte der letzten 24 h als Ring aus Bloecken zu 128 Byte. Ein Block
+ *    beginnt mit Zeit und Wert absolut, danach je Messung 2 Byte Delta
+ *    (Sekunden, Wert in Festkomma zu 10^decimals); Luecken ab 255 s und
+ *    grosse Spruenge kosten 4 Byte mehr. Unveraenderte Werte werden nur
+ *    alle HIST_KEEPALIVE_S abgelegt, der Verlauf bleibt so verlustfrei
+ *    (Treppenfunktion). Aendert sich ein Wert bei fast jedem Frame, ist
+ *    der Ring vor 24 h voll; history_raw_retention() meldet das.
+ *  - 1-Minuten- und 1-Stunden-Verdichtung (min/max/avg/count), beim
+ *    Einfuegen fortgeschrieben. Slot = (t / Laenge) % Ringgroesse.
+ *
+ * Speicher je Serie ist fest (HIST_SERIES_BYTES) und wird erst beim ersten
+ * Wert angelegt. Ohne PSRAM bleibt der Verlauf aus.
+ *
+ * Schreiber ist nur der Decode-Task, gelesen wird blockweise in kleinen
+ * Portionen (history_read()), die Sperre ist also immer nur kurz belegt.
+ */
+
+#define HIST_SERIES_MAX 32
+#define HIST_METRIC_LEN 16
+#define HIST_BLOCK_SIZE 128
+#define HIST_RAW_BLOCKS 96          // ~5500 Aenderungen, bei einer je 4-s-Frame ~6 h
+#define HIST_RAW_SECONDS 86400
+#define HIST_KEEPALIVE_S 240        // < 255, passt noch ins 1-Byte-Delta
+#define HIST_MINUTES (24 * 60)      // 24 h in Minuten
+#define HIST_HOURS (30 * 24)        // 30 Tage in Stunden
+
+/* Zeitstempel vor NTP sind wertlos, darunter wird nichts gespeichert */
+#define HIST_MIN_EPOCH 1600000000UL
+
+enum HistTier {
+    HT_RAW = 0,
+    HT_MINUTE,
+    HT_HOUR,
+    HT_NUM
+};
+
+struct HistAgg {
+    uint32_t t;         // Beginn des Intervalls, 0 = leer
+    int32_t min;
+    int32_t max;
+    int64_t sum;
+    uint16_t count;
+} __attribute__((packed));
+
+struct HistBlock {
+    uint32_t t0;        // erste Messung absolut
+    int32_t v0;
+    uint16_t used;      // belegte Bytes in data
+    uint16_t count;     // Messungen inkl. der ersten
+    uint8_t data[HIST_BLOCK_SIZE - 12];
+};
+
+#define HIST_SERIES_BYTES (HIST_RAW_BLOCKS * sizeof(HistBlock) + (HIST_MINUTES + HIST_HOURS) * sizeof(HistAgg))
+
+/* ein Punkt einer Abfrage, bei Rohwerten min == max == avg, count 1 */
+struct HistPoint {
+    uint32_t t;
+    float min;
+    float max;
+    float avg;
+    uint32_t count;
+};
+
+struct HistInfo {
+    uint8_t sensor;
+    uint8_t decimals;
+    char metric[HIST_METRIC_LEN];
+    uint32_t first;     // aeltester Wert in irgendeiner Stufe, 0 = keiner
+    uint32_t last;      // juengster Wert, auch nur aus Stundenwerten
+    uint32_t raw_first; // aeltester Rohwert, 0 = keiner (nur Stundenwerte)
+    uint32_t raw_last;  // letzter Rohwert, bis dahin reicht auch der Minutenring
+    uint32_t samples;   // seit dem Start eingefuegt
+};
+
+struct HistStats {
+    uint16_t series;
+    uint32_t bytes;     // im PSRAM belegt
+    uint32_t samples;
+    uint32_t stored;    // davon als Rohwert abgelegt
+    uint32_t dropped;   // Sperre belegt, kein Speicher oder keine Uhrzeit
+};
+
+extern HistStats hist_stats;
+
+void history_init();
+
+/* Messwert des Sensors (Cache-Index) zur aktuellen Uhrzeit ablegen; vor
+ * der ersten NTP-Zeit und solange histlog das Log einliest werden bis zu
+ * HIST_EARLY_MAX Werte mit millis() vorgemerkt und danach nachgetragen
+ * (aelter als der letzte Wert der Serie gingen sonst verloren).
+ * Nur Decode-Task. */
+#define HIST_EARLY_MAX 128
+void history_add(int sensor, const char *metric, uint8_t decimals, float v);
+/* persist: abgelegte Rohwerte auch ins LittleFS-Log (histlog); ohne
+ * persist (Einlesen des Logs) wird auf die Sperre gewartet */
+void history_add_at(int sensor, const char *metric, uint8_t decimals, uint32_t t, float v,
+                    bool persist = true);
+/* Stundenwert beim Einlesen des Logs (Festkomma); ist die Stunde schon
+ * belegt, wird zusammengefuehrt */
+void history_restore_hour(int sensor, const char *metric, uint8_t decimals, uint32_t t,
+                          int32_t min, int32_t max, int32_t avg, uint16_t count);
+
+/* Messwert-Namen als Nummer fuer das Log, -1 / NULL wenn unbekannt */
+int history_metric_id(const char *metric);
+const char *history_metric_name(uint8_t id);
+
+/* Serie suchen, -1 wenn es sie (noch) nicht gibt */
+int history_find(int sensor, const char *metric);
+bool history_info(int series, HistInfo *info);
+
+/* kuerzeste Rohwert-Spanne einer Serie, deren Ring voll ist, hoechstens
+ * HIST_RAW_SECONDS (dann reicht jede Serie die vollen 24 h zurueck) */
+uint32_t history_raw_retention();
+
+/* Punkte mit from <= t <= to, hoechstens max. Liefert die Anzahl; *next
+ * ist der Startzeitpunkt fuer die naechste Portion (> to: fertig).
+ * Aufwand bei Rohwerten O(log Bloecke + gelieferte Punkte), bei Minuten
+ * und Stunden hoechstens ein Durchlauf durch den Ring, egal wie weit
+ * from/to reichen. */
+size_t history_read(int series, HistTier tier, uint32_t from, uint32_t to,
+                    HistPoint *out, size_t max, uint32_t *next);
+
+#endif
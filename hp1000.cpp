@@ -1,4 +1,7 @@
 #include "hp1000.h"
+#include "asynclog.h"
+#include "frameformat.h"
+#include "metrics.h"
 
 namespace HP1000 {
 
@@ -36,7 +39,10 @@ bool TryHandleData(uint8_t *data, int len, Frame *frame) {
     if (data[0] != 0xFF) return false;
     
     // CRC Check
-    if (crc8(data, 17) != data[17]) return false;
+    if (crc8(data, 17) != data[17]) {
+        metrics.crc_errors[PROTO_HP1000]++;
+        return false;
+    }
     
     frame->ID = data[1];
     frame->channel = 1;
@@ -80,36 +86,22 @@ bool TryHandleData(uint8_t *data, int len, Frame *frame) {
     return true;
 }
 
+static const FrameField hp1000_fields[] = {
+    FRAME_FIELD(Frame, ID, " ID%02X"),
+    FRAME_FIELD(Frame, temp, " Temp%.1f°C"),
+    FRAME_FIELD(Frame, humi, " Humi%d%%"),
+    FRAME_FIELD(Frame, wind_speed, " Wind%.2fm/s"),
+    FRAME_FIELD(Frame, wind_gust, " Gust%.2fm/s"),
+    FRAME_FIELD(Frame, pressure, " Press%.1fhPa"),
+    FRAME_FIELD(Frame, rain, " Rain%.1fmm"),
+    FRAME_FIELD(Frame, uv, " UV%d"),
+    FRAME_FIELD(Frame, light_lux, " Light%.0flux"),
+    FRAME_FIELD(Frame, batlo, " batlo%d"),
+};
+static const FrameFormat hp1000_format = FRAME_FORMAT("HP1000  ", Frame, hp1000_fields);
+
 void DisplayFrame(uint8_t *data, int len, Frame *frame) {
-    Serial.println("\n--- HP1000 Weather Station ---");
-    Serial.print("ID: ");
-    Serial.println(frame->ID, HEX);
-    Serial.print("Temperature: ");
-    Serial.print(frame->temp, 1);
-    Serial.println(" °C");
-    Serial.print("Humidity: ");
-    Serial.print(frame->humi);
-    Serial.println(" %");
-    Serial.print("Wind Speed: ");
-    Serial.print(frame->wind_speed, 2);
-    Serial.println(" m/s");
-    Serial.print("Wind Gust: ");
-    Serial.print(frame->wind_gust, 2);
-    Serial.println(" m/s");
-    Serial.print("Pressure: ");
-    Serial.print(frame->pressure, 1);
-    Serial.println(" hPa");
-    Serial.print("Rain: ");
-    Serial.print(frame->rain, 1);
-    Serial.println(" mm");
-    Serial.print("UV Index: ");
-    Serial.println(frame->uv);
-    Serial.print("Light: ");
-    Serial.print(frame->light_lux, 0);
-    Serial.println(" lux");
-    Serial.print("Battery: ");
-    Serial.println(frame->batlo ? "LOW" : "OK");
-    Serial.println("----------------------------");
+    print_frame(hp1000_format, frame, data, len);
 }
 
 } // namespace HP1000
\ No newline at end of file
@@ -23,14 +23,43 @@
 * Based on: https://github.com/merbanan/rtl_433/blob/master/src/devices/lacrosse_tx35.c
 */
 #include "lacrosse.h"
+#include "asynclog.h"
+#include "frameformat.h"
+#include "metrics.h"
 #include <Arduino.h>
 
 #define LACROSSE_TX29_NOHUMIDSENSOR 0x6A
 #define LACROSSE_TX25_PROBE_FLAG    0x7D
 
+/*
+ * CRC8 (Polynom 0x31, Start 0) ueber 4 Datenbytes: das Syndrom
+ * CRC(Daten) ^ CRC-Byte ist fuer jeden der 40 moeglichen Einzelbitfehler
+ * verschieden. Tabelle Syndrom -> Bitnummer (0 = MSB von Byte 0,
+ * 32..39 = CRC-Byte), 0xFF = kein Einzelbitfehler.
+ */
+static const uint8_t crc_syndrome[256] = {
+    0xFF, 0x27, 0x26, 0xFF, 0x25, 0xFF, 0xFF, 0x06, 0x24, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x05, 0xFF,
+    0x23, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x04, 0xFF, 0xFF, 0xFF,
+    0x22, 0xFF, 0xFF, 0x10, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x0D, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x1F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x14, 0x03, 0xFF, 0xFF, 0xFF, 0xFF, 0x19, 0xFF, 0xFF,
+    0x21, 0xFF, 0xFF, 0x1B, 0xFF, 0xFF, 0x0F, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0x0C, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0x1E, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x13, 0xFF,
+    0x02, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x0A, 0x18, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0x20, 0xFF, 0xFF, 0x15, 0xFF, 0xFF, 0x1A, 0xFF, 0xFF, 0x11, 0xFF, 0xFF, 0x0E, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x07, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0x0B, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x1C, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0x1D, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0x08, 0xFF, 0xFF, 0xFF, 0x16, 0xFF, 0xFF, 0x12, 0xFF, 0xFF, 0xFF,
+    0x01, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+    0xFF, 0x00, 0x09, 0xFF, 0x17, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF, 0xFF,
+};
+
 void LaCrosse::DecodeFrame(byte *bytes, struct Frame *f)
 {
     f->valid = true;
+    f->corrected = false;
     if (bytes[4] != CalculateCRC(bytes, FRAME_LENGTH - 1))
         f->valid = false;
     if ((bytes[0] & 0xF0) != 0x90)
@@ -70,72 +99,121 @@ void LaCrosse::DecodeFrame(byte *bytes, struct Frame *f)
     }
 }
 
+void LaCrosse::TX141Reset(TX141Lock *lock)
+{
+    memset(lock, 0, sizeof(*lock));
+    memset(lock->format, TX141_UNLOCKED, sizeof(lock->format));
+}
+
+/* eine der vier bekannten Temperaturkodierungen, NAN fuer unbekannte */
+float LaCrosse::TX141Temperature(const byte *bytes, uint8_t format)
+{
+    switch (format) {
+    case 0:     // A: 12 bit, T = X/10 - 50
+        return ((((bytes[1] & 0x0F) << 8) | bytes[2]) - 500) / 10.0f;
+    case 1:     // B: 12 bit, um ein Nibble verschoben
+        return (((bytes[2] << 4) | (bytes[3] >> 4)) - 500) / 10.0f;
+    case 2:     // C: 16 bit, T = X/10 - 40
+        return (int16_t)((bytes[2] << 8) | bytes[3]) / 10.0f - 40.0f;
+    case 3:     // D: BCD
+        return (((bytes[2] >> 4) & 0x0F) * 10 + (bytes[2] & 0x0F) +
+                ((bytes[3] >> 4) & 0x0F) / 10.0f) - 40.0f;
+    }
+    return NAN;
+}
+
+static bool tx141_in_range(float t)
+{
+    return t >= -40 && t <= 60;
+}
+
+/* Kandidaten eines Frames einlernen; eine Kodierung rastet ein, wenn sie
+ * TX141_LOCK_FRAMES mal in Folge im Bereich liegt und nicht mehr als 2 °C
+ * springt. Bei mehreren gewinnt die niedrigste (Reihenfolge wie bisher). */
+static uint8_t tx141_learn(LaCrosse::TX141Lock *lock, byte ID, const byte *bytes)
+{
+    for (uint8_t k = 0; k < TX141_FORMATS; k++) {
+        float t = LaCrosse::TX141Temperature(bytes, k);
+        uint8_t &hits = lock->hits[ID][k];
+        if (!tx141_in_range(t))
+            hits = 0;
+        else if (hits > 0 && fabsf(t - lock->last[ID][k]) <= 2.0f)
+            hits++;
+        else
+            hits = 1;
+        lock->last[ID][k] = t;
+    }
+    for (uint8_t k = 0; k < TX141_FORMATS; k++) {
+        if (lock->hits[ID][k] >= TX141_LOCK_FRAMES) {
+            lock->format[ID] = k;
+            LOGI("TX141 ID %d: Temperaturkodierung %c eingerastet", ID, 'A' + k);
+            return k;
+        }
+    }
+    return TX141_UNLOCKED;
+}
+
 // TX141/TX145 Protokoll Dekodierung
-bool LaCrosse::DecodeTX141Frame(byte *bytes, struct Frame *f)
+bool LaCrosse::DecodeTX141Frame(byte *bytes, struct Frame *f, TX141Lock *lock)
 {
+    int8_t rssi = f->rssi;
+    uint16_t rate = f->rate;
     memset(f, 0, sizeof(*f));
-    
-    // Einfache XOR-Checksum prüfen
+    f->rssi = rssi;
+    f->rate = rate;
+
+    if (!lock)
+        return false;
+
+    // XOR-Checksumme muss exakt passen
     byte crc_calc = 0;
     for (int i = 0; i < 4; i++) {
         crc_calc ^= bytes[i];
     }
-    
-    // CRC muss passen (toleranz ±1 wegen möglicher Bitfehler)
-    if (abs((int)crc_calc - (int)bytes[4]) > 1) {
-        Serial.printf(" [CRC fail: calc=%02X got=%02X]", crc_calc, bytes[4]);
+    if (crc_calc != bytes[4])
         return false;
-    }
     
-    // ID extrahieren
     f->ID = (bytes[0] >> 2) & 0x3F;
-    
-    if (f->ID > 63) {
-        f->ID = bytes[1] & 0x3F;
-    }
-    
     f->channel = 1;
-    
-    // Temperatur-Dekodierung (mehrere Formate probieren)
-    int16_t temp_raw_a = ((bytes[1] & 0x0F) << 8) | bytes[2];
-    float temp_a = (temp_raw_a - 500) / 10.0f;
-    
-    int16_t temp_raw_b = ((bytes[2] << 4) | (bytes[3] >> 4));
-    float temp_b = (temp_raw_b - 500) / 10.0f;
-    
-    int16_t temp_raw_c = (bytes[2] << 8) | bytes[3];
-    float temp_c = temp_raw_c / 10.0f - 40.0f;
-    
-    int bcd1 = (bytes[2] >> 4) & 0x0F;
-    int bcd2 = bytes[2] & 0x0F;
-    int bcd3 = (bytes[3] >> 4) & 0x0F;
-    float temp_d = (bcd1 * 10 + bcd2 + bcd3 / 10.0f) - 40.0f;
-    
-    float chosen_temp = 999.9f;
-    
-    if (temp_a >= -40 && temp_a <= 60) chosen_temp = temp_a;
-    else if (temp_b >= -40 && temp_b <= 60) chosen_temp = temp_b;
-    else if (temp_c >= -40 && temp_c <= 60) chosen_temp = temp_c;
-    else if (temp_d >= -40 && temp_d <= 60) chosen_temp = temp_d;
-    
-    if (chosen_temp == 999.9f) {
-        Serial.print(" [No valid temp]");
+
+    uint8_t format = lock->format[f->ID];
+    if (format == TX141_UNLOCKED) {
+        format = tx141_learn(lock, f->ID, bytes);
+        if (format == TX141_UNLOCKED)
+            return false;
+    }
+
+    // eingerastet: nur noch diese Kodierung
+    f->temp = TX141Temperature(bytes, format);
+    if (!tx141_in_range(f->temp)) {
+        metrics.tx141_rejected++;
+        if (++lock->misses[f->ID] >= TX141_RELEARN_FRAMES) {
+            lock->format[f->ID] = TX141_UNLOCKED;
+            lock->misses[f->ID] = 0;
+            memset(lock->hits[f->ID], 0, sizeof(lock->hits[f->ID]));
+            metrics.tx141_relearned++;
+            LOGW("TX141 ID %d: Kodierung %c passt nicht mehr, lerne neu", f->ID, 'A' + format);
+        }
         return false;
     }
-    
-    f->temp = chosen_temp;
+    lock->misses[f->ID] = 0;
+
     f->batlo = (bytes[3] & 0x08) ? 1 : 0;
     f->init = (bytes[0] & 0x80) ? 1 : 0;
     f->humi = -1;
     f->valid = true;
-    
-    Serial.printf(" [TX141: A=%.1f B=%.1f C=%.1f D=%.1f -> %.1f]", 
-                  temp_a, temp_b, temp_c, temp_d, chosen_temp);
-    
     return true;
 }
 
-const char* LaCrosse::GetSensorType(struct Frame *f)
+enum LaCrosseType {
+    LT_TX29DTH, LT_TX29, LT_TX25U, LT_TX27, LT_TX35DTH, LT_TX35, LT_WD3155, LT_TX38, LT_OTHER, LT_NUM
+};
+
+static const char *const type_names[LT_NUM] = {
+    "TX29DTH-IT", "TX29-IT", "TX25-U", "TX27-IT", "TX35DTH-IT", "TX35-IT", "30.3155WD", "TX38-IT", "LaCrosse"
+};
+
+static LaCrosseType sensor_type(const LaCrosse::Frame *f)
 {
     byte humi_raw = f->humi;
     
@@ -151,69 +229,99 @@ const char* LaCrosse::GetSensorType(struct Frame *f)
     
     if (f->rate == 17241) {
         if (f->humi > 0 && f->humi <= 100) {
-            return "TX29DTH-IT";
+            return LT_TX29DTH;
         } else if (humi_raw == 0x6A) {
-            return "TX29-IT";       // Nur Temp, kein Humidity
+            return LT_TX29;         // Nur Temp, kein Humidity
         } else if (humi_raw == 0x7D) {
-            return "TX25-U";        // Probe Sensor (Channel 2)
+            return LT_TX25U;        // Probe Sensor (Channel 2)
         } else {
-            return "TX27-IT";
+            return LT_TX27;
         }
     } else if (f->rate == 9579) {
         if (f->humi > 0 && f->humi <= 100) {
-            return "TX35DTH-IT";
+            return LT_TX35DTH;
         } else if (humi_raw == 0x6A) {
-            return "TX35-IT";
+            return LT_TX35;
         } else {
-            return "30.3155WD";
+            return LT_WD3155;
         }
     } else if (f->rate == 8842) {
-        return "TX38-IT";
+        return LT_TX38;
     }
     
-    return "LaCrosse";
+    return LT_OTHER;
+}
+
+const char* LaCrosse::GetSensorType(struct Frame *f)
+{
+    return type_names[sensor_type(f)];
 }
 
+StrId LaCrosse::GetSensorTypeId(struct Frame *f)
+{
+    // je Typ einmal eintragen statt bei jedem Frame zu hashen
+    static StrId ids[LT_NUM];
+    LaCrosseType t = sensor_type(f);
+    if (ids[t] == STR_NONE)
+        ids[t] = str_intern(type_names[t]);
+    return ids[t];
+}
+
+static const char *lacrosse_type(const void *f)
+{
+    return LaCrosse::GetSensorType((LaCrosse::Frame *)f);
+}
+
+static const FrameField lacrosse_fields[] = {
+    FRAME_FIELD(LaCrosse::Frame, ID, " ID%-3d"),
+    FRAME_FIELD(LaCrosse::Frame, channel, " Ch%d"),
+    FRAME_FIELD(LaCrosse::Frame, temp, " Temp%-5.1f°C"),
+    FRAME_FIELD(LaCrosse::Frame, init, " init%d"),
+    FRAME_FIELD(LaCrosse::Frame, batlo, " batlo%d"),
+    FRAME_FIELD_IF(LaCrosse::Frame, humi, " Humi%d%%", FF_HUMI),
+    FRAME_TEXT(" (%s)", lacrosse_type),
+};
+static const FrameFormat lacrosse_format = FRAME_FORMAT("Sensor ", LaCrosse::Frame, lacrosse_fields);
+
 bool LaCrosse::DisplayFrame(byte *data, struct Frame *f)
 {
-    static unsigned long last[SENSOR_NUM];
     if (!f->valid) {
-        Serial.println("LaCrosse::DisplayFrame FRAME INVALID");
+        LOGW("LaCrosse::DisplayFrame FRAME INVALID");
         return false;
     }
+    return print_frame(lacrosse_format, f, data, FRAME_LENGTH);
+}
 
-    int displayID = f->ID;
-
-    DisplayRaw(last[f->ID], "Sensor ", data, FRAME_LENGTH, f->rssi, f->rate);
-    
-    Serial.printf(" ID%-3d Ch%d", displayID, f->channel);
-    Serial.printf(" Temp%-5.1f°C", f->temp);
-    Serial.printf(" init%d batlo%d", f->init, f->batlo);
-    
-    const char* sensor_type = GetSensorType(f);
-    
-    if (f->humi > 0 && f->humi <= 100) {
-        Serial.printf(" Humi%d%% (%s)", f->humi, sensor_type);
-    } else {
-        Serial.printf(" (%s)", sensor_type);
-    }
-    
-    Serial.println();
-    
+/* korrigierte Kopie nach out, false wenn der Fehler kein Einzelbitfehler ist */
+bool LaCrosse::CorrectFrame(const byte *data, byte *out)
+{
+    byte syndrome = CalculateCRC((byte *)data, FRAME_LENGTH - 1) ^ data[4];
+    byte bit = crc_syndrome[syndrome];
+    if (bit == 0xFF)
+        return false;
+    memcpy(out, data, FRAME_LENGTH);
+    out[bit >> 3] ^= 0x80 >> (bit & 7);
     return true;
 }
 
-bool LaCrosse::TryHandleData(byte *data, struct Frame *f)
+bool LaCrosse::TryHandleData(byte *data, struct Frame *f, bool fec, TX141Lock *lock)
 {
     // Zuerst: Standard 0x9X Protokoll (LaCrosse IT+)
     if ((data[0] & 0xF0) == 0x90) {
         DecodeFrame(data, f);
+        byte fixed[FRAME_LENGTH];
+        if (!f->valid && fec && CorrectFrame(data, fixed)) {
+            DecodeFrame(fixed, f);
+            f->corrected = f->valid;
+        }
+        if (!f->valid)
+            metrics.crc_errors[PROTO_LACROSSE]++;
         return f->valid;
     }
     
     // TX141/TX145 oder andere alternative Protokolle (NICHT 0x9X)
     // Diese werden als TX141 behandelt
-    return DecodeTX141Frame(data, f);
+    return DecodeTX141Frame(data, f, lock);
 }
 
 byte LaCrosse::UpdateCRC(byte res, uint8_t val)
@@ -237,16 +345,4 @@ byte LaCrosse::CalculateCRC(byte *data, byte len)
         res = UpdateCRC(res, val);
     }
     return res;
-}
-
-void LaCrosse::DisplayRaw(unsigned long &last, const char *dev, uint8_t *data, uint8_t len, int8_t rssi, int rate)
-{
-    unsigned long now = millis();
-    if (last == 0)
-        last = now;
-    Serial.printf("%6ld %s [", (now - last), dev);
-    last = now;
-    for (uint8_t i = 0; i < len; i++)
-        Serial.printf("%02X%s", data[i],(i==len-1)?"":" ");
-    Serial.printf("] rssi%-4d rate%-5d", rssi, rate);
 }
\ No newline at end of file
@@ -6,6 +6,12 @@
 
 namespace LaCrosse {
 
+    #define TX141_FORMATS 4         // Temperaturkodierungen A..D
+    #define TX141_LOCK_FRAMES 3     // so viele passende Frames in Folge -> eingerastet
+    #define TX141_RELEARN_FRAMES 5  // so viele Frames in Folge ausserhalb -> neu lernen
+    #define TX141_UNLOCKED 0xFF
+    #define TX141_IDS 64
+
     struct Frame {
         byte ID;
         byte channel;
@@ -14,20 +20,39 @@ namespace LaCrosse {
         bool batlo;
         bool init;
         bool valid;
+        bool corrected;     // ein Bitfehler per CRC-Syndrom korrigiert
         int8_t rssi;
         uint16_t rate;
     };
 
+    /* Lernzustand der TX141-Temperaturkodierung je Sensor-ID, gehoert dem
+     * Aufrufer. Bis eine Kodierung eingerastet ist, werden keine Frames
+     * dieses Sensors angenommen. Passt die eingerastete Kodierung
+     * TX141_RELEARN_FRAMES mal in Folge nicht (anderer Sensor auf der ID,
+     * falsch gelernt), wird neu gelernt. */
+    struct TX141Lock {
+        uint8_t format[TX141_IDS];                  // Kodierung oder TX141_UNLOCKED
+        uint8_t misses[TX141_IDS];                  // eingerastet, aber ausserhalb, in Folge
+        uint8_t hits[TX141_IDS][TX141_FORMATS];     // passende Frames in Folge
+        float last[TX141_IDS][TX141_FORMATS];
+    };
+    void TX141Reset(TX141Lock *lock);
+    float TX141Temperature(const byte *bytes, uint8_t format);
+
     void DecodeFrame(byte *data, struct Frame *f);
-    bool DecodeTX141Frame(byte *bytes, struct Frame *f);
-    bool TryHandleData(byte *data, struct Frame *f);
+    bool DecodeTX141Frame(byte *bytes, struct Frame *f, TX141Lock *lock);
+    /* fec: Einzelbitfehler korrigieren statt den Frame zu verwerfen,
+     * lock: ohne Lernzustand werden TX141-Frames nicht dekodiert */
+    bool TryHandleData(byte *data, struct Frame *f, bool fec = false, TX141Lock *lock = NULL);
+    bool CorrectFrame(const byte *data, byte *out);
     bool DisplayFrame(byte *data, struct Frame *f);
-    void DisplayRaw(unsigned long &last, const char *dev, uint8_t *data, uint8_t len, int8_t rssi, int rate);
     
     byte UpdateCRC(byte res, uint8_t val);
     byte CalculateCRC(byte *data, byte len);
     
     const char* GetSensorType(struct Frame *f);
+    /* dasselbe als strtab-Handle, ohne str_intern() je Frame */
+    StrId GetSensorTypeId(struct Frame *f);
 }
 
 #endif
\ No newline at end of file
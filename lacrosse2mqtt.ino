@@ -36,6 +36,18 @@
 #include "wh25.h"
 #include "hp1000.h"
 #include "wh65b.h"
+#include "decoder.h"
+#include "sensorstore.h"
+#include "history.h"
+#include "histlog.h"
+#include "snapshot.h"
+#include "heapmon.h"
+#include "oled.h"
+#include "metrics.h"
+#include "pipeline.h"
+#include "perfstats.h"
+#include "asynclog.h"
+#include "frameformat.h"
 #include <WiFiManager.h>
 #include <time.h>
 
@@ -58,28 +70,61 @@ unsigned long last_reconnect;
 unsigned long last_switch = 0;
 bool littlefs_ok;
 bool mqtt_ok;
+BootTimes boot_times;
 uint32_t auto_display_on = 0;
 
 static wl_status_t last_wifi_status = WL_IDLE_STATUS;
 
-unsigned long loop_count = 0;
 unsigned long last_cpu_check = 0;
 float cpu_usage = 0.0;
 
 Config config;
 Cache fcache[SENSOR_NUM];
-String id2name[SENSOR_NUM];
+uint32_t sensor_seq = 0;
+uint32_t boot_epoch = 0;
+uint8_t seq_log[SEQ_LOG_SIZE];
+volatile uint32_t cache_gen = 0;
+StrId id2name[SENSOR_NUM];
 uint8_t hass_cfg[SENSOR_NUM];
+static uint32_t hass_gen;
+
+/* Discovery neu senden (nach jedem (Re-)Connect): der Netzwerk-Task zaehlt
+ * nur hass_gen hoch, hass_cfg schreibt allein der Decode-Task in hass_sync() */
+static void hass_reset() {
+    __atomic_fetch_add(&hass_gen, 1, __ATOMIC_RELAXED);
+}
+
+static void hass_sync() {
+    static uint32_t seen_gen;
+    uint32_t gen = __atomic_load_n(&hass_gen, __ATOMIC_RELAXED);
+    if (gen != seen_gen) {
+        seen_gen = gen;
+        memset(hass_cfg, 0, sizeof(hass_cfg));
+    }
+}
+
+static SemaphoreHandle_t state_mutex;
+
+void state_lock() {
+    xSemaphoreTake(state_mutex, portMAX_DELAY);
+}
+
+void state_unlock() {
+    xSemaphoreGive(state_mutex);
+}
 
 #define SCREEN_WIDTH 128
 #define SCREEN_HEIGHT 64
 Adafruit_SSD1306 display(SCREEN_WIDTH, SCREEN_HEIGHT, &Wire, OLED_RST);
 
 #define STAR_COUNT 50
+#define STAR_DEPTH 64
 struct Star {
-    float x, y, z;
+    int8_t x, y;        // -64..63 / -32..31
+    uint8_t z;          // 1..STAR_DEPTH
 };
 Star stars[STAR_COUNT];
+static uint16_t star_recip[STAR_DEPTH + 1];   // 32768 / z, Projektion ohne float
 
 SX127x SX(LORA_CS, LORA_RST);
 
@@ -94,16 +139,19 @@ unsigned long last_toggle_time = 0;
 
 String wifi_disp;
 bool showing_starfield = false;
+bool showing_splash = false;
+#define SPLASH_MS 3000
+static volatile bool display_wake = false;   // Taster, aus loop()
 
 unsigned long last_display_update = 0;
 #define DISPLAY_UPDATE_INTERVAL 30
 
 void display_set_on() {
-    display.ssd1306_command(SSD1306_DISPLAYON);
+    oled_power(display, true);
 }
 
 void display_set_off() {
-    display.ssd1306_command(SSD1306_DISPLAYOFF);
+    oled_power(display, false);
 }
 
 void reset_display_timeout() {
@@ -111,41 +159,39 @@ void reset_display_timeout() {
 }
 
 void init_starfield() {
+    for (int z = 1; z <= STAR_DEPTH; z++)
+        star_recip[z] = 32768 / z;
     for (int i = 0; i < STAR_COUNT; i++) {
         stars[i].x = random(-64, 64);
         stars[i].y = random(-32, 32);
-        stars[i].z = random(1, 64);
+        stars[i].z = random(1, STAR_DEPTH);
     }
 }
 
 void draw_starfield() {
+    PerfTimer t(PERF_DISPLAY);
     display.clearDisplay();
     
     for (int i = 0; i < STAR_COUNT; i++) {
-        stars[i].z -= 1.0;
-        
-        if (stars[i].z <= 0) {
-            stars[i].x = random(-64, 64);
-            stars[i].y = random(-32, 32);
-            stars[i].z = 64;
+        Star &s = stars[i];
+        if (--s.z == 0) {
+            s.x = random(-64, 64);
+            s.y = random(-32, 32);
+            s.z = STAR_DEPTH;
         }
         
-        int sx = (int)(64 + (stars[i].x / stars[i].z) * 64);
-        int sy = (int)(32 + (stars[i].y / stars[i].z) * 32);
+        // x * 64 / z und y * 32 / z ueber den Kehrwert (Q15)
+        int32_t r = star_recip[s.z];
+        int sx = 64 + ((s.x * r) >> 9);
+        int sy = 32 + ((s.y * r) >> 10);
         
         if (sx >= 0 && sx < 128 && sy >= 0 && sy < 64) {
-            int size = (int)(3 - stars[i].z / 21);
+            int size = 3 - s.z / 21;
             if (size < 1) size = 1;
-            for (int dx = 0; dx < size; dx++) {
-                for (int dy = 0; dy < size; dy++) {
-                    if (sx + dx < 128 && sy + dy < 64) {
-                        display.drawPixel(sx + dx, sy + dy, SSD1306_WHITE);
-                    }
-                }
-            }
+            display.fillRect(sx, sy, size, size, SSD1306_WHITE);   // schneidet am Rand ab
         }
     }    
-    display.display();
+    oled_flush(display);
 }
 
 WiFiClient client;
@@ -155,6 +201,102 @@ const String pretty_base = "lacrosse/climate/";
 const String pub_base = "lacrosse/id/";
 const String hass_base = "homeassistant/sensor/";
 bool mqtt_server_set = false;
+String mqtt_server, mqtt_user, mqtt_pass;
+
+static QueueHandle_t publish_queue;
+/* Speicher der Queue-Eintraege: ein fester Ring statt malloc() je Nachricht,
+ * damit ein Broker-Ausfall den Heap nicht zerstueckelt. Reservieren und
+ * Einstellen unter publish_mutex, also liegt der Ring in Queue-Reihenfolge
+ * und der Netzwerk-Task gibt nur vorne frei (publish_tail). */
+static uint64_t publish_ring[PUBLISH_RING_BYTES / 8];
+static uint32_t publish_head;       // nur unter publish_mutex
+static uint32_t publish_tail;       // nur der Netzwerk-Task schreibt
+static SemaphoreHandle_t publish_mutex;
+/* Empfangszeitpunkt des Frames, den der Decode-Task gerade bearbeitet */
+static int64_t decode_rx_us;
+
+/* Frame-Verarbeitung und HA-Discovery publizieren nicht selbst, sondern
+ * stellen in die Queue; gesendet wird nur im Netzwerk-Task. Ist die Queue
+ * voll (Broker weg), wird verworfen statt den Empfang aufzuhalten.
+ * rx_us: Empfangszeit des ausloesenden Frames (decode_rx_us) fuer den
+ * Latenz-Trace, 0 fuer alles andere (Log, Debug-Zeilen) */
+/* Platz fuer need Byte am Stueck, sonst -1; ein Rest am Ende bleibt frei
+ * und wird mit der ersten Nachricht am Anfang zusammen freigegeben */
+static int publish_reserve(uint32_t need)
+{
+    uint32_t head = publish_head;
+    uint32_t tail = __atomic_load_n(&publish_tail, __ATOMIC_ACQUIRE);
+    // head == tail heisst leer, der Ring wird daher nie ganz voll
+    if (head >= tail) {
+        if (need <= PUBLISH_RING_BYTES - head - (tail == 0))
+            return head;
+        return need < tail ? 0 : -1;
+    }
+    return need < tail - head ? head : -1;
+}
+
+bool mqtt_publish(const char *topic, const char *payload, bool retain, int64_t rx_us)
+{
+    size_t tlen = strlen(topic) + 1;
+    size_t plen = strlen(payload) + 1;
+    uint32_t need = (sizeof(MqttMsg) + tlen + plen + 7) & ~7u;
+    bool ok = false;
+    xSemaphoreTake(publish_mutex, portMAX_DELAY);
+    int at = publish_reserve(need);
+    if (at >= 0) {
+        MqttMsg *msg = (MqttMsg *)((uint8_t *)publish_ring + at);
+        uint32_t end = (at + need) % PUBLISH_RING_BYTES;
+        msg->rx_us = rx_us;
+        msg->end = end;
+        msg->retain = retain;
+        memcpy(msg->topic, topic, tlen);
+        msg->payload = msg->topic + tlen;
+        memcpy(msg->payload, payload, plen);
+        ok = xQueueSend(publish_queue, &msg, 0) == pdTRUE;
+        if (ok)
+            publish_head = end;
+    }
+    xSemaphoreGive(publish_mutex);
+    if (!ok) {
+        metrics.queues[MQ_PUBLISH].dropped++;
+        return false;
+    }
+    metrics_queue_depth(MQ_PUBLISH, uxQueueMessagesWaiting(publish_queue));
+    if (rx_us)
+        trace_mark(TRACE_ENQUEUED);
+    return true;
+}
+
+/* Warnungen und Fehler aus asynclog zusaetzlich als MQTT-Tail */
+static void log_to_mqtt(LogLevel level, const char *text)
+{
+    if (mqtt_ok)
+        mqtt_publish((pub_base + "log").c_str(), text, false, 0);
+}
+
+/* im Debug-Modus jede Frame-Zeile (frameformat) auch per MQTT */
+static void frame_to_mqtt(const char *line)
+{
+    if (config.debug_mode && mqtt_ok)
+        mqtt_publish((pub_base + "raw").c_str(), line, false, 0);
+}
+
+/* direkt senden, nur aus dem Netzwerk-Task. beginPublish statt publish(),
+ * sonst scheitern Payloads > MQTT_MAX_PACKET_SIZE */
+static bool mqtt_send(const char *topic, const char *payload, bool retain)
+{
+    size_t len = strlen(payload);
+    bool ok = mqtt_client.beginPublish(topic, len, retain);
+    if (ok)
+        ok = mqtt_client.write((const uint8_t *)payload, len) == len;
+    if (ok)
+        ok = mqtt_client.endPublish();
+    if (ok)
+        metrics.mqtt_published++;
+    else
+        metrics.mqtt_failed++;
+    return ok;
+}
 
 void setup_mqtt_with_will()
 {
@@ -163,52 +305,28 @@ void setup_mqtt_with_will()
     if (mqtt_server_set) {
         const char *user = NULL;
         const char *pass = NULL;
-        if (config.mqtt_user.length()) {
-            user = config.mqtt_user.c_str();
-            pass = config.mqtt_pass.c_str();
+        if (mqtt_user.length()) {
+            user = mqtt_user.c_str();
+            pass = mqtt_pass.c_str();
         }
         
         if (mqtt_client.connect(mqtt_id.c_str(), user, pass, 
                                 statusTopic.c_str(), 0, true, "offline")) {
-            Serial.println("MQTT Connected with LWT");
-            mqtt_client.publish(statusTopic.c_str(), "online", true);
+            LogInfo.println("MQTT Connected with LWT");
+            metrics.mqtt_reconnects++;
+            mqtt_send(statusTopic.c_str(), "online", true);
             
-            for (int i = 0; i < SENSOR_NUM; i++)
-                hass_cfg[i] = 0;
+            hass_reset();
         }
     }
 }
 
 void setup_ntp() {
-    Serial.println("Configuring NTP time synchronization...");
+    LogInfo.println("Configuring NTP time synchronization...");
     
     // Konfiguriere NTP mit zwei Servern für Redundanz
     configTime(GMT_OFFSET_SEC, DAYLIGHT_OFFSET_SEC, NTP_SERVER1, NTP_SERVER2);
-    
-    // Warte bis Zeit synchronisiert ist (max 10 Sekunden)
-    int retry = 0;
-    const int max_retry = 20;
-    
-    struct tm timeinfo;
-    while (!getLocalTime(&timeinfo) && retry < max_retry) {
-        Serial.print(".");
-        delay(500);
-        retry++;
-    }
-    
-    if (retry < max_retry) {
-        ntp_synced = true;
-        Serial.println("\nNTP time synchronized successfully!");
-        Serial.print("Current time: ");
-        Serial.println(&timeinfo, "%A, %B %d %Y %H:%M:%S");
-        
-        // Zeige auch Unix-Timestamp
-        time_t now = time(nullptr);
-        Serial.printf("Unix timestamp: %lld\n", now);
-    } else {
-        Serial.println("\nWARNING: NTP synchronization failed!");
-        Serial.println("Certificate validation may not work correctly.");
-    }
+    // nicht warten: check_ntp_sync() meldet die erste Synchronisation
 }
 
 String get_current_time_string() {
@@ -225,59 +343,66 @@ String get_current_time_string() {
 void check_ntp_sync() {
     unsigned long now = millis();
     
-    // Prüfe NTP-Status alle 60 Sekunden
-    if (now - last_ntp_check > 60000) {
+    // Prüfe NTP-Status alle 60 Sekunden, bis zur ersten Synchronisation jede Sekunde
+    if (now - last_ntp_check > (boot_times.ntp ? 60000 : 1000)) {
         last_ntp_check = now;
         
         struct tm timeinfo;
-        bool currently_synced = getLocalTime(&timeinfo);
+        bool currently_synced = getLocalTime(&timeinfo, 0);
         
         if (currently_synced != ntp_synced) {
             ntp_synced = currently_synced;
-            if (ntp_synced) {
-                Serial.println("NTP sync restored!");
+            if (ntp_synced && !boot_times.ntp) {
+                boot_times.ntp = now;
+                LogInfo.println("NTP time synchronized successfully!");
+                LogInfo.print("Current time: ");
+                LogInfo.println(&timeinfo, "%A, %B %d %Y %H:%M:%S");
+            } else if (ntp_synced) {
+                LogInfo.println("NTP sync restored!");
             } else {
-                Serial.println("WARNING: NTP sync lost!");
+                LogWarn.println("WARNING: NTP sync lost!");
             }
         }
         
         // Re-sync alle 24 Stunden
         static unsigned long last_full_sync = 0;
         if (now - last_full_sync > 86400000) {
-            Serial.println("Performing daily NTP re-sync...");
+            LogInfo.println("Performing daily NTP re-sync...");
             configTime(GMT_OFFSET_SEC, DAYLIGHT_OFFSET_SEC, NTP_SERVER1, NTP_SERVER2);
             last_full_sync = now;
         }
     }
 }
 
-void check_repeatedjobs()
+void check_mqtt()
 {
     unsigned long now = millis();
-    if (now - last_switch > config.toggle_interval_ms) {
-        SX.NextDataRate();
-        last_switch = now;
-    }
     if (config.changed) {
-        Serial.println("MQTT config changed. Dis- and reconnecting...");
+        LogInfo.println("MQTT config changed. Dis- and reconnecting...");
+        state_lock();
         config.changed = false;
+        // eigene Kopien: setServer() merkt sich nur den Zeiger, und der
+        // Webserver darf config.mqtt_* jederzeit neu zuweisen
+        mqtt_server = config.mqtt_server;
+        mqtt_user = config.mqtt_user;
+        mqtt_pass = config.mqtt_pass;
+        int mqtt_port = config.mqtt_port;
+        state_unlock();
         if (mqtt_ok) {
             String statusTopic = pub_base + "status";
-            mqtt_client.publish(statusTopic.c_str(), "offline", true);
+            mqtt_send(statusTopic.c_str(), "offline", true);
             mqtt_client.disconnect();
         }
-        if (config.mqtt_server.length() > 0) {
-            const char *_server = config.mqtt_server.c_str();
-            mqtt_client.setServer(_server, config.mqtt_port);
+        if (mqtt_server.length() > 0) {
+            mqtt_client.setServer(mqtt_server.c_str(), mqtt_port);
             mqtt_server_set = true;
         } else
-            Serial.println("MQTT server name not configured");
+            LogInfo.println("MQTT server name not configured");
         mqtt_client.setKeepAlive(60);
-        Serial.print("MQTT SERVER: "); Serial.println(config.mqtt_server);
-        Serial.print("MQTT PORT:   "); Serial.println(config.mqtt_port);
+        LogInfo.print("MQTT SERVER: "); LogInfo.println(mqtt_server);
+        LogInfo.print("MQTT PORT:   "); LogInfo.println(mqtt_port);
         
-        for (int i = 0; i < SENSOR_NUM; i++)
-            hass_cfg[i] = 0;
+        hass_reset();
         
         last_reconnect = 0;
     }
@@ -285,25 +410,27 @@ void check_repeatedjobs()
         if (mqtt_server_set) {
             const char *user = NULL;
             const char *pass = NULL;
-            if (config.mqtt_user.length()) {
-                user = config.mqtt_user.c_str();
-                pass = config.mqtt_pass.c_str();
+            if (mqtt_user.length()) {
+                user = mqtt_user.c_str();
+                pass = mqtt_pass.c_str();
             }
-            Serial.print("MQTT RECONNECT...");
+            LogInfo.print("MQTT RECONNECT...");
             
             String statusTopic = pub_base + "status";
             
             if (mqtt_client.connect(mqtt_id.c_str(), user, pass, 
                                    statusTopic.c_str(), 0, true, "offline")) {
-                Serial.println("OK!");
+                LogInfo.println("OK!");
+                metrics.mqtt_reconnects++;
+                if (!boot_times.mqtt)
+                    boot_times.mqtt = millis();
                 
-                mqtt_client.publish(statusTopic.c_str(), "online", true);
-                Serial.println("Published status: online");
+                mqtt_send(statusTopic.c_str(), "online", true);
+                LogInfo.println("Published status: online");
                 
-                for (int i = 0; i < SENSOR_NUM; i++)
-                    hass_cfg[i] = 0;
+                hass_reset();
             } else
-                Serial.println("FAILED");
+                LogWarn.println("FAILED");
         }
         last_reconnect = now;
     }
@@ -352,15 +479,15 @@ void pub_hass_weather_config(int what, byte ID)
         return;
     hass_cfg[ID] |= configMask;
     
-    String sensorName = id2name[ID].length() > 0 ? id2name[ID] : ("Weather_" + String(ID));
+    String sensorName = has_sensor_name(ID) ? String(sensor_name(ID)) : ("Weather_" + String(ID));
     
     String deviceId;
     String uniqueId;
     String configTopic;
     String stateTopic;
     
-    if (config.mqtt_use_names && id2name[ID].length() > 0) {
-        String sensorIdentifier = id2name[ID];
+    if (config.mqtt_use_names && has_sensor_name(ID)) {
+        const char *sensorIdentifier = sensor_name(ID);
         deviceId = mqtt_id + "_" + sensorIdentifier;
         uniqueId = deviceId + "_" + value[what];
         configTopic = hass_base + deviceId + "/" + value[what] + "/config";
@@ -405,9 +532,7 @@ void pub_hass_weather_config(int what, byte ID)
             "\"enabled_by_default\":true"
         "}";
 
-    mqtt_client.beginPublish(configTopic.c_str(), msg.length(), true);
-    mqtt_client.print(msg);
-    mqtt_client.endPublish();
+    mqtt_publish(configTopic.c_str(), msg.c_str(), true, decode_rx_us);
 }
 
 void pub_hass_config(int what, byte ID, byte channel)
@@ -425,7 +550,7 @@ void pub_hass_config(int what, byte ID, byte channel)
         return;
     hass_cfg[ID] |= configMask;
     
-    String sensorName = id2name[ID].length() > 0 ? id2name[ID] : ("LaCrosse_" + String(ID));
+    String sensorName = has_sensor_name(ID) ? String(sensor_name(ID)) : ("LaCrosse_" + String(ID));
     
     // WICHTIG: deviceId bleibt GLEICH für beide Kanäle!
     String deviceId;
@@ -433,8 +558,8 @@ void pub_hass_config(int what, byte ID, byte channel)
     String configTopic;
     String stateTopic;
     
-    if (config.mqtt_use_names && id2name[ID].length() > 0) {
-        String sensorIdentifier = id2name[ID];
+    if (config.mqtt_use_names && has_sensor_name(ID)) {
+        const char *sensorIdentifier = sensor_name(ID);
         deviceId = mqtt_id + "_" + sensorIdentifier;
         
         if (channel == 2 && what == 2) {
@@ -488,9 +613,7 @@ void pub_hass_config(int what, byte ID, byte channel)
             "\"enabled_by_default\":true"
         "}";
 
-    mqtt_client.beginPublish(configTopic.c_str(), msg.length(), true);
-    mqtt_client.print(msg);
-    mqtt_client.endPublish();
+    mqtt_publish(configTopic.c_str(), msg.c_str(), true, decode_rx_us);
 }
 
 void pub_hass_battery_config(byte ID)
@@ -504,15 +627,15 @@ void pub_hass_battery_config(byte ID)
         return;
     battery_cfg_sent[ID] = 1;
     
-    String sensorName = id2name[ID].length() > 0 ? id2name[ID] : ("LaCrosse_" + String(ID));
+    String sensorName = has_sensor_name(ID) ? String(sensor_name(ID)) : ("LaCrosse_" + String(ID));
     
     String deviceId;
     String uniqueId;
     String configTopic;
     String stateTopic;
     
-    if (config.mqtt_use_names && id2name[ID].length() > 0) {
-        String sensorIdentifier = id2name[ID];
+    if (config.mqtt_use_names && has_sensor_name(ID)) {
+        const char *sensorIdentifier = sensor_name(ID);
         deviceId = mqtt_id + "_" + sensorIdentifier;
         uniqueId = deviceId + "_battery";
         configTopic = hass_base + deviceId + "/battery/config";
@@ -538,9 +661,7 @@ void pub_hass_battery_config(byte ID)
             "\"unit_of_measurement\":\"%\""
         "}";
     
-    mqtt_client.beginPublish(configTopic.c_str(), msg.length(), true);
-    mqtt_client.print(msg);
-    mqtt_client.endPublish();
+    mqtt_publish(configTopic.c_str(), msg.c_str(), true, decode_rx_us);
 }
 
 void pub_hass_uv_light_config(int what, byte ID)
@@ -560,15 +681,15 @@ void pub_hass_uv_light_config(int what, byte ID)
         return;
     hass_cfg[ID] |= configMask;
     
-    String sensorName = id2name[ID].length() > 0 ? id2name[ID] : ("Weather_" + String(ID));
+    String sensorName = has_sensor_name(ID) ? String(sensor_name(ID)) : ("Weather_" + String(ID));
     
     String deviceId;
     String uniqueId;
     String configTopic;
     String stateTopic;
     
-    if (config.mqtt_use_names && id2name[ID].length() > 0) {
-        String sensorIdentifier = id2name[ID];
+    if (config.mqtt_use_names && has_sensor_name(ID)) {
+        const char *sensorIdentifier = sensor_name(ID);
         deviceId = mqtt_id + "_" + sensorIdentifier;
         uniqueId = deviceId + "_" + value[what];
         configTopic = hass_base + deviceId + "/" + value[what] + "/config";
@@ -613,9 +734,7 @@ void pub_hass_uv_light_config(int what, byte ID)
             "\"enabled_by_default\":true"
         "}";
 
-    mqtt_client.beginPublish(configTopic.c_str(), msg.length(), true);
-    mqtt_client.print(msg);
-    mqtt_client.endPublish();
+    mqtt_publish(configTopic.c_str(), msg.c_str(), true, decode_rx_us);
 }
 
 void pub_hass_pressure_config(byte ID)
@@ -628,15 +747,15 @@ void pub_hass_pressure_config(byte ID)
         return;
     hass_cfg[ID] |= configMask;
     
-    String sensorName = id2name[ID].length() > 0 ? id2name[ID] : ("Weather_" + String(ID));
+    String sensorName = has_sensor_name(ID) ? String(sensor_name(ID)) : ("Weather_" + String(ID));
     
     String deviceId;
     String uniqueId;
     String configTopic;
     String stateTopic;
     
-    if (config.mqtt_use_names && id2name[ID].length() > 0) {
-        String sensorIdentifier = id2name[ID];
+    if (config.mqtt_use_names && has_sensor_name(ID)) {
+        const char *sensorIdentifier = sensor_name(ID);
         deviceId = mqtt_id + "_" + sensorIdentifier;
         uniqueId = deviceId + "_pressure";
         configTopic = hass_base + deviceId + "/pressure/config";
@@ -662,9 +781,7 @@ void pub_hass_pressure_config(byte ID)
             "\"enabled_by_default\":true"
         "}";
 
-    mqtt_client.beginPublish(configTopic.c_str(), msg.length(), true);
-    mqtt_client.print(msg);
-    mqtt_client.endPublish();
+    mqtt_publish(configTopic.c_str(), msg.c_str(), true, decode_rx_us);
 }
 
 void expire_cache() {
@@ -692,17 +809,20 @@ void expire_cache() {
     if (sensor_timeout > 900000) sensor_timeout = 900000; // Max 15 Minuten
     
     if (config.debug_mode && now % 60000 < 100) { // Log alle 60 Sekunden
-        Serial.printf("Cache timeout: %lu ms (%d protocols active)\n", sensor_timeout, active_protocols);
+        LogDebug.printf("Cache timeout: %lu ms (%d protocols active)\n", sensor_timeout, active_protocols);
     }
     
     // Bereinige Sensoren mit ungültiger Datenrate
     for (int i = 0; i < SENSOR_NUM; i++) {
         if (fcache[i].timestamp > 0 && fcache[i].rate == 0) {
             if (config.debug_mode) {
-                Serial.printf("[CLEANUP] Removing sensor ID %d with invalid rate=0\n", fcache[i].ID);
+                LogDebug.printf("[CLEANUP] Removing sensor ID %d with invalid rate=0\n", fcache[i].ID);
             }
+            cache_write_begin();
             fcache[i].timestamp = 0;
             fcache[i].valid = false;
+            mark_sensor_changed(i);
+            cache_write_end();
         }
     }
 
@@ -710,9 +830,10 @@ void expire_cache() {
         // Kanal 1 Daten
         if (fcache[i].timestamp > 0 && now - fcache[i].timestamp > sensor_timeout) {
             if (config.debug_mode) {
-                Serial.printf("Expiring sensor ID %d (age: %lu ms)\n", fcache[i].ID, now - fcache[i].timestamp);
+                LogDebug.printf("Expiring sensor ID %d (age: %lu ms)\n", fcache[i].ID, now - fcache[i].timestamp);
             }
             
+            cache_write_begin();
             fcache[i].timestamp = 0;
             fcache[i].temp = 0;
             fcache[i].humi = 0;
@@ -726,15 +847,27 @@ void expire_cache() {
             fcache[i].rain_total = 0;
             fcache[i].power = 0;
             fcache[i].pressure = 0;
+            fcache[i].temp_timestamp = 0;
+            fcache[i].wind_timestamp = 0;
+            fcache[i].rain_timestamp = 0;
+            fcache[i].power_timestamp = 0;
+            fcache[i].pressure_timestamp = 0;
+            fcache[i].uv_timestamp = 0;
+            fcache[i].light_timestamp = 0;
+            mark_sensor_changed(i);
+            cache_write_end();
         }
         
         // Kanal 2 Daten
         if (fcache[i].timestamp_ch2 > 0 && now - fcache[i].timestamp_ch2 > sensor_timeout) {
             if (config.debug_mode) {
-                Serial.printf("Expiring sensor ID %d CH2 (age: %lu ms)\n", fcache[i].ID, now - fcache[i].timestamp_ch2);
+                LogDebug.printf("Expiring sensor ID %d CH2 (age: %lu ms)\n", fcache[i].ID, now - fcache[i].timestamp_ch2);
             }
+            cache_write_begin();
             fcache[i].timestamp_ch2 = 0;
             fcache[i].temp_ch2 = 0;
+            mark_sensor_changed(i);
+            cache_write_end();
         }
     }
 }
@@ -746,16 +879,17 @@ void update_display(LaCrosse::Frame *frame)
         return;
     }
     last_display_update = now;
+    PerfTimer t(PERF_DISPLAY);
     
     uint32_t uptime = uptime_sec();
     
     if (config.display_on) {
-        display.ssd1306_command(SSD1306_DISPLAYON);
+        display_set_on();
     } else {
         if (uptime < auto_display_on + DISPLAY_TIMEOUT) {
-            display.ssd1306_command(SSD1306_DISPLAYON);
+            display_set_on();
         } else {
-            display.ssd1306_command(SSD1306_DISPLAYOFF);
+            display_set_off();
             return;
         }
     }
@@ -774,25 +908,27 @@ void update_display(LaCrosse::Frame *frame)
         display.println("IP: " + WiFi.localIP().toString());
         display.setCursor(0, 54);
         display.println("MQTT: " + String(mqtt_ok ? "OK" : "---"));
-        display.display();
+        oled_flush(display);
     } else {
-        byte newestID = 0;
+        // Kopien ueber den Seqlock, fcache gehoert dem Decode-Task
+        Cache c, newest;
         unsigned long newestTime = 0;
         
         for (int id = 0; id < SENSOR_NUM; id++) {
+            cache_read(id, &c);
             // Filter: Ignoriere Sensoren mit rate=0
-            if (fcache[id].timestamp > 0 && fcache[id].valid && 
-                fcache[id].rate > 0 && fcache[id].timestamp > newestTime) {
-                newestTime = fcache[id].timestamp;
-                newestID = id;
+            if (c.timestamp > 0 && c.valid && 
+                c.rate > 0 && c.timestamp > newestTime) {
+                newestTime = c.timestamp;
+                newest = c;
             }
         }
         
         if (newestTime > 0) {
-            byte baseID = newestID;
-            String displayName = id2name[baseID].length() > 0 ? id2name[baseID] : ("ID: " + String(baseID));
+            byte baseID = newest.ID;
+            String displayName = has_sensor_name(baseID) ? String(sensor_name(baseID)) : ("ID: " + String(baseID));
             
-            if (fcache[newestID].channel == 2) {
+            if (newest.channel == 2) {
                 displayName += " Ch2";
             }
             
@@ -800,68 +936,199 @@ void update_display(LaCrosse::Frame *frame)
             display.println("----------------");
             
             char tempBuf[24];
-            snprintf(tempBuf, sizeof(tempBuf), "Temp: %.1fC", fcache[newestID].temp);
+            snprintf(tempBuf, sizeof(tempBuf), "Temp: %.1fC", newest.temp);
             display.println(tempBuf);
             
-            if (fcache[newestID].humi > 0 && fcache[newestID].humi <= 100) {
-                snprintf(tempBuf, sizeof(tempBuf), "Humidity: %d%%", fcache[newestID].humi);
+            if (newest.humi > 0 && newest.humi <= 100) {
+                snprintf(tempBuf, sizeof(tempBuf), "Humidity: %d%%", newest.humi);
                 display.println(tempBuf);
             }
             
-            if (fcache[newestID].batlo) {
+            if (newest.batlo) {
                 display.println("BAT: WEAK!");
             }
             
             String rawHex = "RAW: ";
             for (int i = 0; i < FRAME_LENGTH; i++) {
-                if (fcache[newestID].data[i] < 16) rawHex += "0";
-                rawHex += String(fcache[newestID].data[i], HEX);
+                if (newest.data[i] < 16) rawHex += "0";
+                rawHex += String(newest.data[i], HEX);
                 if (i < FRAME_LENGTH - 1) rawHex += " ";
             }
             display.setCursor(0, 54);
             display.println(rawHex);
-            display.display();
+            oled_flush(display);
         } else {
             display.println("Warte auf Daten...");
-            display.display();
+            oled_flush(display);
         }
     }
 }
 
-void receive()
+/* Dekodieren, Cache aktualisieren und publizieren eines Frames aus der
+ * Raw-Queue; laeuft im Decode-Task, der einzige Schreiber von fcache */
+static void pub_hass_field(uint8_t kind, byte ID, byte channel)
 {
-    byte *payload;
-    byte payLoadSize;
-    int rssi, rate;
-    if (!SX.Receive(payLoadSize))
-        return;
+    switch (kind) {
+    case HK_HUMI:         pub_hass_config(0, ID, channel); break;
+    case HK_TEMP:         pub_hass_config((channel == 2) ? 2 : 1, ID, channel); break;
+    case HK_WIND_SPEED:   pub_hass_weather_config(0, ID); break;
+    case HK_WIND_DIR:     pub_hass_weather_config(1, ID); break;
+    case HK_WIND_GUST:    pub_hass_weather_config(2, ID); break;
+    case HK_RAIN:         pub_hass_weather_config(3, ID); break;
+    case HK_WIND_BEARING: pub_hass_weather_config(5, ID); break;
+    case HK_PRESSURE:     pub_hass_pressure_config(ID); break;
+    case HK_UV:           pub_hass_uv_light_config(0, ID); break;
+    case HK_LIGHT:        pub_hass_uv_light_config(1, ID); break;
+    default: break;
+    }
+}
+
+/* Dekodieren, Cache, MQTT und HA-Discovery fuer ein Protokoll aus Decoder<Frame>
+ * (decoder.h). Auf Kanal 2 gibt es nur die SF_CH2-Werte (Temperatur). */
+template <class Frame>
+bool handle_protocol(byte *payload, byte payLoadSize, int rssi, int rate)
+{
+    typedef Decoder<Frame> D;
+
+    if (!D::enabled() || payLoadSize != D::length)
+        return false;
+
+    Frame frame;
+    frame.rssi = rssi;
+    frame.rate = rate;
+    if (!D::decode(payload, payLoadSize, &frame))
+        return false;
+
+    metrics.frames[D::proto]++;
+    trace_mark(TRACE_DECODED);
+    if (sensor_repeat(GetCacheIndex(frame.ID, D::channel(frame)), D::proto, payload, payLoadSize)) {
+        metrics.repeats[D::proto]++;
+        return true;
+    }
+    D::display(payload, payLoadSize, &frame);
+
+    byte ID = frame.ID;
+    byte channel = D::channel(frame);
+    bool ch2 = D::dual_channel && channel == 2;
+    const SensorField *fields = D::fields();
+    float values[SENSOR_FIELDS_MAX];
+    static_assert(D::field_count <= SENSOR_FIELDS_MAX, "too many fields");
+    sensor_values<D>(frame, values);
+
+    // Ausreisser zurueckhalten, vor store_reading (prueft den alten Zeitstempel)
+    int idx = GetCacheIndex(ID, channel);
+    uint32_t held = 0;
+    for (uint8_t i = 0; i < D::field_count; i++) {
+        uint8_t slot = filter_slot(fields[i].hass, ch2);
+        if (slot != FS_NONE && !(ch2 && !(fields[i].flags & SF_CH2)) && !filter_accept(idx, slot, values[i]))
+            held |= 1UL << i;
+    }
+    store_reading(frame, values, held, rssi, rate);
+
+    char metric[HIST_METRIC_LEN];
+    for (uint8_t i = 0; i < D::field_count; i++) {
+        const SensorField &f = fields[i];
+        if ((f.flags & SF_TEXT) || (ch2 && !(f.flags & SF_CH2)) || (held & (1UL << i)))
+            continue;
+        if ((f.flags & SF_BEARING) && (values[i] < 0 || values[i] > 360))
+            continue;
+        snprintf(metric, sizeof(metric), "%s%s", f.topic, ch2 ? "_ch2" : "");
+        history_add(idx, metric, f.decimals, values[i]);
+    }
+
+    // MQTT Publishing - ENTWEDER Named Topics ODER ID Topics
+    String mqttBaseTopic;
+    String sensorIdentifier;
+
+    bool use_name_topics = (config.mqtt_use_names && has_sensor_name(ID));
+
+    if (use_name_topics) {
+        sensorIdentifier = sensor_name(ID);
+        mqttBaseTopic = pretty_base + sensorIdentifier + "/";
+    } else {
+        sensorIdentifier = String(ID, DEC);
+        mqttBaseTopic = pub_base + sensorIdentifier + "/";
+    }
+
+    for (uint8_t i = 0; i < D::field_count; i++) {
+        const SensorField &f = fields[i];
+        if ((ch2 && !(f.flags & SF_CH2)) || (held & (1UL << i)))
+            continue;
+        String topic = mqttBaseTopic + f.topic + (ch2 ? "_ch2" : "");
+        if (f.flags & SF_TEXT)
+            mqtt_publish(topic.c_str(), GetWindDirectionText(values[i]), false, decode_rx_us);
+        else if (f.flags & SF_INT)
+            mqtt_publish(topic.c_str(), String((int)values[i], DEC).c_str(), false, decode_rx_us);
+        else
+            mqtt_publish(topic.c_str(), String(values[i], (unsigned int)f.decimals).c_str(), false, decode_rx_us);
+    }
+
+    String state = "{\"RSSI\": " + String(rssi);
+    if (D::has_battery)
+        state += ", \"batlo\": " + String(D::batlo(frame) ? "true" : "false");
+    if (D::dual_channel)
+        state += ", \"channel\": " + String(channel);
+    state += ", \"type\": \"" + String(D::name()) + "\"}";
+    mqtt_publish((mqttBaseTopic + (ch2 ? "state_ch2" : "state")).c_str(), state.c_str(), false, decode_rx_us);
+
+    // Battery nur bei Kanal 1
+    if (D::has_battery && !ch2) {
+        int batteryPercent = D::batlo(frame) ? 10 : 100;
+        mqtt_publish((mqttBaseTopic + "battery").c_str(), String(batteryPercent).c_str(), false, decode_rx_us);
+    }
+
+    // Home Assistant Discovery
+    if (config.ha_discovery && has_sensor_name(ID)) {
+        for (uint8_t i = 0; i < D::field_count; i++) {
+            if (ch2 && !(fields[i].flags & SF_CH2))
+                continue;
+            pub_hass_field(fields[i].hass, ID, channel);
+        }
+        if (D::has_battery && !ch2)
+            pub_hass_battery_config(ID);
+    }
 
-    digitalWrite(LED_BUILTIN, HIGH);
-    rssi = SX.GetRSSI();
-    rate = SX.GetDataRate();
-    payload = SX.GetPayloadPointer();
+    if (config.debug_mode) {
+        LogDebug.printf("[MQTT] %s ID=%d Ch=%d Name=%s\n", D::name(), ID, channel, sensorIdentifier.c_str());
+    }
+    return true;
+}
+
+/* TX141-Kodierung je Sensor, nur der Decode-Task */
+static LaCrosse::TX141Lock tx141_lock;
+
+void handle_frame(RawFrame *f)
+{
+    byte *payload = f->data;
+    byte payLoadSize = f->len;
+    int rssi = f->rssi;
+    int rate = f->rate;
 
     // ===== Filter für ungültige Datenrate =====
     if (rate == 0) {
         if (config.debug_mode) {
-            Serial.println("[FILTER] Frame rejected: Invalid data rate (0)");
+            LogDebug.println("[FILTER] Frame rejected: Invalid data rate (0)");
         }
-        SX.EnableReceiver(true);
+        metrics.rejected_frames++;
         digitalWrite(LED_BUILTIN, LOW);
         return;
     }
 
+    // Namen/Config nicht waehrend einer Aenderung durch den Webserver lesen
+    state_lock();
+    hass_sync();
+
     if (config.debug_mode) {
-        Serial.print("\n[DEBUG] End receiving, HEX raw data: ");
+        LogDebug.print("\n[DEBUG] End receiving, HEX raw data: ");
         for (int i = 0; i < payLoadSize; i++) {
-            if (payload[i] < 16) Serial.print("0");
-            Serial.print(payload[i], HEX);
-            Serial.print(" ");
+            if (payload[i] < 16) LogDebug.print("0");
+            LogDebug.print(payload[i], HEX);
+            LogDebug.print(" ");
         }
-        Serial.print(" RSSI:");
-        Serial.print(rssi);
-        Serial.print(" Rate:");
-        Serial.println(rate);
+        LogDebug.print(" RSSI:");
+        LogDebug.print(rssi);
+        LogDebug.print(" Rate:");
+        LogDebug.println(rate);
     }
 
     bool frame_valid = false;
@@ -871,50 +1138,48 @@ void receive()
     lacrosse_frame.rate = rate;
     lacrosse_frame.rssi = rssi;
     
-    frame_valid = LaCrosse::TryHandleData(payload, &lacrosse_frame);
+    frame_valid = LaCrosse::TryHandleData(payload, &lacrosse_frame, config.lacrosse_fec, &tx141_lock);
+    if (frame_valid && lacrosse_frame.corrected) {
+        // ein korrigiertes Bit kann auch ein falsch korrigierter Doppelfehler sein
+        if (lacrosse_plausible(lacrosse_frame)) {
+            metrics.fec_corrected++;
+        } else {
+            metrics.fec_rejected++;
+            metrics.crc_errors[PROTO_LACROSSE]++;
+            frame_valid = false;
+        }
+    }
     add_debug_log(payload, rssi, rate, frame_valid);
     
     if (frame_valid) {
         // ========== LACROSSE IT+ HANDLING ==========
+        metrics.frames[PROTO_LACROSSE]++;
+        trace_mark(TRACE_DECODED);
         byte ID = lacrosse_frame.ID;
         byte channel = lacrosse_frame.channel;
         
-        const char* sensorType = LaCrosse::GetSensorType(&lacrosse_frame);
+        StrId typeId = LaCrosse::GetSensorTypeId(&lacrosse_frame);
+        const char* sensorType = str_get(typeId);
         int cacheIndex = ID;
 
-        if (cacheIndex >= SENSOR_NUM) {
+        if (cacheIndex >= SENSOR_NUM || sensor_repeat(cacheIndex, PROTO_LACROSSE, payload, payLoadSize)) {
+            if (cacheIndex < SENSOR_NUM)
+                metrics.repeats[PROTO_LACROSSE]++;
+            state_unlock();
             digitalWrite(LED_BUILTIN, LOW);
             return;
         }
 
-        LaCrosse::Frame oldframe;
-        if (fcache[cacheIndex].timestamp > 0) {
-            LaCrosse::TryHandleData(fcache[cacheIndex].data, &oldframe);
-        } else {
-            oldframe.valid = false;
-        }
+        bool has_humi = channel == 1 && lacrosse_frame.humi > 0 && lacrosse_frame.humi <= 100;
+        bool temp_ok = filter_accept(cacheIndex, channel == 2 ? FS_TEMP_CH2 : FS_TEMP, lacrosse_frame.temp);
+        bool humi_ok = !has_humi || filter_accept(cacheIndex, FS_HUMI, lacrosse_frame.humi);
+        store_lacrosse(lacrosse_frame, payload, typeId, rssi, !temp_ok, !humi_ok);
+        if (temp_ok)
+            history_add(cacheIndex, channel == 2 ? "temp_ch2" : "temp", 1, lacrosse_frame.temp);
+        if (has_humi && humi_ok)
+            history_add(cacheIndex, "humi", 0, lacrosse_frame.humi);
+        uint8_t plausible = fcache[cacheIndex].plausible;
 
-        // Cache aktualisieren
-        fcache[cacheIndex].ID = lacrosse_frame.ID;
-        fcache[cacheIndex].rate = lacrosse_frame.rate;
-        fcache[cacheIndex].rssi = rssi;
-        fcache[cacheIndex].valid = lacrosse_frame.valid;
-        fcache[cacheIndex].batlo = lacrosse_frame.batlo;
-        fcache[cacheIndex].init = lacrosse_frame.init;
-        memcpy(&fcache[cacheIndex].data, payload, FRAME_LENGTH);
-        strncpy(fcache[cacheIndex].sensorType, sensorType, 15);
-        fcache[cacheIndex].sensorType[15] = '\0';
-
-        if (channel == 2) {
-            fcache[cacheIndex].temp_ch2 = lacrosse_frame.temp;
-            fcache[cacheIndex].timestamp_ch2 = millis();
-        } else {
-            fcache[cacheIndex].temp = lacrosse_frame.temp;
-            fcache[cacheIndex].humi = lacrosse_frame.humi;
-            fcache[cacheIndex].timestamp = millis();
-            fcache[cacheIndex].channel = lacrosse_frame.channel;
-        }
-        
         LaCrosse::DisplayFrame(payload, &lacrosse_frame);
         
         // MQTT Publishing - ENTWEDER Named Topics ODER ID Topics (nie beides)
@@ -922,11 +1187,11 @@ void receive()
         String sensorIdentifier;
         
         // Entscheidung: Welche Topic-Struktur verwenden?
-        bool use_name_topics = (config.mqtt_use_names && id2name[ID].length() > 0);
+        bool use_name_topics = (config.mqtt_use_names && has_sensor_name(ID));
         
         if (use_name_topics) {
             // Verwende AUSSCHLIESSLICH Named Topics
-            sensorIdentifier = id2name[ID];
+            sensorIdentifier = sensor_name(ID);
             mqttBaseTopic = pretty_base + sensorIdentifier + "/";
         } else {
             // Verwende AUSSCHLIESSLICH ID Topics
@@ -936,10 +1201,11 @@ void receive()
 
         // Alle Publishes verwenden das gewählte mqttBaseTopic
         String tempTopic = mqttBaseTopic + (channel == 2 ? "temp_ch2" : "temp");
-        mqtt_client.publish(tempTopic.c_str(), String(lacrosse_frame.temp, 1).c_str());
+        if (temp_ok)
+            mqtt_publish(tempTopic.c_str(), String(lacrosse_frame.temp, 1).c_str(), false, decode_rx_us);
         
-        if (channel == 1 && lacrosse_frame.humi > 0 && lacrosse_frame.humi <= 100) {
-            mqtt_client.publish((mqttBaseTopic + "humi").c_str(), String(lacrosse_frame.humi, DEC).c_str());
+        if (has_humi && humi_ok) {
+            mqtt_publish((mqttBaseTopic + "humi").c_str(), String(lacrosse_frame.humi, DEC).c_str(), false, decode_rx_us);
         }
         
         String stateTopic = mqttBaseTopic + (channel == 2 ? "state_ch2" : "state");
@@ -951,20 +1217,20 @@ void receive()
             ", \"channel\": " + String(lacrosse_frame.channel) +
             ", \"type\": \"" + String(sensorType) + "\"" +
             "}";
-        mqtt_client.publish(stateTopic.c_str(), state.c_str());
+        mqtt_publish(stateTopic.c_str(), state.c_str(), false, decode_rx_us);
         
         if (channel == 1) {
             int batteryPercent = lacrosse_frame.batlo ? 10 : 100;
-            mqtt_client.publish((mqttBaseTopic + "battery").c_str(), String(batteryPercent).c_str());
+            mqtt_publish((mqttBaseTopic + "battery").c_str(), String(batteryPercent).c_str(), false, decode_rx_us);
         }
         
         // Home Assistant Discovery
-        if (config.ha_discovery && id2name[ID].length() > 0) {
-            if (!oldframe.valid || abs(oldframe.temp - lacrosse_frame.temp) <= 2.0) {
+        if (config.ha_discovery && has_sensor_name(ID)) {
+            if (plausible & PLAUSIBLE_TEMP) {
                 pub_hass_config((channel == 2) ? 2 : 1, ID, channel);
             }
             if (channel == 1 && lacrosse_frame.humi > 0 && lacrosse_frame.humi <= 100) {
-                if (!oldframe.valid || abs(oldframe.humi - lacrosse_frame.humi) <= 10) {
+                if (plausible & PLAUSIBLE_HUMI) {
                     pub_hass_config(0, ID, channel);
                 }
             }
@@ -974,637 +1240,151 @@ void receive()
         }
         
         if (config.debug_mode) {
-            Serial.printf("[MQTT] LaCrosse ID=%d Ch=%d Name=%s\n", 
-                          ID, channel, id2name[ID].length() > 0 ? id2name[ID].c_str() : "none");
-            Serial.printf("[MQTT] Topics: %s\n", mqttBaseTopic.c_str());
+            LogDebug.printf("[MQTT] LaCrosse ID=%d Ch=%d Name=%s\n", 
+                          ID, channel, has_sensor_name(ID) ? sensor_name(ID) : "none");
+            LogDebug.printf("[MQTT] Topics: %s\n", mqttBaseTopic.c_str());
         }
 
     } else {
-        // ========== VERSUCHE WH1080 PROTOKOLL ==========
-        if (config.proto_wh1080 && payLoadSize == 10) {
-            WH1080::Frame wh_frame;
-            wh_frame.rssi = rssi;
-            wh_frame.rate = rate;
-            
-            if (WH1080::TryHandleData(payload, payLoadSize, &wh_frame)) {
-                WH1080::DisplayFrame(payload, payLoadSize, &wh_frame);
-                
-                byte ID = wh_frame.ID;
-                int cacheIndex = ID;
-                if (cacheIndex >= 0 && cacheIndex < SENSOR_NUM) {
-                    fcache[cacheIndex].ID = ID;
-                    fcache[cacheIndex].temp = wh_frame.temp;
-                    fcache[cacheIndex].humi = wh_frame.humi;
-                    fcache[cacheIndex].wind_speed = wh_frame.wind_speed;
-                    fcache[cacheIndex].wind_gust = wh_frame.wind_gust;
-                    fcache[cacheIndex].rain_total = wh_frame.rain;
-                    fcache[cacheIndex].rssi = rssi;
-                    fcache[cacheIndex].rate = rate;
-                    fcache[cacheIndex].timestamp = millis();
-                    strncpy(fcache[cacheIndex].sensorType, "WH1080", 15);
-                    fcache[cacheIndex].sensorType[15] = '\0';
-            
-                    // ← WICHTIG: Windrichtung NUR setzen wenn gültig!
-                    if (wh_frame.wind_bearing >= 0 && wh_frame.wind_bearing <= 15) {
-                        fcache[cacheIndex].wind_direction = (int)(wh_frame.wind_bearing * 22.5f);
-                    } else {
-                        fcache[cacheIndex].wind_direction = -1;
-                    }
-                }
-                
-                // MQTT Publishing - ENTWEDER Named Topics ODER ID Topics
-                String mqttBaseTopic;
-                String sensorIdentifier;
-                
-                bool use_name_topics = (config.mqtt_use_names && id2name[ID].length() > 0);
-                
-                if (use_name_topics) {
-                    sensorIdentifier = id2name[ID];
-                    mqttBaseTopic = pretty_base + sensorIdentifier + "/";
-                } else {
-                    sensorIdentifier = String(ID, DEC);
-                    mqttBaseTopic = pub_base + sensorIdentifier + "/";
-                }
+        frame_valid = handle_protocol<WH1080::Frame>(payload, payLoadSize, rssi, rate)
+                   || handle_protocol<WS1600::Frame>(payload, payLoadSize, rssi, rate)
+                   || handle_protocol<WT440XH::Frame>(payload, payLoadSize, rssi, rate)
+                   || handle_protocol<TX22IT::Frame>(payload, payLoadSize, rssi, rate)
+                   || handle_protocol<EMT7110::Frame>(payload, payLoadSize, rssi, rate)
+                   || handle_protocol<W136::Frame>(payload, payLoadSize, rssi, rate)
+                   || handle_protocol<HP1000::Frame>(payload, payLoadSize, rssi, rate)
+                   || handle_protocol<WH65B::Frame>(payload, payLoadSize, rssi, rate);
 
-                // Publish Weather Data
-                mqtt_client.publish((mqttBaseTopic + "temp").c_str(), String(wh_frame.temp, 1).c_str());
-                mqtt_client.publish((mqttBaseTopic + "humi").c_str(), String(wh_frame.humi, DEC).c_str());
-                mqtt_client.publish((mqttBaseTopic + "wind_speed").c_str(), String(wh_frame.wind_speed, 2).c_str());
-                mqtt_client.publish((mqttBaseTopic + "wind_gust").c_str(), String(wh_frame.wind_gust, 2).c_str());
-                
-                float wind_degrees = wh_frame.wind_bearing * 22.5f;
-                mqtt_client.publish((mqttBaseTopic + "wind_bearing").c_str(), String(wind_degrees, 1).c_str());
-                mqtt_client.publish((mqttBaseTopic + "wind_direction").c_str(), WH1080::GetWindDirection(wh_frame.wind_bearing));
-                mqtt_client.publish((mqttBaseTopic + "rain").c_str(), String(wh_frame.rain, 1).c_str());
-                
-                String state = "{\"RSSI\": " + String(rssi) + ", \"type\": \"WH1080\"}";
-                mqtt_client.publish((mqttBaseTopic + "state").c_str(), state.c_str());
-                
-                // Home Assistant Discovery
-                if (config.ha_discovery && id2name[ID].length() > 0) {
-                    pub_hass_config(1, ID, 1);  // Temperature
-                    pub_hass_config(0, ID, 1);  // Humidity
-                    pub_hass_weather_config(0, ID);  // Wind Speed
-                    pub_hass_weather_config(1, ID);  // Wind Direction
-                    pub_hass_weather_config(2, ID);  // Wind Gust
-                    pub_hass_weather_config(3, ID);  // Rain
-                    pub_hass_weather_config(4, ID);  // Wind Bearing
-                }
-
-                frame_valid = true;
-                
-                if (config.debug_mode) {
-                    Serial.printf("[MQTT] WH1080 ID=%d Name=%s\n", ID, sensorIdentifier.c_str());
-                }
-            }
+        // Falls kein Protokoll erkannt wurde
+        if (!frame_valid) {
+            metrics.unknown_frames++;
+            print_raw("Unknown", payload, payLoadSize, rssi, rate);
         }
-        
-        // ========== VERSUCHE WS1600 PROTOKOLL ==========
-        if (!frame_valid && config.proto_ws1600 && payLoadSize == 9) {
-            WS1600::Frame ws_frame;
-            ws_frame.rssi = rssi;
-            ws_frame.rate = rate;
-            
-            if (WS1600::TryHandleData(payload, payLoadSize, &ws_frame)) {
-                WS1600::DisplayFrame(payload, payLoadSize, &ws_frame);
-                
-                byte ID = ws_frame.ID;
-
-            int cacheIndex = ID;
-            if (cacheIndex >= 0 && cacheIndex < SENSOR_NUM) {
-                fcache[cacheIndex].ID = ID;
-                fcache[cacheIndex].channel = ws_frame.channel;
-                fcache[cacheIndex].temp = ws_frame.temp;
-                fcache[cacheIndex].humi = ws_frame.humi;
-                fcache[cacheIndex].wind_speed = ws_frame.wind_speed;
-                fcache[cacheIndex].rain_total = ws_frame.rain;
-                fcache[cacheIndex].rssi = rssi;
-                fcache[cacheIndex].rate = rate;
-                fcache[cacheIndex].batlo = ws_frame.batlo;
-                fcache[cacheIndex].timestamp = millis();
-                strncpy(fcache[cacheIndex].sensorType, "WS1600", 15);
-                fcache[cacheIndex].sensorType[15] = '\0';
-        
-                // Wind Direction: wsframe.winddirection ist 0-15
-                if (ws_frame.wind_direction >= 0 && ws_frame.wind_direction <= 15) {
-                    fcache[cacheIndex].wind_direction = (int)(ws_frame.wind_direction * 22.5f);
-                } else {
-                    fcache[cacheIndex].wind_direction = -1;
-                }
-            }
-                // MQTT Publishing - ENTWEDER Named Topics ODER ID Topics
-                String mqttBaseTopic;
-                String sensorIdentifier;
-                
-                bool use_name_topics = (config.mqtt_use_names && id2name[ID].length() > 0);
-                
-                if (use_name_topics) {
-                    sensorIdentifier = id2name[ID];
-                    mqttBaseTopic = pretty_base + sensorIdentifier + "/";
-                } else {
-                    sensorIdentifier = String(ID, DEC);
-                    mqttBaseTopic = pub_base + sensorIdentifier + "/";
-                }
+    }
 
-                // Publish Weather Data
-                mqtt_client.publish((mqttBaseTopic + "temp").c_str(), String(ws_frame.temp, 1).c_str());
-                mqtt_client.publish((mqttBaseTopic + "humi").c_str(), String(ws_frame.humi, DEC).c_str());
-                mqtt_client.publish((mqttBaseTopic + "wind_speed").c_str(), String(ws_frame.wind_speed, 2).c_str());
-                
-                float wind_degrees = ws_frame.wind_direction * 22.5f;
-                mqtt_client.publish((mqttBaseTopic + "wind_bearing").c_str(), String(wind_degrees, 1).c_str());
-                mqtt_client.publish((mqttBaseTopic + "wind_direction").c_str(), GetWindDirectionText(wind_degrees));
-                mqtt_client.publish((mqttBaseTopic + "rain").c_str(), String(ws_frame.rain, 1).c_str());
-                
-                String state = "{\"RSSI\": " + String(rssi) + 
-                              ", \"batlo\": " + String(ws_frame.batlo ? "true" : "false") + 
-                              ", \"type\": \"WS1600\"}";
-                mqtt_client.publish((mqttBaseTopic + "state").c_str(), state.c_str());
-                
-                // Battery
-                int batteryPercent = ws_frame.batlo ? 10 : 100;
-                mqtt_client.publish((mqttBaseTopic + "battery").c_str(), String(batteryPercent).c_str());
-                
-                // Home Assistant Discovery
-                if (config.ha_discovery && id2name[ID].length() > 0) {
-
-                    pub_hass_config(1, ID, 1);  // Temperature
-                    pub_hass_config(0, ID, 1);  // Humidity
-                    pub_hass_weather_config(0, ID);  // Wind Speed
-                    pub_hass_weather_config(1, ID);  // Wind Direction
-                    pub_hass_weather_config(2, ID);  // Wind Gust
-                    pub_hass_weather_config(3, ID);  // Rain
-                    pub_hass_weather_config(4, ID);
-                    pub_hass_weather_config(5, ID);  // Wind Bearing
-                    pub_hass_battery_config(ID);
-                }
-                
-                frame_valid = true;
-                
-                if (config.debug_mode) {
-                    Serial.printf("[MQTT] WS1600 ID=%d Ch=%d Name=%s\n", ID, ws_frame.channel, sensorIdentifier.c_str());
-                }
-            }
+    state_unlock();
+    
+    digitalWrite(LED_BUILTIN, LOW);
+}
+
+void check_wifi_status()
+{
+    wl_status_t current_status = WiFi.status();
+    if (current_status != last_wifi_status) {
+        LogInfo.printf("WiFi status changed: %d -> %d\n", last_wifi_status, current_status);
+        
+        if (current_status == WL_CONNECTED) {
+            LogInfo.println("WiFi: Connected");
+            auto_display_on = uptime_sec();
+        } else if (last_wifi_status == WL_CONNECTED) {
+            LogInfo.println("WiFi: Disconnected");
+            auto_display_on = uptime_sec();
         }
         
-        // ========== VERSUCHE WT440XH PROTOKOLL ==========
-        if (!frame_valid && config.proto_wt440xh && payLoadSize == 4) {
-            WT440XH::Frame wt_frame;
-            wt_frame.rssi = rssi;
-            wt_frame.rate = rate;
-            
-            if (WT440XH::TryHandleData(payload, &wt_frame)) {
-                WT440XH::DisplayFrame(payload, &wt_frame);
-                
-                byte ID = wt_frame.ID;
-                byte channel = wt_frame.channel;
-                
-                // MQTT Publishing - ENTWEDER Named Topics ODER ID Topics
-                String mqttBaseTopic;
-                String sensorIdentifier;
-                
-                bool use_name_topics = (config.mqtt_use_names && id2name[ID].length() > 0);
-                
-                if (use_name_topics) {
-                    sensorIdentifier = id2name[ID];
-                    mqttBaseTopic = pretty_base + sensorIdentifier + "/";
-                } else {
-                    sensorIdentifier = String(ID, DEC);
-                    mqttBaseTopic = pub_base + sensorIdentifier + "/";
-                }
-                
-                String tempTopic = mqttBaseTopic + (channel == 2 ? "temp_ch2" : "temp");
+        last_wifi_status = current_status;
+    }
+}
 
-                // Publish Sensor Data
-                mqtt_client.publish(tempTopic.c_str(), String(wt_frame.temp, 1).c_str());
-                mqtt_client.publish((mqttBaseTopic + "humi").c_str(), String(wt_frame.humi, DEC).c_str());
-                
-                String stateTopic = mqttBaseTopic + (channel == 2 ? "state_ch2" : "state");
-                String state = "{\"RSSI\": " + String(rssi) + 
-                              ", \"batlo\": " + String(wt_frame.batlo ? "true" : "false") +
-                              ", \"channel\": " + String(channel) + 
-                              ", \"type\": \"WT440XH\"}";
-                mqtt_client.publish(stateTopic.c_str(), state.c_str());
-                
-                // Battery nur bei Kanal 1
-                if (channel == 1) {
-                    int batteryPercent = wt_frame.batlo ? 10 : 100;
-                    mqtt_client.publish((mqttBaseTopic + "battery").c_str(), String(batteryPercent).c_str());
-                }
-                
-                // Home Assistant Discovery
-                if (config.ha_discovery && id2name[ID].length() > 0) {
-                    pub_hass_config((channel == 2) ? 2 : 1, ID, channel);
-                    pub_hass_config(0, ID, channel);
-                    if (channel == 1) {
-                        pub_hass_battery_config(ID);
-                    }
-                }
-                
-                frame_valid = true;
-                
-                if (config.debug_mode) {
-                    Serial.printf("[MQTT] WT440XH ID=%d Ch=%d Name=%s\n", ID, channel, sensorIdentifier.c_str());
-                }
-            }
-        }
+static QueueHandle_t raw_queue;
+static TaskHandle_t radio_task_handle;
 
-        // ========== VERSUCHE TX22IT PROTOKOLL ==========
-        if (!frame_valid && config.proto_tx22it && payLoadSize == 9) {
-            TX22IT::Frame tx22_frame;
-            tx22_frame.rssi = rssi;
-            tx22_frame.rate = rate;
-            
-            if (TX22IT::TryHandleData(payload, payLoadSize, &tx22_frame)) {
-                TX22IT::DisplayFrame(payload, payLoadSize, &tx22_frame);
-                
-                byte ID = tx22_frame.ID;
+static void IRAM_ATTR radio_isr()
+{
+    BaseType_t woken = pdFALSE;
+    vTaskNotifyGiveFromISR(radio_task_handle, &woken);
+    portYIELD_FROM_ISR(woken);
+}
 
-                int cacheIndex = ID;
-    
-            if (cacheIndex >= 0 && cacheIndex < SENSOR_NUM) {
-                fcache[cacheIndex].ID = ID;
-                fcache[cacheIndex].channel = 1;
-                fcache[cacheIndex].temp = tx22_frame.temp;
-                fcache[cacheIndex].humi = tx22_frame.humi;
-                fcache[cacheIndex].wind_speed = tx22_frame.wind_speed;
-                fcache[cacheIndex].wind_gust = tx22_frame.wind_gust;
-                fcache[cacheIndex].rssi = rssi;
-                fcache[cacheIndex].rate = rate;
-                fcache[cacheIndex].batlo = tx22_frame.batlo;
-                fcache[cacheIndex].timestamp = millis();
-                strncpy(fcache[cacheIndex].sensorType, "TX22IT", 15);
-                fcache[cacheIndex].sensorType[15] = '\0';
-        
-                // Wind Direction: tx22_frame.winddirection ist direkt 0-360°
-                if (tx22_frame.wind_direction >= 0 && tx22_frame.wind_direction <= 360) {
-                    fcache[cacheIndex].wind_direction = (int)tx22_frame.wind_direction;
-                } else {
-                    fcache[cacheIndex].wind_direction = -1;
-                }
-            }
+/* Radio-Task: nur SPI und Datenraten-Umschaltung. DIO0 meldet PayloadReady
+ * per Interrupt; ist der Pin nicht verdrahtet, greift das Polling alle
+ * RADIO_POLL_MS. Der Empfaenger wird sofort nach dem Kopieren wieder
+ * eingeschaltet, dekodiert wird im Decode-Task. */
+#define RADIO_POLL_MS 2
 
-                // MQTT Publishing - ENTWEDER Named Topics ODER ID Topics
-                String mqttBaseTopic;
-                String sensorIdentifier;
-                
-                bool use_name_topics = (config.mqtt_use_names && id2name[ID].length() > 0);
-                
-                if (use_name_topics) {
-                    sensorIdentifier = id2name[ID];
-                    mqttBaseTopic = pretty_base + sensorIdentifier + "/";
-                } else {
-                    sensorIdentifier = String(ID, DEC);
-                    mqttBaseTopic = pub_base + sensorIdentifier + "/";
-                }
-                
-                // Publish Weather Data
-                mqtt_client.publish((mqttBaseTopic + "temp").c_str(), String(tx22_frame.temp, 1).c_str());
-                mqtt_client.publish((mqttBaseTopic + "humi").c_str(), String(tx22_frame.humi, DEC).c_str());
-                mqtt_client.publish((mqttBaseTopic + "wind_speed").c_str(), String(tx22_frame.wind_speed, 1).c_str());
-                mqtt_client.publish((mqttBaseTopic + "wind_gust").c_str(), String(tx22_frame.wind_gust, 1).c_str());
-                mqtt_client.publish((mqttBaseTopic + "wind_bearing").c_str(), String(tx22_frame.wind_direction, 0).c_str());
-                mqtt_client.publish((mqttBaseTopic + "wind_direction").c_str(), GetWindDirectionText(tx22_frame.wind_direction));
-                
-                String state = "{\"RSSI\": " + String(rssi) + 
-                              ", \"batlo\": " + String(tx22_frame.batlo ? "true" : "false") + 
-                              ", \"type\": \"TX22IT\"}";
-                mqtt_client.publish((mqttBaseTopic + "state").c_str(), state.c_str());
-                
-                // Battery
-                int batteryPercent = tx22_frame.batlo ? 10 : 100;
-                mqtt_client.publish((mqttBaseTopic + "battery").c_str(), String(batteryPercent).c_str());
-                
-                // Home Assistant Discovery
-                if (config.ha_discovery && id2name[ID].length() > 0) {
-                    pub_hass_config(1, ID, 1);  // Temperature
-                    pub_hass_config(0, ID, 1);  // Humidity
-                    pub_hass_weather_config(0, ID);  // Wind Speed
-                    pub_hass_weather_config(1, ID);  // Wind Direction
-                    pub_hass_weather_config(2, ID);  // Wind Gust
-                    pub_hass_weather_config(5, ID);  // Wind Bearing
-                    pub_hass_battery_config(ID);
-                }
-                
-                frame_valid = true;
-                
-                if (config.debug_mode) {
-                    Serial.printf("[MQTT] TX22IT ID=%d Name=%s\n", ID, sensorIdentifier.c_str());
-                }
-            }
-        }
-        
-        // ========== VERSUCHE EMT7110 PROTOKOLL ==========
-        if (!frame_valid && config.proto_emt7110 && payLoadSize == 9) {
-            EMT7110::Frame emt_frame;
-            emt_frame.rssi = rssi;
-            emt_frame.rate = rate;
-            
-            if (EMT7110::TryHandleData(payload, payLoadSize, &emt_frame)) {
-                EMT7110::DisplayFrame(payload, payLoadSize, &emt_frame);
-                
-                byte ID = emt_frame.ID;
-              
-                // MQTT Publishing - ENTWEDER Named Topics ODER ID Topics
-                String mqttBaseTopic;
-                String sensorIdentifier;
-                
-                bool use_name_topics = (config.mqtt_use_names && id2name[ID].length() > 0);
-                
-                if (use_name_topics) {
-                    sensorIdentifier = id2name[ID];
-                    mqttBaseTopic = pretty_base + sensorIdentifier + "/";
-                } else {
-                    sensorIdentifier = String(ID, DEC);
-                    mqttBaseTopic = pub_base + sensorIdentifier + "/";
-                }
-                
-                // Publish Energy Data
-                mqtt_client.publish((mqttBaseTopic + "power").c_str(), String(emt_frame.power, 1).c_str());
-                mqtt_client.publish((mqttBaseTopic + "energy").c_str(), String(emt_frame.energy, 3).c_str());
-                
-                String state = "{\"RSSI\": " + String(rssi) + 
-                              ", \"batlo\": " + String(emt_frame.batlo ? "true" : "false") + 
-                              ", \"type\": \"EMT7110\"}";
-                mqtt_client.publish((mqttBaseTopic + "state").c_str(), state.c_str());
-                
-                // Battery
-                int batteryPercent = emt_frame.batlo ? 10 : 100;
-                mqtt_client.publish((mqttBaseTopic + "battery").c_str(), String(batteryPercent).c_str());
-                
-                // Home Assistant Discovery würde hier weitere Konfigurationen benötigen
-                if (config.ha_discovery && id2name[ID].length() > 0) {
-                    pub_hass_battery_config(ID);
-                }
-                
-                frame_valid = true;
-                
-                if (config.debug_mode) {
-                    Serial.printf("[MQTT] EMT7110 ID=%d Name=%s\n", ID, sensorIdentifier.c_str());
-                }
-            }
-        }
-        
-        // ========== VERSUCHE W136 PROTOKOLL ==========
-        if (!frame_valid && config.proto_w136 && payLoadSize == 6) {
-            W136::Frame w136_frame;
-            w136_frame.rssi = rssi;
-            w136_frame.rate = rate;
-            
-            if (W136::TryHandleData(payload, payLoadSize, &w136_frame)) {
-                W136::DisplayFrame(payload, payLoadSize, &w136_frame);
-                
-                byte ID = w136_frame.ID;
-                // MQTT Publishing - ENTWEDER Named Topics ODER ID Topics
-                String mqttBaseTopic;
-                String sensorIdentifier;
-                
-                bool use_name_topics = (config.mqtt_use_names && id2name[ID].length() > 0);
-                
-                if (use_name_topics) {
-                    sensorIdentifier = id2name[ID];
-                    mqttBaseTopic = pretty_base + sensorIdentifier + "/";
-                } else {
-                    sensorIdentifier = String(ID, DEC);
-                    mqttBaseTopic = pub_base + sensorIdentifier + "/";
-                }
-                
-                // Publish Rain Data
-                mqtt_client.publish((mqttBaseTopic + "rain").c_str(), String(w136_frame.rain, 1).c_str());
-                
-                String state = "{\"RSSI\": " + String(rssi) + 
-                              ", \"batlo\": " + String(w136_frame.batlo ? "true" : "false") + 
-                              ", \"type\": \"W136\"}";
-                mqtt_client.publish((mqttBaseTopic + "state").c_str(), state.c_str());
-                
-                // Battery
-                int batteryPercent = w136_frame.batlo ? 10 : 100;
-                mqtt_client.publish((mqttBaseTopic + "battery").c_str(), String(batteryPercent).c_str());
-                
-                // Home Assistant Discovery
-                if (config.ha_discovery && id2name[ID].length() > 0) {
-                    pub_hass_weather_config(3, ID);  // Rain
-                    pub_hass_battery_config(ID);
-                }
-                
-                frame_valid = true;
-                
-                if (config.debug_mode) {
-                    Serial.printf("[MQTT] W136 ID=%d Name=%s\n", ID, sensorIdentifier.c_str());
-                }
-            }
-        }
-                // ========== VERSUCHE HP1000 PROTOKOLL ==========
-        if (!frame_valid && config.proto_hp1000 && payLoadSize == 18) {
-            HP1000::Frame hp_frame;
-            hp_frame.rssi = rssi;
-            hp_frame.rate = rate;
-            
-            if (HP1000::TryHandleData(payload, payLoadSize, &hp_frame)) {
-                HP1000::DisplayFrame(payload, payLoadSize, &hp_frame);
-                
-                byte ID = hp_frame.ID;
-                int cacheIndex = ID;
-                
-                if (cacheIndex >= 0 && cacheIndex < SENSOR_NUM) {
-                    fcache[cacheIndex].ID = ID;
-                    fcache[cacheIndex].channel = 1;
-                    fcache[cacheIndex].temp = hp_frame.temp;
-                    fcache[cacheIndex].humi = hp_frame.humi;
-                    fcache[cacheIndex].wind_speed = hp_frame.wind_speed;
-                    fcache[cacheIndex].wind_gust = hp_frame.wind_gust;
-                    fcache[cacheIndex].wind_direction = hp_frame.wind_direction;
-                    fcache[cacheIndex].pressure = hp_frame.pressure;
-                    fcache[cacheIndex].rain_total = hp_frame.rain;
-                    fcache[cacheIndex].uv = hp_frame.uv;
-                    fcache[cacheIndex].light_lux = hp_frame.light_lux;
-                    fcache[cacheIndex].rssi = rssi;
-                    fcache[cacheIndex].rate = rate;
-                    fcache[cacheIndex].batlo = hp_frame.batlo;
-                    fcache[cacheIndex].timestamp = millis();
-                    strncpy(fcache[cacheIndex].sensorType, "HP1000", 15);
-                    fcache[cacheIndex].sensorType[15] = '\0';
-                }
-                
-                // MQTT Publishing
-                String mqttBaseTopic;
-                String sensorIdentifier;
-                
-                bool use_name_topics = (config.mqtt_use_names && id2name[ID].length() > 0);
-                
-                if (use_name_topics) {
-                    sensorIdentifier = id2name[ID];
-                    mqttBaseTopic = pretty_base + sensorIdentifier + "/";
-                } else {
-                    sensorIdentifier = String(ID, DEC);
-                    mqttBaseTopic = pub_base + sensorIdentifier + "/";
-                }
-                
-                // Publish All Data
-                mqtt_client.publish((mqttBaseTopic + "temp").c_str(), String(hp_frame.temp, 1).c_str());
-                mqtt_client.publish((mqttBaseTopic + "humi").c_str(), String(hp_frame.humi, DEC).c_str());
-                mqtt_client.publish((mqttBaseTopic + "wind_speed").c_str(), String(hp_frame.wind_speed, 2).c_str());
-                mqtt_client.publish((mqttBaseTopic + "wind_gust").c_str(), String(hp_frame.wind_gust, 2).c_str());
-                mqtt_client.publish((mqttBaseTopic + "wind_bearing").c_str(), String(hp_frame.wind_direction, 0).c_str());
-                mqtt_client.publish((mqttBaseTopic + "wind_direction").c_str(), GetWindDirectionText(hp_frame.wind_direction));
-                mqtt_client.publish((mqttBaseTopic + "pressure").c_str(), String(hp_frame.pressure, 1).c_str());
-                mqtt_client.publish((mqttBaseTopic + "rain").c_str(), String(hp_frame.rain, 1).c_str());
-                mqtt_client.publish((mqttBaseTopic + "uv").c_str(), String(hp_frame.uv, DEC).c_str());
-                mqtt_client.publish((mqttBaseTopic + "light_lux").c_str(), String(hp_frame.light_lux, 0).c_str());
-                
-                String state = "{\"RSSI\": " + String(rssi) + 
-                              ", \"batlo\": " + String(hp_frame.batlo ? "true" : "false") + 
-                              ", \"type\": \"HP1000\"}";
-                mqtt_client.publish((mqttBaseTopic + "state").c_str(), state.c_str());
-                
-                // Battery
-                int batteryPercent = hp_frame.batlo ? 10 : 100;
-                mqtt_client.publish((mqttBaseTopic + "battery").c_str(), String(batteryPercent).c_str());
-                
-                // Home Assistant Discovery
-                if (config.ha_discovery && id2name[ID].length() > 0) {
-                    pub_hass_config(1, ID, 1);           // Temperature
-                    pub_hass_config(0, ID, 1);           // Humidity
-                    pub_hass_weather_config(0, ID);      // Wind Speed
-                    pub_hass_weather_config(1, ID);      // Wind Direction
-                    pub_hass_weather_config(2, ID);      // Wind Gust
-                    pub_hass_weather_config(3, ID);      // Rain
-                    pub_hass_weather_config(5, ID);      // Wind Bearing
-                    pub_hass_pressure_config(ID);        // Pressure
-                    pub_hass_uv_light_config(0, ID);     // UV Index
-                    pub_hass_uv_light_config(1, ID);     // Light
-                    pub_hass_battery_config(ID);
-                }
-                
-                frame_valid = true;
-                
-                if (config.debug_mode) {
-                    Serial.printf("[MQTT] HP1000 ID=%d Name=%s\n", ID, sensorIdentifier.c_str());
-                }
-            }
-        }
-        
-        // ========== VERSUCHE WH65B PROTOKOLL ==========
-        if (!frame_valid && config.proto_wh65b && payLoadSize == 16) {
-            WH65B::Frame wh65b_frame;
-            wh65b_frame.rssi = rssi;
-            wh65b_frame.rate = rate;
-            
-            if (WH65B::TryHandleData(payload, payLoadSize, &wh65b_frame)) {
-                WH65B::DisplayFrame(payload, payLoadSize, &wh65b_frame);
-                
-                byte ID = wh65b_frame.ID;
-                int cacheIndex = ID;
-                
-                if (cacheIndex >= 0 && cacheIndex < SENSOR_NUM) {
-                    fcache[cacheIndex].ID = ID;
-                    fcache[cacheIndex].channel = 1;
-                    fcache[cacheIndex].temp = wh65b_frame.temp;
-                    fcache[cacheIndex].humi = wh65b_frame.humi;
-                    fcache[cacheIndex].wind_speed = wh65b_frame.wind_speed;
-                    fcache[cacheIndex].wind_gust = wh65b_frame.wind_gust;
-                    fcache[cacheIndex].wind_direction = wh65b_frame.wind_direction;
-                    fcache[cacheIndex].rain_total = wh65b_frame.rain;
-                    fcache[cacheIndex].uv = wh65b_frame.uv;
-                    fcache[cacheIndex].light_lux = wh65b_frame.light_lux;
-                    fcache[cacheIndex].rssi = rssi;
-                    fcache[cacheIndex].rate = rate;
-                    fcache[cacheIndex].batlo = wh65b_frame.batlo;
-                    fcache[cacheIndex].timestamp = millis();
-                    strncpy(fcache[cacheIndex].sensorType, "WH65B", 15);
-                    fcache[cacheIndex].sensorType[15] = '\0';
-                }
-                
-                // MQTT Publishing
-                String mqttBaseTopic;
-                String sensorIdentifier;
-                
-                bool use_name_topics = (config.mqtt_use_names && id2name[ID].length() > 0);
-                
-                if (use_name_topics) {
-                    sensorIdentifier = id2name[ID];
-                    mqttBaseTopic = pretty_base + sensorIdentifier + "/";
-                } else {
-                    sensorIdentifier = String(ID, DEC);
-                    mqttBaseTopic = pub_base + sensorIdentifier + "/";
-                }
-                
-                // Publish All Data
-                mqtt_client.publish((mqttBaseTopic + "temp").c_str(), String(wh65b_frame.temp, 1).c_str());
-                mqtt_client.publish((mqttBaseTopic + "humi").c_str(), String(wh65b_frame.humi, DEC).c_str());
-                mqtt_client.publish((mqttBaseTopic + "wind_speed").c_str(), String(wh65b_frame.wind_speed, 2).c_str());
-                mqtt_client.publish((mqttBaseTopic + "wind_gust").c_str(), String(wh65b_frame.wind_gust, 2).c_str());
-                mqtt_client.publish((mqttBaseTopic + "wind_bearing").c_str(), String(wh65b_frame.wind_direction, 0).c_str());
-                mqtt_client.publish((mqttBaseTopic + "wind_direction").c_str(), GetWindDirectionText(wh65b_frame.wind_direction));
-                mqtt_client.publish((mqttBaseTopic + "rain").c_str(), String(wh65b_frame.rain, 1).c_str());
-                mqtt_client.publish((mqttBaseTopic + "uv").c_str(), String(wh65b_frame.uv, DEC).c_str());
-                mqtt_client.publish((mqttBaseTopic + "light_lux").c_str(), String(wh65b_frame.light_lux, 0).c_str());
-                
-                String state = "{\"RSSI\": " + String(rssi) + 
-                              ", \"batlo\": " + String(wh65b_frame.batlo ? "true" : "false") + 
-                              ", \"type\": \"WH65B\"}";
-                mqtt_client.publish((mqttBaseTopic + "state").c_str(), state.c_str());
-                
-                // Battery
-                int batteryPercent = wh65b_frame.batlo ? 10 : 100;
-                mqtt_client.publish((mqttBaseTopic + "battery").c_str(), String(batteryPercent).c_str());
-                
-                // Home Assistant Discovery
-                if (config.ha_discovery && id2name[ID].length() > 0) {
-                    pub_hass_config(1, ID, 1);           // Temperature
-                    pub_hass_config(0, ID, 1);           // Humidity
-                    pub_hass_weather_config(0, ID);      // Wind Speed
-                    pub_hass_weather_config(1, ID);      // Wind Direction
-                    pub_hass_weather_config(2, ID);      // Wind Gust
-                    pub_hass_weather_config(3, ID);      // Rain
-                    pub_hass_weather_config(5, ID);      // Wind Bearing
-                    pub_hass_uv_light_config(0, ID);     // UV Index
-                    pub_hass_uv_light_config(1, ID);     // Light
-                    pub_hass_battery_config(ID);
-                }
-                
-                frame_valid = true;
-                
-                if (config.debug_mode) {
-                    Serial.printf("[MQTT] WH65B ID=%d Name=%s\n", ID, sensorIdentifier.c_str());
-                }
+static void radio_task(void *arg)
+{
+    RawFrame f;
+    for (;;) {
+        ulTaskNotifyTake(pdTRUE, pdMS_TO_TICKS(RADIO_POLL_MS));
+        metrics_radio_poll();
+        int64_t poll_start = esp_timer_get_time();
+        if (SX.Receive(f.len)) {
+            f.rx_us = SX.GetReceiveTime();
+            digitalWrite(LED_BUILTIN, HIGH);
+            f.rssi = SX.GetRSSI();
+            f.rate = SX.GetDataRate();
+            if (f.len > PAYLOAD_SIZE)
+                f.len = PAYLOAD_SIZE;
+            memcpy(f.data, SX.GetPayloadPointer(), f.len);
+            SX.EnableReceiver(true);
+            if (!boot_times.first_frame)
+                boot_times.first_frame = millis();
+            metrics.radio_frames++;
+            if (xQueueSend(raw_queue, &f, 0) == pdTRUE) {
+                metrics_queue_depth(MQ_RAW, uxQueueMessagesWaiting(raw_queue));
+            } else {
+                metrics.queues[MQ_RAW].dropped++;
+                digitalWrite(LED_BUILTIN, LOW);
             }
+            perf_record(PERF_RADIO, esp_timer_get_time() - poll_start);
         }
 
-        // Falls kein Protokoll erkannt wurde
-        if (!frame_valid) {
-            static unsigned long last;
-            LaCrosse::DisplayRaw(last, "Unknown", payload, payLoadSize, rssi, rate);
+        unsigned long now = millis();
+        if (now - last_switch > config.toggle_interval_ms) {
+            SX.NextDataRate();
+            metrics_rate_switch(SX.GetDataRate());
+            last_switch = now;
         }
     }
+}
 
-    if (!showing_starfield) {
-        update_display(&lacrosse_frame);
+/* Decode-Task: einziger Schreiber von fcache (Seqlock in globals.h) */
+static void decode_task(void *arg)
+{
+    RawFrame f;
+    for (;;) {
+        if (xQueueReceive(raw_queue, &f, pdMS_TO_TICKS(1000)) == pdTRUE) {
+            decode_rx_us = f.rx_us;
+            trace_begin(f.rx_us);
+            {
+                PerfTimer t(PERF_DECODE);
+                handle_frame(&f);
+            }
+            trace_end();
+            decode_rx_us = 0;
+            metrics_observe_decode(esp_timer_get_time() - f.rx_us);
+        }
+        PerfTimer t(PERF_EXPIRE);
+        expire_cache();
     }
-    
-    SX.EnableReceiver(true);
-    digitalWrite(LED_BUILTIN, LOW);
 }
 
-void setup(void)
+/* Latenz-Report (frametrace.h) als Diagnose-Topic, retained */
+#define DIAG_INTERVAL_MS 60000
+
+static void publish_diagnostics()
 {
-    char tmp[32];
-    snprintf(tmp, 31, "lacrosse2mqtt_%06lX", (long)(ESP.getEfuseMac() >> 24));
-    mqtt_id = String(tmp);
-    for (int i = 0; i < SENSOR_NUM; i++) {
-        memset(&fcache[i], 0, sizeof(Cache));  // Alles auf 0
-        fcache[i].wind_direction = -1;         // ← WICHTIG: Ungültig markieren
-        fcache[i].ID = 0xFF;                   // Ungültige ID
-    }
-    config.mqtt_port = 1883;
-    Serial.begin(115200);
+    JsonDocument doc;
+    doc["uptime"] = uptime_sec();
+    trace_report(doc["latency_us"].to<JsonObject>());
+    heap_report(doc["heap"].to<JsonObject>(), false);
+    String out;
+    serializeJson(doc, out);
+    mqtt_send((pub_base + "diagnostics").c_str(), out.c_str(), true);
+}
 
+/* WLAN, NTP und Webserver im Netzwerk-Task: Empfang und Dekodierung
+ * laufen schon, Werte sammeln sich in fcache und der Publish-Queue.
+ * autoConnect() blockiert nur diesen Task, auch im Konfigurationsportal. */
+static void network_start()
+{
     WiFiManager wifiManager;
     if (!wifiManager.autoConnect("Lacrosse2mqttAP")) {
       Serial.println("Failed to connect and hit timeout");
       ESP.restart();
       delay(1000);
     }
+    boot_times.wifi = millis();
 
     Serial.println("Connected to WiFi!");
     Serial.print("Verbundenes WLAN: ");
@@ -1613,139 +1393,83 @@ void setup(void)
     Serial.println(WiFi.localIP());
 
     setup_ntp();
-
-    littlefs_ok = LittleFS.begin(FORMAT_LITTLEFS_IF_FAILED);
-    if (!littlefs_ok)
-        Serial.println("LittleFS Mount Failed");
     setup_web();
-
-    if (config.debug_mode) {
-        Serial.println("Debug Mode ENABLED");
-    }
-
-    pinMode(KEY_BUILTIN, INPUT);
-    pinMode(LED_BUILTIN, OUTPUT);
-    Wire.begin(OLED_SDA, OLED_SCL);
-    
-    if(!display.begin(SSD1306_SWITCHCAPVCC, 0x3C)) {
-        Serial.println(F("SSD1306 allocation failed"));
-        for(;;);
-    }
-    
-    display.clearDisplay();
-    display.setTextSize(1);
-    display.setTextColor(SSD1306_WHITE);
-
-    delay(1000);
-
-    Serial.println("TTGO LORA lacrosse2mqtt converter");
-    Serial.println(mqtt_id);
-    
-    init_starfield();
-    unsigned long boot_animation_start = millis();
-    while (millis() - boot_animation_start < 3000) {
-        draw_starfield();
-        delay(100);
-    }
-
-    display.clearDisplay();
-    display.setCursor(0, 0);
-    display.println("LaCrosse2mqtt");
-    display.println("Starting...");
-    display.display();
-    delay(2000);
-
-    last_switch = millis();
-
-    if (!SX.init()) {
-        Serial.println("** SX127x init failed! **");
-        display.println("** SX127x init failed! **");
-        display.display();
-        while(true)
-            delay(1000);
-    }
-
-    bool use_17241 = config.proto_lacrosse;
-    bool use_9579 = config.proto_tx35it;
-    bool use_8842 = config.proto_tx38it;
-    bool use_6618 = config.proto_wh1080; // || config.proto_hp1000 || config.proto_wh65b;
-    bool use_4800 = config.proto_tx22it;
-    SX.SetActiveDataRates(use_17241, use_9579, use_8842, use_6618, use_4800);
-
-    SX.SetupForLaCrosse();
-    SX.SetFrequency(freq);
-    SX.NextDataRate(0);
-    SX.EnableReceiver(true);
 }
 
-uint32_t check_button()
+/* Netzwerk-Task: besitzt mqtt_client, sendet die Publish-Queue */
+static void network_task(void *arg)
 {
-    static uint32_t low_at = 0;
-    static bool pressed = false;
-    static uint32_t last_check = 0;
-    
-    uint32_t now = millis();
-    if (now - last_check < 50) {
-        return 0;
-    }
-    last_check = now;
-    
-    if (digitalRead(KEY_BUILTIN) == LOW) {
-        if (! pressed)
-            low_at = now;
-        pressed = true;
-        return 0;
-    }
-    if (! pressed)
-        return 0;
-    pressed = false;
-    return now - low_at;
-}
+    MqttMsg *msg;
+    unsigned long last_diag = 0;
+    network_start();
+    for (;;) {
+        {
+            PerfTimer t(PERF_NETWORK);
+            check_mqtt();
+            check_wifi_status();
+            check_ntp_sync();
+            mqtt_client.loop();
+        }
 
-void check_wifi_status()
-{
-    wl_status_t current_status = WiFi.status();
-    if (current_status != last_wifi_status) {
-        Serial.printf("WiFi status changed: %d -> %d\n", last_wifi_status, current_status);
-        
-        if (current_status == WL_CONNECTED) {
-            Serial.println("WiFi: Connected");
-            auto_display_on = uptime_sec();
-        } else if (last_wifi_status == WL_CONNECTED) {
-            Serial.println("WiFi: Disconnected");
-            auto_display_on = uptime_sec();
+        if (mqtt_ok && millis() - last_diag > DIAG_INTERVAL_MS) {
+            publish_diagnostics();
+            last_diag = millis();
+        }
+
+        if (!mqtt_ok) {
+            // Queue fuellt sich, bei Ueberlauf verwirft mqtt_publish()
+            delay(100);
+            continue;
+        }
+        // warten bis etwas anliegt, spaetestens nach 100ms wieder loop()
+        if (xQueuePeek(publish_queue, &msg, pdMS_TO_TICKS(100)) != pdTRUE)
+            continue;
+        while (mqtt_client.connected() && xQueueReceive(publish_queue, &msg, 0) == pdTRUE) {
+            int64_t send_start = esp_timer_get_time();
+            mqtt_send(msg->topic, msg->payload, msg->retain);
+            perf_record(PERF_PUBLISH, esp_timer_get_time() - send_start);
+            trace_written(msg->rx_us);
+            if (msg->rx_us)
+                metrics_observe_latency(esp_timer_get_time() - msg->rx_us);
+            __atomic_store_n(&publish_tail, msg->end, __ATOMIC_RELEASE);
         }
-        
-        last_wifi_status = current_status;
     }
 }
 
-void loop(void)
+/* Ein Durchlauf des Display-Tasks: Bildschirm oder Sternenfeld waehlen,
+ * in den Puffer zeichnen, oled_flush() sendet nur die Aenderungen */
+static void display_step()
 {
     static unsigned long last_starfield_update = 0;
     static uint32_t last_interaction = 0;  
     static bool interaction_initialized = false;
     static uint32_t last_wifi_display = 0;
     
-    delay(10);
-    
-    handle_client();
-
-    uint32_t button_time = check_button();
-    if (button_time > 100 && button_time <= 2000) {
-        if (!config.display_on) {
-            auto_display_on = uptime_sec();
-        }
+    if (display_wake) {
+        display_wake = false;
         showing_starfield = false;
+        showing_splash = false;
         last_interaction = uptime_sec();
         update_display(NULL);
     }
 
-    receive();
-    check_repeatedjobs();
-    expire_cache();
-    check_wifi_status();
-    check_ntp_sync();
+    if (showing_splash) {
+        static unsigned long last_frame = 0;
+        if (millis() - last_frame > 100) {
+            last_frame = millis();
+            draw_starfield();
+        }
+        if (millis() < SPLASH_MS)
+            return;
+        showing_splash = false;
+        update_display(NULL);
+    }
+
+    static uint32_t shown_seq = 0;
+    if (sensor_seq != shown_seq && !showing_starfield) {
+        shown_seq = sensor_seq;
+        update_display(NULL);
+    }
     
     unsigned long now = millis();
     uint32_t uptime = uptime_sec();
@@ -1759,14 +1483,16 @@ void loop(void)
     bool has_critical_error = false;
     bool has_recent_data = false;
     
+    Cache c;
     for (int i = 0; i < SENSOR_NUM; i++) {
-        if (fcache[i].timestamp > 0) {
-            unsigned long age = now - fcache[i].timestamp;
+        cache_read(i, &c);
+        if (c.timestamp > 0) {
+            unsigned long age = cache_age(c, now);
             
             if (age < 300000) {
                 has_recent_data = true;
                 
-                if (fcache[i].batlo) {
+                if (c.batlo) {
                     has_critical_error = true;
                     static bool battery_error_reported[SENSOR_NUM] = {false};
                     if (!battery_error_reported[i]) {
@@ -1836,23 +1562,178 @@ void loop(void)
     } else {
         showing_starfield = false;
     }
+}
+
+void display_task(void *arg)
+{
+    for (;;) {
+        vTaskDelay(pdMS_TO_TICKS(DISPLAY_TASK_MS));
+        display_step();
+    }
+}
+
+void start_pipeline()
+{
+    TaskHandle_t handle;
+
+    LaCrosse::TX141Reset(&tx141_lock);
+    snapshot_restore(&tx141_lock);
+    xTaskCreatePinnedToCore(decode_task, "decode", DECODE_TASK_STACK, NULL,
+                            DECODE_TASK_PRIO, &handle, DECODE_TASK_CORE);
+    metrics_register_task(MT_DECODE, handle);
+    xTaskCreatePinnedToCore(network_task, "network", NETWORK_TASK_STACK, NULL,
+                            NETWORK_TASK_PRIO, &handle, NETWORK_TASK_CORE);
+    metrics_register_task(MT_NETWORK, handle);
+    xTaskCreatePinnedToCore(radio_task, "radio", RADIO_TASK_STACK, NULL,
+                            RADIO_TASK_PRIO, &radio_task_handle, RADIO_TASK_CORE);
+    metrics_register_task(MT_RADIO, radio_task_handle);
+    metrics_register_task(MT_UI, xTaskGetCurrentTaskHandle());
+    perf_start_cpu_load();
+
+    pinMode(LORA_IRQ, INPUT);
+    attachInterrupt(digitalPinToInterrupt(LORA_IRQ), radio_isr, RISING);
+}
+
+void setup(void)
+{
+    char tmp[32];
+    snprintf(tmp, 31, "lacrosse2mqtt_%06lX", (long)(ESP.getEfuseMac() >> 24));
+    mqtt_id = String(tmp);
+    boot_epoch = esp_random();
+    state_mutex = xSemaphoreCreateMutex();
+    raw_queue = xQueueCreate(RAW_QUEUE_LEN, sizeof(RawFrame));
+    publish_queue = xQueueCreate(PUBLISH_QUEUE_LEN, sizeof(MqttMsg *));
+    publish_mutex = xSemaphoreCreateMutex();
+    metrics_register_queue(MQ_RAW, raw_queue, RAW_QUEUE_LEN);
+    metrics_register_queue(MQ_PUBLISH, publish_queue, PUBLISH_QUEUE_LEN);
+    for (int i = 0; i < SENSOR_NUM; i++) {
+        memset(&fcache[i], 0, sizeof(Cache));  // Alles auf 0
+        fcache[i].wind_direction = -1;         // ← WICHTIG: Ungültig markieren
+        fcache[i].ID = 0xFF;                   // Ungültige ID
+    }
+    Serial.begin(115200);
+    log_start();
+    history_init();
+
+    // Funkmodul zuerst, WLAN/NTP/MQTT kommen im Netzwerk-Task nach
+    littlefs_ok = LittleFS.begin(FORMAT_LITTLEFS_IF_FAILED);
+    if (!littlefs_ok)
+        Serial.println("LittleFS Mount Failed");
+    setup_config();
+
+    log_set_level(config.debug_mode ? LL_DEBUG : LL_INFO);
+    log_set_sink(log_to_mqtt);
+    frame_set_sink(frame_to_mqtt);
+    if (config.debug_mode) {
+        Serial.println("Debug Mode ENABLED");
+    }
+
+    pinMode(KEY_BUILTIN, INPUT);
+    pinMode(LED_BUILTIN, OUTPUT);
+    Wire.begin(OLED_SDA, OLED_SCL);
     
-    loop_count++;
+    if(!display.begin(SSD1306_SWITCHCAPVCC, 0x3C)) {
+        Serial.println(F("SSD1306 allocation failed"));
+        for(;;);
+    }
+    oled_init(0x3C);
     
-    if (millis() - last_cpu_check > 1000) {
-        if (loop_count >= 80) {
-            cpu_usage = 15.0;
-        } else if (loop_count >= 60) {
-            cpu_usage = 30.0;
-        } else if (loop_count >= 40) {
-            cpu_usage = 50.0;
-        } else if (loop_count >= 20) {
-            cpu_usage = 70.0;
-        } else {
-            cpu_usage = 90.0;
+    display.clearDisplay();
+    display.setTextSize(1);
+    display.setTextColor(SSD1306_WHITE);
+
+    Serial.println("TTGO LORA lacrosse2mqtt converter");
+    Serial.println(mqtt_id);
+    
+    display.setCursor(0, 0);
+    display.println("LaCrosse2mqtt");
+    display.println("Starting...");
+    oled_flush(display);
+
+    last_switch = millis();
+
+    if (!SX.init()) {
+        Serial.println("** SX127x init failed! **");
+        display.println("** SX127x init failed! **");
+        oled_flush(display);
+        while(true)
+            delay(1000);
+    }
+
+    bool use_17241 = config.proto_lacrosse;
+    bool use_9579 = config.proto_tx35it;
+    bool use_8842 = config.proto_tx38it;
+    bool use_6618 = config.proto_wh1080; // || config.proto_hp1000 || config.proto_wh65b;
+    bool use_4800 = config.proto_tx22it;
+    SX.SetActiveDataRates(use_17241, use_9579, use_8842, use_6618, use_4800);
+
+    SX.SetupForLaCrosse();
+    SX.SetFrequency(freq);
+    SX.NextDataRate(0);
+    metrics_rate_switch(SX.GetDataRate());
+    SX.EnableReceiver(true);
+    boot_times.radio = millis();
+
+    start_pipeline();
+    // Verlauf aus LittleFS im eigenen Task, der Empfang laeuft schon
+    histlog_start();
+
+    // Boot-Animation laeuft im Display-Task weiter
+    init_starfield();
+    showing_splash = true;
+    TaskHandle_t handle;
+    xTaskCreatePinnedToCore(display_task, "display", DISPLAY_TASK_STACK, NULL,
+                            DISPLAY_TASK_PRIO, &handle, DISPLAY_TASK_CORE);
+    metrics_register_task(MT_DISPLAY, handle);
+}
+
+uint32_t check_button()
+{
+    static uint32_t low_at = 0;
+    static bool pressed = false;
+    static uint32_t last_check = 0;
+    
+    uint32_t now = millis();
+    if (now - last_check < 50) {
+        return 0;
+    }
+    last_check = now;
+    
+    if (digitalRead(KEY_BUILTIN) == LOW) {
+        if (! pressed)
+            low_at = now;
+        pressed = true;
+        return 0;
+    }
+    if (! pressed)
+        return 0;
+    pressed = false;
+    return now - low_at;
+}
+
+void loop(void)
+{
+    delay(10);
+    uint32_t loop_start = micros();
+
+    // Empfang, MQTT, WLAN und NTP laufen in eigenen Tasks (pipeline.h),
+    // das Display im Display-Task; loop() bleibt fuer den Taster
+    uint32_t button_time = check_button();
+    if (button_time > 100 && button_time <= 2000) {
+        if (!config.display_on) {
+            auto_display_on = uptime_sec();
         }
-        
-        loop_count = 0;
+        display_wake = true;
+    }
+
+    if (millis() - last_cpu_check > 1000) {
+        // gemessene Last (Tick-Hook, perfstats.cpp), der hoehere Kern zaehlt
+        perf_update_cpu_load();
+        cpu_usage = max(perf_cpu_load(0), perf_cpu_load(1));
         last_cpu_check = millis();
     }
+
+    snapshot_poll();
+    heap_poll();
+    metrics_observe_loop(micros() - loop_start);
 }
\ No newline at end of file
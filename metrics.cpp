@@ -0,0 +1,465 @@
+/*
+ * Prometheus / OpenMetrics text exposition of gateway counters and
+ * per-sensor gauges. Output is rendered into a small stack buffer and
+ * handed to the caller in chunks, so nothing is built up on the heap.
+ */
+#include "metrics.h"
+#include "globals.h"
+#include "perfstats.h"
+#include "frametrace.h"
+#include "asynclog.h"
+#include "history.h"
+#include "histlog.h"
+#include "snapshot.h"
+#include "heapmon.h"
+#include "oled.h"
+#include <stdarg.h>
+
+Metrics metrics;
+
+static const char *proto_names[PROTO_NUM] = {
+    "lacrosse", "wh1080", "ws1600", "wt440xh", "tx22it",
+    "emt7110", "w136", "hp1000", "wh65b"
+};
+
+static const char *task_names[MT_NUM] = { "radio", "decode", "network", "web", "ui", "display" };
+static const char *queue_names[MQ_NUM] = { "raw", "publish" };
+
+static const int rate_values[METRICS_RATE_NUM] = { 17241, 9579, 8842, 6618, 4800 };
+
+static const uint32_t loop_bounds_us[METRICS_LOOP_BUCKETS] = {
+    100, 250, 500, 1000, 2500, 5000, 10000, 25000, 50000, 100000, 250000
+};
+
+extern bool mqtt_ok;
+
+static int rate_index(int rate)
+{
+    for (int i = 0; i < METRICS_RATE_NUM; i++)
+        if (rate_values[i] == rate)
+            return i;
+    return -1;
+}
+
+void metrics_rate_switch(int new_rate)
+{
+    unsigned long now = millis();
+    int idx = rate_index(metrics.current_rate);
+    if (idx >= 0)
+        metrics.rate_dwell_ms[idx] += now - metrics.rate_since;
+    metrics.current_rate = new_rate;
+    metrics.rate_since = now;
+}
+
+void metrics_observe_loop(uint32_t us)
+{
+    int b = 0;
+    while (b < METRICS_LOOP_BUCKETS && us > loop_bounds_us[b])
+        b++;
+    metrics.loop_buckets[b]++;
+    metrics.loop_sum_us += us;
+    metrics.loop_count++;
+}
+
+/* a frame waiting in the FIFO blocks reception of the next one, so the
+ * longest gap between two polls tells if anything starved the radio */
+void metrics_radio_poll()
+{
+    uint32_t now = micros();
+    if (metrics.last_poll_us != 0 && now - metrics.last_poll_us > metrics.poll_gap_max_us)
+        metrics.poll_gap_max_us = now - metrics.last_poll_us;
+    metrics.last_poll_us = now;
+}
+
+void metrics_register_task(MetricsTask t, TaskHandle_t handle)
+{
+    metrics.tasks[t] = handle;
+}
+
+void metrics_register_queue(MetricsQueue q, QueueHandle_t handle, uint32_t size)
+{
+    metrics.queues[q].handle = handle;
+    metrics.queues[q].size = size;
+}
+
+void metrics_queue_depth(MetricsQueue q, uint32_t depth)
+{
+    if (depth > metrics.queues[q].max_depth)
+        metrics.queues[q].max_depth = depth;
+}
+
+void metrics_observe_decode(int64_t us)
+{
+    metrics.decode_sum_us += us;
+    metrics.decode_count++;
+    if (us > metrics.decode_max_us)
+        metrics.decode_max_us = us;
+}
+
+void metrics_observe_latency(int64_t us)
+{
+    metrics.latency_sum_us += us;
+    metrics.latency_count++;
+    if (us > metrics.latency_max_us)
+        metrics.latency_max_us = us;
+}
+
+class MetricsOut {
+public:
+    MetricsOut(metrics_sink_t sink) : m_sink(sink), m_len(0) {}
+    ~MetricsOut() { flush(); }
+
+    void printf(const char *fmt, ...) __attribute__((format(printf, 2, 3)))
+    {
+        va_list ap;
+        va_start(ap, fmt);
+        int n = vsnprintf(m_buf + m_len, sizeof(m_buf) - m_len, fmt, ap);
+        va_end(ap);
+        if (n < 0)
+            return;
+        if (m_len + n >= sizeof(m_buf)) {
+            /* did not fit: send what we have and format again */
+            flush();
+            va_start(ap, fmt);
+            n = vsnprintf(m_buf, sizeof(m_buf), fmt, ap);
+            va_end(ap);
+            if (n < 0)
+                return;
+            if ((size_t)n >= sizeof(m_buf))
+                n = sizeof(m_buf) - 1; /* truncated line, should not happen */
+        }
+        m_len += n;
+    }
+
+    void header(const char *name, const char *type, const char *help)
+    {
+        printf("# HELP %s %s\n# TYPE %s %s\n", name, help, name, type);
+    }
+
+    void flush()
+    {
+        if (m_len == 0)
+            return;
+        m_sink(m_buf, m_len);
+        m_len = 0;
+    }
+
+private:
+    metrics_sink_t m_sink;
+    char m_buf[1024];
+    size_t m_len;
+};
+
+/* label values must not contain raw quotes, backslashes or newlines */
+static void escape_label(char *dst, size_t size, const char *src)
+{
+    size_t o = 0;
+    for (; *src && o + 2 < size; src++) {
+        if (*src == '"' || *src == '\\') {
+            dst[o++] = '\\';
+            dst[o++] = *src;
+        } else if (*src == '\n') {
+            dst[o++] = '\\';
+            dst[o++] = 'n';
+        } else {
+            dst[o++] = *src;
+        }
+    }
+    dst[o] = '\0';
+}
+
+/* copies entry i via the seqlock, true if it holds a live sensor */
+static bool read_sensor(int i, Cache *c)
+{
+    cache_read(i, c);
+    return !(c->timestamp == 0 || c->ID == 0xFF || c->rate == 0);
+}
+
+/* labels are rebuilt per line instead of cached, 256 x label would not fit the stack */
+static const char *sensor_labels(const Cache &c)
+{
+    static char labels[112];
+    char name[48];
+    escape_label(name, sizeof(name), sensor_name(c.ID));
+    snprintf(labels, sizeof(labels), "id=\"%d\",name=\"%s\",type=\"%s\"",
+             c.ID, name, str_get(c.type));
+    return labels;
+}
+
+/* Prometheus wants all samples of a family together, so every family walks
+ * the cache once. Each entry is copied via the seqlock, never read in place. */
+static void write_sensor_gauges(MetricsOut &out)
+{
+    unsigned long now = millis();
+    Cache c;
+
+    out.header("lacrosse_sensor_last_seen_seconds", "gauge", "Seconds since the last frame of this sensor");
+    for (int i = 0; i < SENSOR_NUM; i++)
+        if (read_sensor(i, &c))
+            out.printf("lacrosse_sensor_last_seen_seconds{%s} %.3f\n", sensor_labels(c), cache_age(c, now) / 1000.0);
+
+    out.header("lacrosse_sensor_rssi_dbm", "gauge", "RSSI of the last frame");
+    for (int i = 0; i < SENSOR_NUM; i++)
+        if (read_sensor(i, &c))
+            out.printf("lacrosse_sensor_rssi_dbm{%s} %d\n", sensor_labels(c), c.rssi);
+
+    out.header("lacrosse_sensor_battery_low", "gauge", "Weak battery flag");
+    for (int i = 0; i < SENSOR_NUM; i++)
+        if (read_sensor(i, &c))
+            out.printf("lacrosse_sensor_battery_low{%s} %d\n", sensor_labels(c), c.batlo ? 1 : 0);
+
+    out.header("lacrosse_sensor_temperature_celsius", "gauge", "Temperature");
+    for (int i = 0; i < SENSOR_NUM; i++) {
+        if (!read_sensor(i, &c))
+            continue;
+        if (c.temp_timestamp)
+            out.printf("lacrosse_sensor_temperature_celsius{%s,channel=\"1\"} %.1f\n", sensor_labels(c), c.temp);
+        if (c.timestamp_ch2 && c.temp_ch2 > -100 && c.temp_ch2 < 100)
+            out.printf("lacrosse_sensor_temperature_celsius{%s,channel=\"2\"} %.1f\n", sensor_labels(c), c.temp_ch2);
+    }
+
+    out.header("lacrosse_sensor_humidity_percent", "gauge", "Relative humidity");
+    for (int i = 0; i < SENSOR_NUM; i++)
+        if (read_sensor(i, &c) && c.humi > 0 && c.humi <= 100)
+            out.printf("lacrosse_sensor_humidity_percent{%s} %d\n", sensor_labels(c), c.humi);
+
+    out.header("lacrosse_sensor_wind_speed", "gauge", "Wind speed");
+    for (int i = 0; i < SENSOR_NUM; i++)
+        if (read_sensor(i, &c) && c.wind_timestamp)
+            out.printf("lacrosse_sensor_wind_speed{%s} %.1f\n", sensor_labels(c), c.wind_speed);
+
+    out.header("lacrosse_sensor_wind_direction_degrees", "gauge", "Wind direction");
+    for (int i = 0; i < SENSOR_NUM; i++)
+        if (read_sensor(i, &c) && c.wind_timestamp && c.wind_direction >= 0 && c.wind_direction <= 360)
+            out.printf("lacrosse_sensor_wind_direction_degrees{%s} %d\n", sensor_labels(c), c.wind_direction);
+
+    out.header("lacrosse_sensor_rain_mm", "gauge", "Rain counter");
+    for (int i = 0; i < SENSOR_NUM; i++)
+        if (read_sensor(i, &c) && c.rain_timestamp)
+            out.printf("lacrosse_sensor_rain_mm{%s} %.1f\n", sensor_labels(c), c.rain_total);
+
+    out.header("lacrosse_sensor_power_watts", "gauge", "Electrical power");
+    for (int i = 0; i < SENSOR_NUM; i++)
+        if (read_sensor(i, &c) && c.power_timestamp)
+            out.printf("lacrosse_sensor_power_watts{%s} %.1f\n", sensor_labels(c), c.power);
+
+    out.header("lacrosse_sensor_pressure_hpa", "gauge", "Air pressure");
+    for (int i = 0; i < SENSOR_NUM; i++)
+        if (read_sensor(i, &c) && c.pressure_timestamp)
+            out.printf("lacrosse_sensor_pressure_hpa{%s} %.1f\n", sensor_labels(c), c.pressure);
+}
+
+void metrics_write(metrics_sink_t sink)
+{
+    MetricsOut out(sink);
+
+    out.header("lacrosse_frames_total", "counter", "Valid frames received per protocol");
+    for (int p = 0; p < PROTO_NUM; p++)
+        out.printf("lacrosse_frames_total{protocol=\"%s\"} %lu\n", proto_names[p], (unsigned long)metrics.frames[p]);
+
+    out.header("lacrosse_crc_errors_total", "counter", "Frames with matching header but bad checksum");
+    for (int p = 0; p < PROTO_NUM; p++)
+        out.printf("lacrosse_crc_errors_total{protocol=\"%s\"} %lu\n", proto_names[p], (unsigned long)metrics.crc_errors[p]);
+
+    out.header("lacrosse_repeated_frames_total", "counter", "Repeated transmissions dropped before cache and MQTT");
+    for (int p = 0; p < PROTO_NUM; p++)
+        out.printf("lacrosse_repeated_frames_total{protocol=\"%s\"} %lu\n", proto_names[p], (unsigned long)metrics.repeats[p]);
+
+    out.header("lacrosse_fec_corrected_total", "counter", "LaCrosse frames with a single-bit error repaired via the CRC");
+    out.printf("lacrosse_fec_corrected_total %lu\n", (unsigned long)metrics.fec_corrected);
+
+    out.header("lacrosse_fec_rejected_total", "counter", "Repaired LaCrosse frames dropped as implausible");
+    out.printf("lacrosse_fec_rejected_total %lu\n", (unsigned long)metrics.fec_rejected);
+
+    out.header("lacrosse_tx141_rejected_total", "counter", "TX141 frames out of range for the learned temperature format");
+    out.printf("lacrosse_tx141_rejected_total %lu\n", (unsigned long)metrics.tx141_rejected);
+
+    out.header("lacrosse_tx141_relearned_total", "counter", "TX141 sensors sent back to learning after repeated misses");
+    out.printf("lacrosse_tx141_relearned_total %lu\n", (unsigned long)metrics.tx141_relearned);
+
+    out.header("lacrosse_outliers_held_total", "counter", "Sensor values held back by the outlier filter");
+    out.printf("lacrosse_outliers_held_total %lu\n", (unsigned long)metrics.outliers_held);
+
+    out.header("lacrosse_radio_frames_total", "counter", "Frames read from the radio, valid or not");
+    out.printf("lacrosse_radio_frames_total %lu\n", (unsigned long)metrics.radio_frames);
+
+    out.header("lacrosse_unknown_frames_total", "counter", "Frames no decoder accepted");
+    out.printf("lacrosse_unknown_frames_total %lu\n", (unsigned long)metrics.unknown_frames);
+
+    out.header("lacrosse_rejected_frames_total", "counter", "Frames dropped before decoding");
+    out.printf("lacrosse_rejected_frames_total %lu\n", (unsigned long)metrics.rejected_frames);
+
+    out.header("lacrosse_fifo_overruns_total", "counter", "Radio FIFO overruns");
+    out.printf("lacrosse_fifo_overruns_total %lu\n", (unsigned long)metrics.fifo_overruns);
+
+    out.header("lacrosse_radio_poll_gap_max_seconds", "gauge", "Longest time between two radio polls since boot");
+    out.printf("lacrosse_radio_poll_gap_max_seconds %.6f\n", metrics.poll_gap_max_us / 1e6);
+
+    out.header("lacrosse_rate_dwell_seconds_total", "counter", "Time the receiver spent on each data rate");
+    unsigned long now = millis();
+    for (int r = 0; r < METRICS_RATE_NUM; r++) {
+        uint64_t ms = metrics.rate_dwell_ms[r];
+        if (rate_values[r] == metrics.current_rate)
+            ms += now - metrics.rate_since;
+        out.printf("lacrosse_rate_dwell_seconds_total{rate=\"%d\"} %.3f\n", rate_values[r], ms / 1000.0);
+    }
+
+    out.header("lacrosse_current_datarate_bps", "gauge", "Data rate the receiver is tuned to");
+    out.printf("lacrosse_current_datarate_bps %d\n", metrics.current_rate);
+
+    write_sensor_gauges(out);
+
+    out.header("lacrosse_mqtt_published_total", "counter", "MQTT messages handed to the broker connection");
+    out.printf("lacrosse_mqtt_published_total %lu\n", (unsigned long)metrics.mqtt_published);
+    out.header("lacrosse_mqtt_failed_total", "counter", "MQTT publishes that failed");
+    out.printf("lacrosse_mqtt_failed_total %lu\n", (unsigned long)metrics.mqtt_failed);
+    out.header("lacrosse_mqtt_reconnects_total", "counter", "Successful MQTT (re)connects");
+    out.printf("lacrosse_mqtt_reconnects_total %lu\n", (unsigned long)metrics.mqtt_reconnects);
+    out.header("lacrosse_mqtt_connected", "gauge", "MQTT connection state");
+    out.printf("lacrosse_mqtt_connected %d\n", mqtt_ok ? 1 : 0);
+
+    out.header("lacrosse_queue_depth", "gauge", "Messages waiting in a pipeline queue");
+    for (int q = 0; q < MQ_NUM; q++)
+        if (metrics.queues[q].handle)
+            out.printf("lacrosse_queue_depth{queue=\"%s\"} %lu\n", queue_names[q],
+                       (unsigned long)uxQueueMessagesWaiting(metrics.queues[q].handle));
+    out.header("lacrosse_queue_depth_max", "gauge", "Highest queue depth seen since boot");
+    for (int q = 0; q < MQ_NUM; q++)
+        out.printf("lacrosse_queue_depth_max{queue=\"%s\"} %lu\n", queue_names[q], (unsigned long)metrics.queues[q].max_depth);
+    out.header("lacrosse_queue_size", "gauge", "Queue capacity");
+    for (int q = 0; q < MQ_NUM; q++)
+        out.printf("lacrosse_queue_size{queue=\"%s\"} %lu\n", queue_names[q], (unsigned long)metrics.queues[q].size);
+    out.header("lacrosse_queue_dropped_total", "counter", "Items dropped because a queue was full");
+    for (int q = 0; q < MQ_NUM; q++)
+        out.printf("lacrosse_queue_dropped_total{queue=\"%s\"} %lu\n", queue_names[q], (unsigned long)metrics.queues[q].dropped);
+
+    out.header("lacrosse_task_stack_free_bytes", "gauge", "Lowest free stack of a task since start");
+    for (int t = 0; t < MT_NUM; t++)
+        if (metrics.tasks[t])
+            out.printf("lacrosse_task_stack_free_bytes{task=\"%s\"} %lu\n", task_names[t],
+                       (unsigned long)uxTaskGetStackHighWaterMark(metrics.tasks[t]));
+
+    out.header("lacrosse_decode_latency_seconds", "summary", "Radio read until frame decoded and cached");
+    out.printf("lacrosse_decode_latency_seconds_sum %.6f\n", metrics.decode_sum_us / 1e6);
+    out.printf("lacrosse_decode_latency_seconds_count %lu\n", (unsigned long)metrics.decode_count);
+    out.header("lacrosse_decode_latency_max_seconds", "gauge", "Slowest decode since boot");
+    out.printf("lacrosse_decode_latency_max_seconds %.6f\n", metrics.decode_max_us / 1e6);
+
+    out.header("lacrosse_publish_latency_seconds", "summary", "Radio read until MQTT message handed to the broker");
+    out.printf("lacrosse_publish_latency_seconds_sum %.6f\n", metrics.latency_sum_us / 1e6);
+    out.printf("lacrosse_publish_latency_seconds_count %lu\n", (unsigned long)metrics.latency_count);
+    out.header("lacrosse_publish_latency_max_seconds", "gauge", "Slowest publish since boot");
+    out.printf("lacrosse_publish_latency_max_seconds %.6f\n", metrics.latency_max_us / 1e6);
+
+    out.header("lacrosse_history_series", "gauge", "Sensor values with a history in PSRAM");
+    out.printf("lacrosse_history_series %u\n", (unsigned)hist_stats.series);
+    out.header("lacrosse_history_series_bytes", "gauge", "Fixed PSRAM size of one history series (24 h raw, 24 h minutes, 30 d hours)");
+    out.printf("lacrosse_history_series_bytes %u\n", (unsigned)HIST_SERIES_BYTES);
+    out.header("lacrosse_history_bytes", "gauge", "PSRAM used by the history");
+    out.printf("lacrosse_history_bytes %lu\n", (unsigned long)hist_stats.bytes);
+    out.header("lacrosse_history_samples_total", "counter", "Values added to the history");
+    out.printf("lacrosse_history_samples_total %lu\n", (unsigned long)hist_stats.samples);
+    out.header("lacrosse_history_stored_total", "counter", "Values stored as raw samples (unchanged values are skipped)");
+    out.printf("lacrosse_history_stored_total %lu\n", (unsigned long)hist_stats.stored);
+    out.header("lacrosse_history_dropped_total", "counter", "Values not added to the history");
+    out.printf("lacrosse_history_dropped_total %lu\n", (unsigned long)hist_stats.dropped);
+    out.header("lacrosse_history_raw_retention_seconds", "gauge", "Raw history span of the series that fills its ring fastest (86400 = full 24 h)");
+    out.printf("lacrosse_history_raw_retention_seconds %lu\n", (unsigned long)history_raw_retention());
+    out.header("lacrosse_histlog_bytes", "gauge", "History segment log size on LittleFS");
+    out.printf("lacrosse_histlog_bytes %lu\n", (unsigned long)histlog_stats.bytes);
+    out.header("lacrosse_histlog_segments", "gauge", "History segment files on LittleFS");
+    out.printf("lacrosse_histlog_segments %u\n", (unsigned)histlog_stats.segments);
+    out.header("lacrosse_histlog_pages_total", "counter", "History pages written to flash");
+    out.printf("lacrosse_histlog_pages_total %lu\n", (unsigned long)histlog_stats.pages);
+    out.header("lacrosse_histlog_dropped_total", "counter", "History entries not written to flash");
+    out.printf("lacrosse_histlog_dropped_total %lu\n", (unsigned long)histlog_stats.dropped);
+    out.header("lacrosse_histlog_compactions_total", "counter", "Raw segments compacted to hourly values");
+    out.printf("lacrosse_histlog_compactions_total %lu\n", (unsigned long)histlog_stats.compactions);
+    out.header("lacrosse_histlog_evicted_segments_total", "counter", "Oldest segments removed because the segment table was full");
+    out.printf("lacrosse_histlog_evicted_segments_total %lu\n", (unsigned long)histlog_stats.evicted);
+    out.header("lacrosse_histlog_recovered_entries", "gauge", "History entries read back at boot");
+    out.printf("lacrosse_histlog_recovered_entries %lu\n", (unsigned long)histlog_stats.recovered);
+    out.header("lacrosse_histlog_bad_pages", "gauge", "Damaged pages skipped at boot");
+    out.printf("lacrosse_histlog_bad_pages %lu\n", (unsigned long)histlog_stats.bad_pages);
+    out.header("lacrosse_histlog_recover_seconds", "gauge", "Time spent reading the history log at boot");
+    out.printf("lacrosse_histlog_recover_seconds %.3f\n", histlog_stats.recover_ms / 1000.0);
+
+    out.header("lacrosse_snapshot_restored_sensors", "gauge", "Sensors restored from the warm-start snapshot at boot");
+    out.printf("lacrosse_snapshot_restored_sensors %u\n", (unsigned)snapshot_restored);
+
+    out.header("lacrosse_strtab_bytes", "gauge", "Bytes used in the sensor name/type string arena");
+    out.printf("lacrosse_strtab_bytes %u\n", (unsigned)str_stats.bytes);
+    out.header("lacrosse_strtab_strings", "gauge", "Interned sensor names and types");
+    out.printf("lacrosse_strtab_strings %u\n", (unsigned)str_stats.strings);
+    out.header("lacrosse_strtab_full_total", "counter", "Strings rejected because the arena was full");
+    out.printf("lacrosse_strtab_full_total %lu\n", (unsigned long)str_stats.full);
+
+    out.header("lacrosse_heap_free_bytes", "gauge", "Free heap");
+    out.printf("lacrosse_heap_free_bytes %lu\n", (unsigned long)ESP.getFreeHeap());
+    out.header("lacrosse_heap_min_free_bytes", "gauge", "Lowest free heap since boot");
+    out.printf("lacrosse_heap_min_free_bytes %lu\n", (unsigned long)ESP.getMinFreeHeap());
+    out.header("lacrosse_heap_largest_block_bytes", "gauge", "Largest allocatable heap block");
+    out.printf("lacrosse_heap_largest_block_bytes %lu\n", (unsigned long)ESP.getMaxAllocHeap());
+    out.header("lacrosse_heap_largest_block_min_bytes", "gauge", "Smallest largest-block value seen since boot (sampled)");
+    out.printf("lacrosse_heap_largest_block_min_bytes %lu\n", (unsigned long)heap_stats.largest_min);
+    out.header("lacrosse_heap_planned_restarts", "gauge", "Planned restarts because of low or fragmented heap since power-on");
+    out.printf("lacrosse_heap_planned_restarts %u\n", (unsigned)heap_stats.planned_restarts);
+
+    out.header("lacrosse_display_flushes_total", "counter", "OLED updates sent");
+    out.printf("lacrosse_display_flushes_total %lu\n", (unsigned long)oled_stats.flushes);
+    out.header("lacrosse_display_pages_total", "counter", "Changed OLED pages sent over I2C");
+    out.printf("lacrosse_display_pages_total %lu\n", (unsigned long)oled_stats.pages);
+    out.header("lacrosse_display_bytes_total", "counter", "OLED image bytes sent over I2C");
+    out.printf("lacrosse_display_bytes_total %lu\n", (unsigned long)oled_stats.bytes);
+    out.header("lacrosse_display_i2c_errors_total", "counter", "Failed OLED I2C transfers");
+    out.printf("lacrosse_display_i2c_errors_total %lu\n", (unsigned long)oled_stats.errors);
+
+    out.header("lacrosse_loop_duration_seconds", "histogram", "Duration of one UI loop pass");
+    uint32_t cumulative = 0;
+    for (int b = 0; b < METRICS_LOOP_BUCKETS; b++) {
+        cumulative += metrics.loop_buckets[b];
+        out.printf("lacrosse_loop_duration_seconds_bucket{le=\"%g\"} %lu\n", loop_bounds_us[b] / 1e6, (unsigned long)cumulative);
+    }
+    cumulative += metrics.loop_buckets[METRICS_LOOP_BUCKETS];
+    out.printf("lacrosse_loop_duration_seconds_bucket{le=\"+Inf\"} %lu\n", (unsigned long)cumulative);
+    out.printf("lacrosse_loop_duration_seconds_sum %.6f\n", metrics.loop_sum_us / 1e6);
+    out.printf("lacrosse_loop_duration_seconds_count %lu\n", (unsigned long)metrics.loop_count);
+
+    out.header("lacrosse_stage_duration_seconds", "summary", "Run time of one pipeline stage pass");
+    for (int s = 0; s < PERF_NUM; s++) {
+        PerfStage stage = (PerfStage)s;
+        const char *name = perf_stage_name(stage);
+        const PerfHist &h = perf_hist(stage);
+        out.printf("lacrosse_stage_duration_seconds{stage=\"%s\",quantile=\"0.5\"} %.6f\n", name, perf_percentile(stage, 0.50) / 1e6);
+        out.printf("lacrosse_stage_duration_seconds{stage=\"%s\",quantile=\"0.99\"} %.6f\n", name, perf_percentile(stage, 0.99) / 1e6);
+        out.printf("lacrosse_stage_duration_seconds_sum{stage=\"%s\"} %.6f\n", name, h.sum_us / 1e6);
+        out.printf("lacrosse_stage_duration_seconds_count{stage=\"%s\"} %lu\n", name, (unsigned long)h.count);
+    }
+    out.header("lacrosse_stage_duration_max_seconds", "gauge", "Slowest pass of a pipeline stage since boot");
+    for (int s = 0; s < PERF_NUM; s++)
+        out.printf("lacrosse_stage_duration_max_seconds{stage=\"%s\"} %.6f\n", perf_stage_name((PerfStage)s),
+                   perf_hist((PerfStage)s).max_us / 1e6);
+
+    out.header("lacrosse_frame_latency_seconds", "summary", "Time from radio read until a frame reached a pipeline stage");
+    for (int s = 0; s < TRACE_NUM; s++) {
+        TraceStage stage = (TraceStage)s;
+        const char *name = trace_stage_name(stage);
+        const PerfHist &h = trace_hist(stage);
+        out.printf("lacrosse_frame_latency_seconds{stage=\"%s\",quantile=\"0.5\"} %.6f\n", name, perf_hist_percentile(h, 0.50) / 1e6);
+        out.printf("lacrosse_frame_latency_seconds{stage=\"%s\",quantile=\"0.99\"} %.6f\n", name, perf_hist_percentile(h, 0.99) / 1e6);
+        out.printf("lacrosse_frame_latency_seconds_sum{stage=\"%s\"} %.6f\n", name, h.sum_us / 1e6);
+        out.printf("lacrosse_frame_latency_seconds_count{stage=\"%s\"} %lu\n", name, (unsigned long)h.count);
+    }
+
+    out.header("lacrosse_cpu_load_percent", "gauge", "CPU load per core over the last second");
+    for (int core = 0; core < portNUM_PROCESSORS; core++)
+        out.printf("lacrosse_cpu_load_percent{core=\"%d\"} %.1f\n", core, perf_cpu_load(core));
+
+    out.header("lacrosse_log_lines_total", "counter", "Log lines written to the serial port");
+    out.printf("lacrosse_log_lines_total %lu\n", (unsigned long)log_lines);
+    out.header("lacrosse_log_dropped_total", "counter", "Log lines dropped because the log buffer was full");
+    out.printf("lacrosse_log_dropped_total %lu\n", (unsigned long)log_dropped);
+
+    out.header("lacrosse_uptime_seconds", "counter", "Seconds since boot");
+    out.printf("lacrosse_uptime_seconds %lu\n", (unsigned long)uptime_sec());
+}
@@ -0,0 +1,108 @@
+#ifndef _METRICS_H
+#define _METRICS_H
+
+#include <Arduino.h>
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <freertos/queue.h>
+
+/* protocols as counted in the metrics, order is the label order in /metrics */
+enum Proto {
+    PROTO_LACROSSE = 0,
+    PROTO_WH1080,
+    PROTO_WS1600,
+    PROTO_WT440XH,
+    PROTO_TX22IT,
+    PROTO_EMT7110,
+    PROTO_W136,
+    PROTO_HP1000,
+    PROTO_WH65B,
+    PROTO_NUM
+};
+
+/* pipeline tasks and queues, see pipeline.h */
+enum MetricsTask {
+    MT_RADIO = 0,
+    MT_DECODE,
+    MT_NETWORK,
+    MT_WEB,
+    MT_UI,
+    MT_DISPLAY,
+    MT_NUM
+};
+
+enum MetricsQueue {
+    MQ_RAW = 0,
+    MQ_PUBLISH,
+    MQ_NUM
+};
+
+struct QueueStats {
+    QueueHandle_t handle;
+    uint32_t size;
+    uint32_t max_depth;
+    uint32_t dropped;
+};
+
+/* data rates the SX127x can be switched to, see SetActiveDataRates() */
+#define METRICS_RATE_NUM 5
+
+/* loop duration histogram bucket bounds in microseconds (+Inf is implicit) */
+#define METRICS_LOOP_BUCKETS 11
+
+struct Metrics {
+    uint32_t frames[PROTO_NUM];         // valid frames per protocol
+    uint32_t crc_errors[PROTO_NUM];     // header matched, checksum did not
+    uint32_t repeats[PROTO_NUM];        // same frame again within REPEAT_WINDOW_MS
+    uint32_t fec_corrected;             // LaCrosse single-bit errors repaired
+    uint32_t fec_rejected;              // repaired, but implausible for the sensor
+    uint32_t tx141_rejected;            // TX141 out of range for the locked format
+    uint32_t tx141_relearned;           // TX141 locks dropped after TX141_RELEARN_FRAMES misses
+    uint32_t outliers_held;             // values held back by the outlier filter
+    uint32_t radio_frames;              // everything read from the FIFO
+    uint32_t unknown_frames;            // no decoder accepted the frame
+    uint32_t rejected_frames;           // dropped before decoding (rate 0)
+    uint32_t fifo_overruns;             // SX127x FIFO overrun flag seen
+    uint32_t poll_gap_max_us;           // longest time the radio was not polled
+    uint32_t last_poll_us;
+
+    uint64_t rate_dwell_ms[METRICS_RATE_NUM];
+    int current_rate;
+    unsigned long rate_since;
+
+    uint32_t mqtt_published;
+    uint32_t mqtt_failed;
+    uint32_t mqtt_reconnects;
+
+    TaskHandle_t tasks[MT_NUM];
+    QueueStats queues[MQ_NUM];
+
+    /* radio read -> decoded, and radio read -> handed to the broker */
+    uint64_t decode_sum_us;
+    uint32_t decode_count;
+    uint32_t decode_max_us;
+    uint64_t latency_sum_us;
+    uint32_t latency_count;
+    uint32_t latency_max_us;
+
+    uint32_t loop_buckets[METRICS_LOOP_BUCKETS + 1];
+    uint64_t loop_sum_us;
+    uint32_t loop_count;
+};
+
+extern Metrics metrics;
+
+void metrics_rate_switch(int new_rate);
+void metrics_observe_loop(uint32_t us);
+void metrics_radio_poll();
+void metrics_register_task(MetricsTask t, TaskHandle_t handle);
+void metrics_register_queue(MetricsQueue q, QueueHandle_t handle, uint32_t size);
+void metrics_queue_depth(MetricsQueue q, uint32_t depth);
+void metrics_observe_decode(int64_t us);
+void metrics_observe_latency(int64_t us);
+
+/* renders all metrics in Prometheus text format, in chunks, to sink() */
+typedef void (*metrics_sink_t)(const char *buf, size_t len);
+void metrics_write(metrics_sink_t sink);
+
+#endif
@@ -0,0 +1,106 @@
+#include "oled.h"
+#include <Wire.h>
+
+#define OLED_MAX_WIDTH 128
+#define OLED_MAX_PAGES 8
+
+// Wire-Puffer minus Steuerbyte
+#ifdef I2C_BUFFER_LENGTH
+#define OLED_CHUNK (I2C_BUFFER_LENGTH - 1)
+#else
+#define OLED_CHUNK 31
+#endif
+
+OledStats oled_stats;
+
+static uint8_t sent[OLED_MAX_WIDTH * OLED_MAX_PAGES];   // Stand im GDDRAM
+static uint8_t oled_addr;
+static bool sent_valid;
+static int8_t power = -1;   // -1 = unbekannt
+
+static bool send_window(uint8_t col0, uint8_t col1, uint8_t page)
+{
+    // Kommandos in einer Uebertragung statt einzeln ueber ssd1306_command()
+    Wire.beginTransmission(oled_addr);
+    Wire.write((uint8_t)0x00);
+    Wire.write((uint8_t)SSD1306_COLUMNADDR);
+    Wire.write(col0);
+    Wire.write(col1);
+    Wire.write((uint8_t)SSD1306_PAGEADDR);
+    Wire.write(page);
+    Wire.write(page);
+    return Wire.endTransmission() == 0;
+}
+
+static bool send_data(const uint8_t *p, int n)
+{
+    while (n > 0) {
+        int chunk = n < OLED_CHUNK ? n : OLED_CHUNK;
+        Wire.beginTransmission(oled_addr);
+        Wire.write((uint8_t)0x40);
+        Wire.write(p, chunk);
+        if (Wire.endTransmission() != 0)
+            return false;
+        p += chunk;
+        n -= chunk;
+    }
+    return true;
+}
+
+void oled_init(uint8_t addr)
+{
+    oled_addr = addr;
+    sent_valid = false;
+    power = -1;
+    // display() schaltet den Takt selbst um, wir schreiben direkt
+    Wire.setClock(400000);
+}
+
+uint16_t oled_flush(Adafruit_SSD1306 &d)
+{
+    const uint8_t *buf = d.getBuffer();
+    int width = d.width();
+    int pages = d.height() / 8;
+    if (!buf || width > OLED_MAX_WIDTH || pages > OLED_MAX_PAGES)
+        return 0;
+
+    uint16_t bytes = 0;
+    bool ok = true;
+    for (int page = 0; page < pages; page++) {
+        const uint8_t *row = buf + page * width;
+        uint8_t *old = sent + page * width;
+        int c0 = 0, c1 = width - 1;
+        if (sent_valid) {
+            while (c0 < width && row[c0] == old[c0])
+                c0++;
+            if (c0 == width)
+                continue;
+            while (row[c1] == old[c1])
+                c1--;
+        }
+        int n = c1 - c0 + 1;
+        if (!send_window(c0, c1, page) || !send_data(row + c0, n)) {
+            // GDDRAM-Stand unklar: alte Kopie an der Stelle ungueltig machen
+            for (int c = c0; c <= c1; c++)
+                old[c] = ~row[c];
+            oled_stats.errors++;
+            ok = false;
+            continue;
+        }
+        memcpy(old + c0, row + c0, n);
+        oled_stats.pages++;
+        bytes += n;
+    }
+    sent_valid = sent_valid || ok;
+    oled_stats.flushes++;
+    oled_stats.bytes += bytes;
+    return bytes;
+}
+
+void oled_power(Adafruit_SSD1306 &d, bool on)
+{
+    if (power == (int8_t)on)
+        return;
+    d.ssd1306_command(on ? SSD1306_DISPLAYON : SSD1306_DISPLAYOFF);
+    power = on;
+}
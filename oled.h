@@ -0,0 +1,36 @@
+#ifndef _OLED_H
+#define _OLED_H
+
+#include <Arduino.h>
+#include <Adafruit_SSD1306.h>
+
+/*
+ * Uebertragung des Adafruit-Puffers zum SSD1306, ersetzt display.display().
+ * Eine Kopie des zuletzt gesendeten Bildes merkt sich, was im GDDRAM
+ * steht; gesendet werden nur Seiten (8 Pixelzeilen) mit Aenderungen und
+ * davon nur der Spaltenbereich zwischen erstem und letztem geaenderten
+ * Byte. Ein neuer Messwert kostet so ein paar hundert Bytes statt der
+ * vollen 1 KB (~25 ms bei 400 kHz).
+ *
+ * Nur aus einem Task aufrufen (Display-Task, vorher setup()).
+ */
+
+struct OledStats {
+    uint32_t flushes;
+    uint32_t pages;         // gesendete Seiten
+    uint32_t bytes;         // Bilddaten, ohne Adress-Kommandos
+    uint32_t errors;        // I2C-Fehler, Seite wird beim naechsten Mal wiederholt
+};
+
+extern OledStats oled_stats;
+
+/* nach display.begin(); der erste Flush sendet das ganze Bild */
+void oled_init(uint8_t addr);
+
+/* geaenderte Seiten senden, liefert die Zahl der Datenbytes */
+uint16_t oled_flush(Adafruit_SSD1306 &d);
+
+/* DISPLAYON/OFF nur bei Wechsel senden */
+void oled_power(Adafruit_SSD1306 &d, bool on);
+
+#endif
@@ -0,0 +1,137 @@
+/*
+ * Laufzeit-Histogramme je Pipeline-Stufe und CPU-Last je Kern.
+ * Jede Stufe hat genau einen schreibenden Task, Leser (Web-Task)
+ * lesen die Zaehler ohne Sperre.
+ */
+#include "perfstats.h"
+#include <freertos/FreeRTOS.h>
+#include <freertos/task.h>
+#include <esp_freertos_hooks.h>
+
+static PerfHist hists[PERF_NUM];
+
+static const char *stage_names[PERF_NUM] = {
+    "radio", "decode", "expire", "network", "publish", "web", "display"
+};
+
+static int bucket_of(uint32_t us)
+{
+    const uint32_t sub = 1 << PERF_SUB_BITS;
+    if (us >= (1u << (PERF_MAX_EXP + 1)))
+        us = (1u << (PERF_MAX_EXP + 1)) - 1;
+    if (us < sub)
+        return us;
+    int e = 31 - __builtin_clz(us);
+    return ((e - PERF_SUB_BITS + 1) << PERF_SUB_BITS) + ((us >> (e - PERF_SUB_BITS)) & (sub - 1));
+}
+
+/* groesster Wert, der noch in Bucket b faellt */
+static uint32_t bucket_upper(int b)
+{
+    const uint32_t sub = 1 << PERF_SUB_BITS;
+    if (b < (int)sub)
+        return b;
+    int shift = (b >> PERF_SUB_BITS) - 1;
+    return ((sub + (b & (sub - 1))) << shift) + (1u << shift) - 1;
+}
+
+void perf_hist_add(PerfHist &h, uint32_t us)
+{
+    h.counts[bucket_of(us)]++;
+    h.count++;
+    h.sum_us += us;
+    if (us > h.max_us)
+        h.max_us = us;
+}
+
+uint32_t perf_hist_percentile(const PerfHist &h, float q)
+{
+    if (h.count == 0)
+        return 0;
+    uint32_t rank = (uint32_t)(q * h.count + 0.5f);
+    if (rank < 1)
+        rank = 1;
+    uint32_t seen = 0;
+    for (int b = 0; b < PERF_BUCKETS; b++) {
+        seen += h.counts[b];
+        if (seen >= rank) {
+            uint32_t v = bucket_upper(b);
+            return v < h.max_us ? v : h.max_us;
+        }
+    }
+    return h.max_us;
+}
+
+void perf_record(PerfStage s, uint32_t us)
+{
+    perf_hist_add(hists[s], us);
+}
+
+uint32_t perf_percentile(PerfStage s, float q)
+{
+    return perf_hist_percentile(hists[s], q);
+}
+
+const PerfHist &perf_hist(PerfStage s)
+{
+    return hists[s];
+}
+
+const char *perf_stage_name(PerfStage s)
+{
+    return stage_names[s];
+}
+
+/* CPU-Last: der Tick-Hook jedes Kerns schaut nach, ob gerade dessen
+ * Idle-Task laeuft. Bei 1000 Ticks/s ergibt das eine Stichprobe pro ms,
+ * ohne Kalibrierung eines Idle-Zaehlers (der mit WLAN-Last schwankt). */
+static volatile uint32_t ticks[portNUM_PROCESSORS];
+static volatile uint32_t idle_ticks[portNUM_PROCESSORS];
+static TaskHandle_t idle_task[portNUM_PROCESSORS];
+static float cpu_load[portNUM_PROCESSORS];
+
+static inline void IRAM_ATTR sample_core(int core)
+{
+    ticks[core]++;
+    if (xTaskGetCurrentTaskHandleForCPU(core) == idle_task[core])
+        idle_ticks[core]++;
+}
+
+static void IRAM_ATTR tick_hook_core0() { sample_core(0); }
+#if portNUM_PROCESSORS > 1
+static void IRAM_ATTR tick_hook_core1() { sample_core(1); }
+#endif
+
+void perf_start_cpu_load()
+{
+    for (int core = 0; core < portNUM_PROCESSORS; core++)
+        idle_task[core] = xTaskGetIdleTaskHandleForCPU(core);
+    esp_register_freertos_tick_hook_for_cpu(tick_hook_core0, 0);
+#if portNUM_PROCESSORS > 1
+    esp_register_freertos_tick_hook_for_cpu(tick_hook_core1, 1);
+#endif
+}
+
+/* etwa einmal pro Sekunde aufrufen */
+void perf_update_cpu_load()
+{
+    static uint32_t last_ticks[portNUM_PROCESSORS];
+    static uint32_t last_idle[portNUM_PROCESSORS];
+    for (int core = 0; core < portNUM_PROCESSORS; core++) {
+        uint32_t t = ticks[core];
+        uint32_t i = idle_ticks[core];
+        uint32_t dt = t - last_ticks[core];
+        uint32_t di = i - last_idle[core];
+        if (dt > 0)
+            cpu_load[core] = 100.0f * (dt - di) / dt;
+        last_ticks[core] = t;
+        last_idle[core] = i;
+    }
+}
+
+float perf_cpu_load(int core)
+{
+    if (core < 0 || core >= portNUM_PROCESSORS)
+        return 0;
+    return cpu_load[core];
+}
@@ -0,0 +1,56 @@
+#ifndef _PERFSTATS_H
+#define _PERFSTATS_H
+
+#include <Arduino.h>
+#include <esp_timer.h>
+
+/* pipeline stages that get a duration histogram, order is the label order
+ * in /metrics and /api/system */
+enum PerfStage {
+    PERF_RADIO = 0,     // FIFO lesen und in die Raw-Queue stellen
+    PERF_DECODE,        // handle_frame()
+    PERF_EXPIRE,        // expire_cache()
+    PERF_NETWORK,       // check_mqtt(), WLAN, NTP, mqtt_client.loop()
+    PERF_PUBLISH,       // eine Nachricht an den Broker
+    PERF_WEB,           // ein HTTP-Request
+    PERF_DISPLAY,       // update_display() / draw_starfield()
+    PERF_NUM
+};
+
+/* HDR-artiges Histogramm: pro Zweierpotenz 2^PERF_SUB_BITS lineare
+ * Unterteilungen, also max. 12.5% Fehler bei 200 Zaehlern von 1us bis 67s */
+#define PERF_SUB_BITS 3
+#define PERF_MAX_EXP 26
+#define PERF_BUCKETS (((PERF_MAX_EXP - PERF_SUB_BITS + 1) << PERF_SUB_BITS) + (1 << PERF_SUB_BITS))
+
+struct PerfHist {
+    uint32_t counts[PERF_BUCKETS];
+    uint32_t count;
+    uint32_t max_us;
+    uint64_t sum_us;
+};
+
+void perf_hist_add(PerfHist &h, uint32_t us);
+uint32_t perf_hist_percentile(const PerfHist &h, float q);
+
+void perf_record(PerfStage s, uint32_t us);
+uint32_t perf_percentile(PerfStage s, float q);
+const PerfHist &perf_hist(PerfStage s);
+const char *perf_stage_name(PerfStage s);
+
+/* CPU-Last je Kern in Prozent, gemittelt ueber die letzte Sekunde */
+void perf_start_cpu_load();
+void perf_update_cpu_load();
+float perf_cpu_load(int core);
+
+/* misst die Laufzeit des umgebenden Blocks */
+class PerfTimer {
+public:
+    PerfTimer(PerfStage s) : stage(s), start(esp_timer_get_time()) {}
+    ~PerfTimer() { perf_record(stage, (uint32_t)(esp_timer_get_time() - start)); }
+private:
+    PerfStage stage;
+    int64_t start;
+};
+
+#endif
@@ -0,0 +1,59 @@
+#ifndef _PIPELINE_H
+#define _PIPELINE_H
+
+#include <Arduino.h>
+#include "SX127x.h"
+
+/*
+ * Task pipeline:
+ *
+ *   radio (core 1, prio 5) --raw_queue--> decode (core 1, prio 3)
+ *       --publish_queue--> network (core 0, prio 2)
+ *
+ * web (core 0, prio 1), display (core 1, prio 1) and the button in
+ * loop() (core 1, prio 1) only read. The radio task does nothing but SPI
+ * and the data rate toggle, so a busy decoder, a stalled broker or a
+ * slow page never delay reception. The display task owns the SSD1306 and
+ * the I2C bus, so OLED transfers never stall loop().
+ */
+
+#define RADIO_TASK_PRIO 5
+#define DECODE_TASK_PRIO 3
+#define NETWORK_TASK_PRIO 2
+#define DISPLAY_TASK_PRIO 1
+
+#define RADIO_TASK_STACK 3072
+#define DECODE_TASK_STACK 8192
+#define NETWORK_TASK_STACK 8192
+#define DISPLAY_TASK_STACK 4096
+
+#define RADIO_TASK_CORE 1
+#define DECODE_TASK_CORE 1
+#define NETWORK_TASK_CORE 0
+#define DISPLAY_TASK_CORE 1
+
+#define DISPLAY_TASK_MS 10     // Takt des Display-Tasks
+
+#define RAW_QUEUE_LEN 16
+#define PUBLISH_QUEUE_LEN 64
+#define PUBLISH_RING_BYTES 16384   // Topic + Payload der Queue-Eintraege, ~20 Discovery-Configs
+
+/* frame as it came off the air, copied out of the SX127x buffer */
+struct RawFrame {
+    int64_t rx_us;      // SX127x::GetReceiveTime(), start of the latency trace
+    int rate;
+    int8_t rssi;
+    byte len;
+    byte data[PAYLOAD_SIZE];
+};
+
+/* queued MQTT message, topic and payload follow it in the publish ring */
+struct MqttMsg {
+    int64_t rx_us;      // receive time of the frame that caused it, 0 if none
+    uint16_t end;       // ring offset after this message, released in queue order
+    bool retain;
+    char *payload;
+    char topic[];
+};
+
+#endif
@@ -0,0 +1,176 @@
+#include "sensorstore.h"
+#include "metrics.h"
+
+struct LastFrame {
+    uint32_t hash;
+    unsigned long ms;
+};
+
+static LastFrame last_frame[SENSOR_NUM];
+
+/* Rohwerte *10 als int16 (Druck bis 3276 hPa), 8 Byte je Messwert */
+struct FilterState {
+    int16_t raw[3];
+    uint8_t n;          // gueltige Eintraege in raw
+    uint8_t pos;
+    int16_t last;       // zuletzt angenommener Wert
+};
+
+static FilterState filters[SENSOR_NUM][FS_NUM];
+
+const size_t filter_state_size = sizeof(filters[0]);
+
+void filter_state_get(int idx, void *out)
+{
+    memcpy(out, filters[idx], filter_state_size);
+}
+
+void filter_state_set(int idx, const void *in)
+{
+    memcpy(filters[idx], in, filter_state_size);
+}
+
+static int16_t median3(int16_t a, int16_t b, int16_t c)
+{
+    if (a > b) { int16_t t = a; a = b; b = t; }
+    if (b > c) b = c;
+    return a > b ? a : b;
+}
+
+static float filter_step(uint8_t slot)
+{
+    switch (slot) {
+    case FS_TEMP:
+    case FS_TEMP_CH2: return config.filter_temp_step;
+    case FS_HUMI:     return config.filter_humi_step;
+    case FS_PRESSURE: return FILTER_PRESSURE_STEP;
+    }
+    return 0;
+}
+
+bool filter_accept(int idx, uint8_t slot, float v)
+{
+    if (idx < 0 || idx >= SENSOR_NUM || slot >= FS_NUM)
+        return true;
+    FilterState &s = filters[idx][slot];
+    // nach Ablauf im Cache (oder noch nie gesehen) neu anfangen
+    unsigned long seen = slot == FS_TEMP_CH2 ? fcache[idx].timestamp_ch2 : fcache[idx].timestamp;
+    if (seen == 0)
+        s.n = 0;
+
+    int16_t x = (int16_t)lroundf(v * 10);
+    s.raw[s.pos] = x;
+    s.pos = (s.pos + 1) % 3;
+    if (s.n < 3)
+        s.n++;
+
+    float step = filter_step(slot);
+    if (s.n == 1 || step <= 0 || abs(x - s.last) <= step * 10) {
+        s.last = x;
+        return true;
+    }
+    // Sprung: nur annehmen, wenn ein weiterer Rohwert das neue Niveau bestaetigt
+    // (bei nur 2 Werten ist das der vorige Rohwert)
+    int16_t m = s.n < 3 ? s.raw[(s.pos + 1) % 3] : median3(s.raw[0], s.raw[1], s.raw[2]);
+    if (abs(m - x) <= step * 10) {
+        s.last = x;
+        return true;
+    }
+    metrics.outliers_held++;
+    return false;
+}
+
+bool sensor_repeat(int idx, uint8_t proto, const byte *data, byte len)
+{
+    if (idx < 0 || idx >= SENSOR_NUM)
+        return false;
+    // FNV-1a, Protokoll und Laenge gehoeren mit zum Schluessel
+    uint32_t hash = 2166136261u;
+    hash = (hash ^ proto) * 16777619u;
+    hash = (hash ^ len) * 16777619u;
+    for (byte i = 0; i < len; i++)
+        hash = (hash ^ data[i]) * 16777619u;
+
+    unsigned long now = millis();
+    LastFrame &l = last_frame[idx];
+    if (l.hash == hash && l.ms != 0 && now - l.ms < REPEAT_WINDOW_MS)
+        return true;
+    l.hash = hash;
+    l.ms = now ? now : 1;
+    return false;
+}
+
+/* PLAUSIBLE_* gegen die gespeicherten Werte, seen: es gibt vorherige Werte */
+static uint8_t compare_stored(const Cache &c, const LaCrosse::Frame &frame, bool *seen)
+{
+    uint8_t plausible = PLAUSIBLE_TEMP | PLAUSIBLE_HUMI;
+    *seen = false;
+    if (frame.channel == 2) {
+        if (c.timestamp_ch2 > 0) {
+            *seen = true;
+            if (fabsf(c.temp_ch2 - frame.temp) > 2.0f)
+                plausible &= ~PLAUSIBLE_TEMP;
+        }
+    } else if (c.timestamp > 0) {
+        *seen = true;
+        if (fabsf(c.temp - frame.temp) > 2.0f)
+            plausible &= ~PLAUSIBLE_TEMP;
+        // humi -1 (kein Sensor) steht als 255 im Cache
+        if (abs((int8_t)c.humi - frame.humi) > 10)
+            plausible &= ~PLAUSIBLE_HUMI;
+    }
+    return plausible;
+}
+
+bool lacrosse_plausible(const LaCrosse::Frame &frame)
+{
+    int idx = GetCacheIndex(frame.ID, frame.channel);
+    if (idx < 0 || idx >= SENSOR_NUM)
+        return false;
+    bool seen;
+    uint8_t plausible = compare_stored(fcache[idx], frame, &seen);
+    return seen && plausible == (PLAUSIBLE_TEMP | PLAUSIBLE_HUMI);
+}
+
+int store_lacrosse(const LaCrosse::Frame &frame, const byte *data, StrId type, int rssi,
+                   bool temp_held, bool humi_held)
+{
+    int idx = GetCacheIndex(frame.ID, frame.channel);
+    if (idx < 0 || idx >= SENSOR_NUM)
+        return -1;
+
+    Cache &c = fcache[idx];
+
+    // gegen die gespeicherten Werte pruefen statt den alten Frame neu zu dekodieren
+    bool seen;
+    uint8_t plausible = compare_stored(c, frame, &seen);
+
+    cache_write_begin();
+    c.plausible = plausible;
+    c.ID = frame.ID;
+    c.rate = frame.rate;
+    c.rssi = rssi;
+    c.valid = frame.valid;
+    c.batlo = frame.batlo;
+    c.init = frame.init;
+    memcpy(c.data, data, FRAME_LENGTH);
+    c.type = type;
+
+    if (frame.channel == 2) {
+        if (!temp_held)
+            c.temp_ch2 = frame.temp;
+        c.timestamp_ch2 = millis();
+    } else {
+        if (!temp_held) {
+            c.temp = frame.temp;
+            c.temp_timestamp = millis();
+        }
+        if (!humi_held)
+            c.humi = frame.humi;
+        c.timestamp = millis();
+        c.channel = frame.channel;
+    }
+    mark_sensor_changed(idx);
+    cache_write_end();
+    return idx;
+}
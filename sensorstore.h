@@ -0,0 +1,144 @@
+#ifndef _SENSORSTORE_H
+#define _SENSORSTORE_H
+
+#include "globals.h"
+#include "decoder.h"
+#include "lacrosse.h"
+
+/*
+ * Merge-Stufe: uebernimmt dekodierte Frames in fcache. Die Decoder selbst
+ * sind reine Funktionen (Bytes, Laenge, rssi, rate) -> Frame und fassen
+ * keinen globalen Zustand an, damit sie reentrant und auf dem Host
+ * testbar sind. Geschrieben wird nur hier, aus dem Decode-Task.
+ */
+
+/* Wiederholungen desselben Frames (Sensoren senden mehrfach, nach einem
+ * Datenraten-Wechsel kommt ein Frame evtl. nochmal) innerhalb dieses
+ * Fensters werden verworfen. Kuerzer als das kleinste Sendeintervall (4 s). */
+#define REPEAT_WINDOW_MS 2000
+
+/* true, wenn derselbe Sensor (Cache-Index) gerade eben dieselben Bytes
+ * desselben Protokolls geliefert hat. Merkt sich den Frame sonst. */
+bool sensor_repeat(int idx, uint8_t proto, const byte *data, byte len);
+
+/*
+ * Ausreisserfilter je Sensor und Messwert: ein Wert, der mehr als die
+ * erlaubte Schrittweite vom letzten angenommenen abweicht, wird erst
+ * angenommen, wenn der Median der letzten 3 Rohwerte ihn bestaetigt
+ * (also ein zweiter Frame auf demselben Niveau kommt). Einzelne Spitzen
+ * erreichen so weder Cache noch MQTT. Schrittweite 0 = Filter aus.
+ */
+enum FilterSlot {
+    FS_TEMP = 0,
+    FS_TEMP_CH2,
+    FS_HUMI,
+    FS_PRESSURE,
+    FS_NUM,
+    FS_NONE = 0xFF
+};
+
+#define FILTER_PRESSURE_STEP 5.0f   // hPa je Frame
+
+/* Zeitstempel der Messgroesse, zu der ein Cache-Member gehoert, oder NULL */
+static inline unsigned long *field_timestamp(Cache &c, int16_t at)
+{
+    switch (at) {
+    case offsetof(Cache, temp):           return &c.temp_timestamp;
+    case offsetof(Cache, wind_speed):
+    case offsetof(Cache, wind_direction):
+    case offsetof(Cache, wind_gust):
+    case offsetof(Cache, wind_speed_avg):
+    case offsetof(Cache, wind_direction_avg):
+    case offsetof(Cache, wind_gust_max):  return &c.wind_timestamp;
+    case offsetof(Cache, rain):
+    case offsetof(Cache, rain_total):     return &c.rain_timestamp;
+    case offsetof(Cache, power):
+    case offsetof(Cache, energy):         return &c.power_timestamp;
+    case offsetof(Cache, pressure):       return &c.pressure_timestamp;
+    case offsetof(Cache, uv):             return &c.uv_timestamp;
+    case offsetof(Cache, light_lux):      return &c.light_timestamp;
+    }
+    return NULL;
+}
+
+/* false: Wert zurueckhalten (nicht cachen, nicht veroeffentlichen) */
+bool filter_accept(int idx, uint8_t slot, float v);
+
+/* Filterzustand eines Sensors fuer den Warmstart (snapshot.cpp) */
+extern const size_t filter_state_size;
+void filter_state_get(int idx, void *out);
+void filter_state_set(int idx, const void *in);
+
+static inline uint8_t filter_slot(uint8_t hass, bool ch2)
+{
+    switch (hass) {
+    case HK_TEMP:     return ch2 ? FS_TEMP_CH2 : FS_TEMP;
+    case HK_HUMI:     return FS_HUMI;
+    case HK_PRESSURE: return FS_PRESSURE;
+    }
+    return FS_NONE;
+}
+
+/* Frame eines Decoder<>-Protokolls uebernehmen, values aus sensor_values().
+ * held: Bit i gesetzt = Feld i vom Ausreisserfilter zurueckgehalten.
+ * rssi kommt vom Empfang, einige Frames speichern ihn nur als byte.
+ * Liefert den Cache-Index oder -1. */
+template <class Frame>
+int store_reading(const Frame &frame, const float *values, uint32_t held, int rssi, int rate)
+{
+    typedef Decoder<Frame> D;
+
+    byte channel = D::channel(frame);
+    bool ch2 = D::dual_channel && channel == 2;
+    int idx = GetCacheIndex(frame.ID, channel);
+    if (idx < 0 || idx >= SENSOR_NUM)
+        return -1;
+
+    Cache &c = fcache[idx];
+    const SensorField *fields = D::fields();
+    unsigned long now = millis();
+    cache_write_begin();
+    c.ID = frame.ID;
+    c.rssi = rssi;
+    c.rate = rate;
+    c.valid = true;
+    if (D::has_battery)
+        c.batlo = D::batlo(frame);
+    c.init = D::init(frame);
+    if (ch2) {
+        c.timestamp_ch2 = now;
+    } else {
+        c.channel = channel;
+        c.timestamp = now;
+    }
+    static const StrId type = str_intern(D::name());
+    c.type = type;
+
+    for (uint8_t i = 0; i < D::field_count; i++) {
+        const SensorField &f = fields[i];
+        int16_t at = ch2 ? f.cache_ch2 : f.cache;
+        if (at == NO_CACHE || (ch2 && !(f.flags & SF_CH2)) || (held & (1UL << i)))
+            continue;
+        float v = values[i];
+        if ((f.flags & SF_BEARING) && (v < 0 || v > 360))
+            v = -1;
+        sensor_store(f.cache_type, (uint8_t *)&c + at, v);
+        if (unsigned long *ts = ch2 ? NULL : field_timestamp(c, at))
+            *ts = now;
+    }
+    mark_sensor_changed(idx);
+    cache_write_end();
+    return idx;
+}
+
+/* LaCrosse IT+ (inkl. TX141), Rohdaten bleiben fuer die Web-Oberflaeche.
+ * Setzt Cache.plausible anhand der vorher gespeicherten Werte. */
+int store_lacrosse(const LaCrosse::Frame &frame, const byte *data, StrId type, int rssi,
+                   bool temp_held, bool humi_held);
+
+/* Frame passt zu den letzten Werten desselben Sensors (Temperatur und
+ * Feuchte plausibel); ohne vorherige Werte false. Schutz gegen
+ * Fehlkorrekturen der LaCrosse-FEC. */
+bool lacrosse_plausible(const LaCrosse::Frame &frame);
+
+#endif
@@ -0,0 +1,291 @@
+#include "snapshot.h"
+#include "sensorstore.h"
+#include "asynclog.h"
+#include <LittleFS.h>
+#include <esp_system.h>
+#include <rom/crc.h>
+#include <time.h>
+
+#define SNAPSHOT_MAGIC 0x50414E53   // "SNAP"
+#define SNAPSHOT_VERSION 2
+#define SNAPSHOT_TMP "/snapshot.tmp"
+
+struct SnapHeader {
+    uint32_t magic;
+    uint16_t version;
+    uint16_t cache_size;    // sizeof(Cache), aendert sich mit der Firmware
+    uint16_t filter_size;
+    uint16_t count;
+    uint32_t saved_ms;      // millis() beim Speichern
+    uint32_t epoch;         // Unix-Zeit beim Speichern, 0 = unbekannt
+    uint32_t crc;           // ueber alles nach dem Header
+};
+
+struct RtcSnapshot {
+    SnapHeader h;
+    uint8_t idx[SNAPSHOT_RTC_MAX];
+    Cache cache[SNAPSHOT_RTC_MAX];
+    char type[SNAPSHOT_RTC_MAX][STR_TYPE_LEN];  // Cache.type ist nur ein Handle
+    uint8_t tx141[TX141_IDS];
+};
+
+RTC_NOINIT_ATTR static RtcSnapshot rtc_snap;
+
+static LaCrosse::TX141Lock *tx141;
+
+uint16_t snapshot_restored;
+
+static uint32_t epoch_now()
+{
+    time_t t = time(nullptr);
+    return t >= 1600000000 ? (uint32_t)t : 0;
+}
+
+static bool sensor_saved(const Cache &c)
+{
+    return c.ID != 0xFF && (c.timestamp > 0 || c.timestamp_ch2 > 0);
+}
+
+/* ---- Laden ---- */
+
+/* millis() der alten Laufzeit auf die jetzige umrechnen, 0 = zu alt */
+static unsigned long rebase(unsigned long ts, const SnapHeader &h, uint32_t elapsed, uint32_t now)
+{
+    if (ts == 0)
+        return 0;
+    uint32_t age = h.saved_ms - ts + elapsed;
+    if (age > SNAPSHOT_MAX_AGE_MS)
+        return 0;
+    uint32_t t = now - age;
+    return t ? t : 1;
+}
+
+/* Handles aus strtab gelten nur fuer eine Laufzeit, der Typ liegt als Text bei */
+static StrId type_id(const char *type)
+{
+    return str_intern(type, strnlen(type, STR_TYPE_LEN));
+}
+
+static void type_name(char *out, StrId id)
+{
+    memset(out, 0, STR_TYPE_LEN);
+    strncpy(out, str_get(id), STR_TYPE_LEN - 1);
+}
+
+static bool apply_entry(uint8_t idx, Cache c, const char *type, const SnapHeader &h)
+{
+    uint32_t now = millis();
+    // seit dem Speichern vergangen: per Uhrzeit, sonst mindestens die Bootzeit
+    uint32_t epoch = epoch_now();
+    uint32_t elapsed = now;
+    if (h.epoch && epoch >= h.epoch && epoch - h.epoch < SNAPSHOT_MAX_AGE_MS / 1000)
+        elapsed = (epoch - h.epoch) * 1000;
+    else if (h.epoch && epoch)
+        return false;
+
+    c.timestamp = rebase(c.timestamp, h, elapsed, now);
+    c.timestamp_ch2 = rebase(c.timestamp_ch2, h, elapsed, now);
+    if (!sensor_saved(c))
+        return false;
+    c.temp_timestamp = rebase(c.temp_timestamp, h, elapsed, now);
+    c.rain_timestamp = rebase(c.rain_timestamp, h, elapsed, now);
+    c.wind_timestamp = rebase(c.wind_timestamp, h, elapsed, now);
+    c.power_timestamp = rebase(c.power_timestamp, h, elapsed, now);
+    c.pressure_timestamp = rebase(c.pressure_timestamp, h, elapsed, now);
+    c.uv_timestamp = rebase(c.uv_timestamp, h, elapsed, now);
+    c.light_timestamp = rebase(c.light_timestamp, h, elapsed, now);
+    c.type = type_id(type);
+
+    cache_write_begin();
+    fcache[idx] = c;
+    mark_sensor_changed(idx);
+    cache_write_end();
+    return true;
+}
+
+static bool header_ok(const SnapHeader &h)
+{
+    return h.magic == SNAPSHOT_MAGIC && h.version == SNAPSHOT_VERSION &&
+           h.cache_size == sizeof(Cache) && h.filter_size == filter_state_size;
+}
+
+static int restore_file()
+{
+    File f = LittleFS.open(SNAPSHOT_FILE);
+    if (!f)
+        return -1;
+    SnapHeader h;
+    size_t rec = 1 + sizeof(Cache) + STR_TYPE_LEN + filter_state_size;
+    size_t len = f.size() - sizeof(h);
+    uint8_t *buf = NULL;
+    bool ok = f.read((uint8_t *)&h, sizeof(h)) == sizeof(h) && header_ok(h) &&
+              len == h.count * rec + sizeof(LaCrosse::TX141Lock) && (buf = (uint8_t *)malloc(len)) &&
+              f.read(buf, len) == len && crc32_le(0, buf, len) == h.crc;
+    f.close();
+    if (!ok) {
+        free(buf);
+        LOGW("snapshot: %s invalid, ignored", SNAPSHOT_FILE);
+        return -1;
+    }
+    // Uhr verloren (Stromausfall, Brownout): wie lange die Datei schon
+    // liegt, ist unbekannt, die Messwerte werden nicht uebernommen
+    esp_reset_reason_t why = esp_reset_reason();
+    bool undated = !epoch_now() && (h.epoch || why == ESP_RST_POWERON || why == ESP_RST_BROWNOUT);
+    if (undated)
+        LOGI("snapshot: clock lost since %s was saved, ignored", SNAPSHOT_FILE);
+    int n = 0;
+    for (int i = 0; i < h.count && !undated; i++) {
+        const uint8_t *p = buf + i * rec;
+        Cache c;
+        memcpy(&c, p + 1, sizeof(Cache));
+        if (apply_entry(p[0], c, (const char *)p + 1 + sizeof(Cache), h)) {
+            filter_state_set(p[0], p + 1 + sizeof(Cache) + STR_TYPE_LEN);
+            n++;
+        }
+    }
+    // die IDs koennen inzwischen anderen Sensoren gehoeren, dann neu lernen
+    if (!undated)
+        memcpy(tx141, buf + h.count * rec, sizeof(LaCrosse::TX141Lock));
+    free(buf);
+    return n;
+}
+
+static int restore_rtc()
+{
+    const SnapHeader &h = rtc_snap.h;
+    // nach Stromausfall steht Zufall im RTC-Speicher, die CRC faengt das ab
+    if (esp_reset_reason() == ESP_RST_POWERON || !header_ok(h) || h.count > SNAPSHOT_RTC_MAX ||
+        crc32_le(0, (const uint8_t *)&rtc_snap + sizeof(h), sizeof(rtc_snap) - sizeof(h)) != h.crc)
+        return -1;
+    int n = 0;
+    for (int i = 0; i < h.count; i++)
+        if (apply_entry(rtc_snap.idx[i], rtc_snap.cache[i], rtc_snap.type[i], h))
+            n++;
+    // gelernte TX141-Kodierung, sofern die Datei nichts hatte
+    for (int id = 0; id < TX141_IDS; id++)
+        if (tx141->format[id] == TX141_UNLOCKED)
+            tx141->format[id] = rtc_snap.tx141[id];
+    return n;
+}
+
+/* ---- Speichern ---- */
+
+static void fill_header(SnapHeader &h, uint16_t count, const uint8_t *data, size_t len)
+{
+    h.magic = SNAPSHOT_MAGIC;
+    h.version = SNAPSHOT_VERSION;
+    h.cache_size = sizeof(Cache);
+    h.filter_size = filter_state_size;
+    h.count = count;
+    h.saved_ms = millis();
+    h.epoch = epoch_now();
+    h.crc = crc32_le(0, data, len);
+}
+
+/* die zuletzt geaenderten Sensoren in den RTC-Speicher, kein Flash */
+static void rtc_save()
+{
+    static Cache c;
+    uint8_t n = 0;
+    for (int i = 0; i < SENSOR_NUM; i++) {
+        cache_read(i, &c);
+        if (!sensor_saved(c))
+            continue;
+        // nach seq absteigend einsortieren, aeltester faellt raus
+        int k = n < SNAPSHOT_RTC_MAX ? n++ : SNAPSHOT_RTC_MAX;
+        while (k > 0 && rtc_snap.cache[k - 1].seq < c.seq) {
+            if (k < SNAPSHOT_RTC_MAX) {
+                rtc_snap.cache[k] = rtc_snap.cache[k - 1];
+                rtc_snap.idx[k] = rtc_snap.idx[k - 1];
+                memcpy(rtc_snap.type[k], rtc_snap.type[k - 1], STR_TYPE_LEN);
+            }
+            k--;
+        }
+        if (k < SNAPSHOT_RTC_MAX) {
+            rtc_snap.cache[k] = c;
+            rtc_snap.idx[k] = i;
+            type_name(rtc_snap.type[k], c.type);
+        }
+    }
+    if (n < SNAPSHOT_RTC_MAX) {
+        memset(&rtc_snap.cache[n], 0, (SNAPSHOT_RTC_MAX - n) * sizeof(Cache));
+        memset(rtc_snap.type[n], 0, (SNAPSHOT_RTC_MAX - n) * STR_TYPE_LEN);
+    }
+    memcpy(rtc_snap.tx141, tx141->format, TX141_IDS);
+    fill_header(rtc_snap.h, n, (const uint8_t *)&rtc_snap + sizeof(SnapHeader),
+                sizeof(rtc_snap) - sizeof(SnapHeader));
+}
+
+/* Shutdown-Handler von esp_restart(): ESP.restart(), OTA, Web-Reboot */
+static void snapshot_shutdown()
+{
+    rtc_save();
+}
+
+bool snapshot_save()
+{
+    if (!littlefs_ok || !tx141)
+        return false;
+    size_t rec = 1 + sizeof(Cache) + STR_TYPE_LEN + filter_state_size;
+    uint8_t *buf = (uint8_t *)malloc(SENSOR_NUM * rec + sizeof(LaCrosse::TX141Lock));
+    if (!buf)
+        return false;
+    uint16_t count = 0;
+    Cache c;
+    // Filter und TX141 schreibt nur der Decode-Task, unter state_lock
+    state_lock();
+    for (int i = 0; i < SENSOR_NUM; i++) {
+        cache_read(i, &c);
+        if (!sensor_saved(c))
+            continue;
+        uint8_t *p = buf + count * rec;
+        p[0] = i;
+        memcpy(p + 1, &c, sizeof(Cache));
+        type_name((char *)p + 1 + sizeof(Cache), c.type);
+        filter_state_get(i, p + 1 + sizeof(Cache) + STR_TYPE_LEN);
+        count++;
+    }
+    memcpy(buf + count * rec, tx141, sizeof(LaCrosse::TX141Lock));
+    state_unlock();
+
+    size_t len = count * rec + sizeof(LaCrosse::TX141Lock);
+    SnapHeader h;
+    fill_header(h, count, buf, len);
+    File f = LittleFS.open(SNAPSHOT_TMP, FILE_WRITE);
+    bool ok = f && f.write((const uint8_t *)&h, sizeof(h)) == sizeof(h) && f.write(buf, len) == len;
+    f.close();
+    free(buf);
+    // rename ersetzt atomar, es gibt immer eine vollstaendige Datei
+    if (!ok || !LittleFS.rename(SNAPSHOT_TMP, SNAPSHOT_FILE)) {
+        LOGW("snapshot: writing %s failed", SNAPSHOT_FILE);
+        return false;
+    }
+    return true;
+}
+
+void snapshot_restore(LaCrosse::TX141Lock *lock)
+{
+    tx141 = lock;
+    int from_file = littlefs_ok ? restore_file() : -1;
+    int from_rtc = restore_rtc();
+    snapshot_restored = 0;
+    for (int i = 0; i < SENSOR_NUM; i++)
+        if (sensor_saved(fcache[i]))
+            snapshot_restored++;
+    LOGI("snapshot: %u sensors restored (file %d, rtc %d)", snapshot_restored, from_file, from_rtc);
+    esp_register_shutdown_handler(snapshot_shutdown);
+}
+
+void snapshot_poll()
+{
+    static unsigned long last_rtc, last_file;
+    unsigned long now = millis();
+    if (now - last_rtc >= SNAPSHOT_RTC_INTERVAL_MS) {
+        last_rtc = now;
+        rtc_save();
+    }
+    if (now - last_file >= SNAPSHOT_INTERVAL_MS) {
+        last_file = now;
+        snapshot_save();
+    }
+}
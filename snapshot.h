@@ -0,0 +1,45 @@
+#ifndef _SNAPSHOT_H
+#define _SNAPSHOT_H
+
+#include "globals.h"
+#include "lacrosse.h"
+
+/*
+ * Warmstart: die aktuellen Sensorwerte (fcache), der Ausreisserfilter und
+ * die gelernten TX141-Kodierungen ueberleben einen Neustart, Anzeige,
+ * Web-Oberflaeche und MQTT haben danach sofort wieder alle Sensoren.
+ *
+ *  - /snapshot.bin auf LittleFS alle SNAPSHOT_INTERVAL_MS und vor einem
+ *    geplanten Neustart (ueber *.tmp + rename, nie halb geschrieben).
+ *  - Zusaetzlich die juengsten SNAPSHOT_RTC_MAX Sensoren im RTC-Speicher
+ *    (RTC_NOINIT, ueberlebt Software-Reset, Watchdog und Absturz), jede
+ *    Minute und beim esp_restart() ueber einen Shutdown-Handler. Das deckt
+ *    auch OTA-Updates ab, die selbst neu starten.
+ *
+ * Beide Kopien tragen Magic, Version, sizeof(Cache) und CRC; passt etwas
+ * nicht (andere Firmware, Stromausfall beim RTC), wird verworfen.
+ * Zeitstempel sind millis() und werden beim Laden auf die neue Laufzeit
+ * umgerechnet, zu alte Eintraege werden nicht uebernommen. Ohne Uhrzeit
+ * nach einem Stromausfall ist das Alter der Datei unbekannt, dann bleiben
+ * nur die TX141-Kodierungen.
+ */
+
+#define SNAPSHOT_FILE "/snapshot.bin"
+#define SNAPSHOT_INTERVAL_MS 300000
+#define SNAPSHOT_RTC_INTERVAL_MS 60000
+#define SNAPSHOT_RTC_MAX 16
+#define SNAPSHOT_MAX_AGE_MS 900000   // laengster Sensor-Timeout, siehe expire_cache()
+
+/* beim Start uebernommene Sensoren */
+extern uint16_t snapshot_restored;
+
+/* vor start_pipeline(): Lock merken, Shutdown-Handler anmelden, laden */
+void snapshot_restore(LaCrosse::TX141Lock *lock);
+
+/* LittleFS-Kopie schreiben, nicht aus dem Decode-Task */
+bool snapshot_save();
+
+/* periodisch aus loop(): RTC jede Minute, LittleFS alle 5 Minuten */
+void snapshot_poll();
+
+#endif
@@ -0,0 +1,56 @@
+#include "strtab.h"
+#include "asynclog.h"
+
+StrStats str_stats;
+char str_arena[STR_ARENA_SIZE];   // [0] = '\0' ist STR_NONE
+
+static StrId slots[STR_HASH_SLOTS];   // 0 = frei
+static uint16_t arena_used = 1;
+static portMUX_TYPE str_mux = portMUX_INITIALIZER_UNLOCKED;
+
+static uint32_t fnv1a(const char *s, size_t len)
+{
+    uint32_t h = 2166136261u;
+    while (len--)
+        h = (h ^ (uint8_t)*s++) * 16777619u;
+    return h;
+}
+
+StrId str_intern(const char *s, size_t len)
+{
+    if (len == 0)
+        return STR_NONE;
+    uint32_t h = fnv1a(s, len);
+    StrId id = STR_NONE;
+    bool full = false;
+    portENTER_CRITICAL(&str_mux);
+    for (uint32_t n = 0; n < STR_HASH_SLOTS; n++) {
+        StrId &slot = slots[(h + n) & (STR_HASH_SLOTS - 1)];
+        if (slot == STR_NONE) {
+            // neu: Text samt '\0' anhaengen, Tabelle hoechstens zu 3/4 fuellen
+            if (arena_used + len + 1 > STR_ARENA_SIZE || str_stats.strings >= STR_HASH_SLOTS * 3 / 4) {
+                full = true;
+                break;
+            }
+            id = arena_used;
+            memcpy(&str_arena[id], s, len);
+            str_arena[id + len] = '\0';
+            arena_used += len + 1;
+            slot = id;
+            str_stats.bytes = arena_used;
+            str_stats.strings++;
+            break;
+        }
+        if (strncmp(&str_arena[slot], s, len) == 0 && str_arena[slot + len] == '\0') {
+            id = slot;
+            break;
+        }
+    }
+    if (full)
+        str_stats.full++;
+    portEXIT_CRITICAL(&str_mux);
+    if (full)
+        LOGW("strtab: full (%u bytes, %u strings), '%.*s' not stored", str_stats.bytes,
+             str_stats.strings, (int)len, s);
+    return id;
+}
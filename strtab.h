@@ -0,0 +1,47 @@
+#ifndef _STRTAB_H
+#define _STRTAB_H
+
+#include <Arduino.h>
+
+/*
+ * Intern-Tabelle fuer Sensornamen und Sensortypen: jeder Text liegt genau
+ * einmal in einer festen Arena und wird ueber einen 2-Byte-Handle (Offset)
+ * angesprochen. Eingetragenes wird nie veraendert oder freigegeben, Zeiger
+ * aus str_get() bleiben fuer die ganze Laufzeit gueltig und duerfen ohne
+ * Lock gelesen werden. Kein Heap, also auch keine Fragmentierung.
+ *
+ * Umbenennen legt den neuen Namen zusaetzlich ab, der alte bleibt bis zum
+ * Neustart liegen. Ist die Arena voll, liefert str_intern() STR_NONE.
+ */
+
+#define STR_ARENA_SIZE 8192
+#define STR_HASH_SLOTS 1024       // Zweierpotenz, > Anzahl Texte
+#define STR_TYPE_LEN 16           // Sensortyp als Text (Snapshot)
+
+typedef uint16_t StrId;
+#define STR_NONE 0                // leerer Text
+
+struct StrStats {
+    uint16_t bytes;               // belegt in der Arena
+    uint16_t strings;
+    uint32_t full;                // abgelehnt, Arena oder Hashtabelle voll
+};
+
+extern StrStats str_stats;
+extern char str_arena[STR_ARENA_SIZE];
+
+/* Handle fuer s (Laenge len), vorhandene Texte werden wiederverwendet.
+ * Aus allen Tasks aufrufbar. */
+StrId str_intern(const char *s, size_t len);
+
+static inline StrId str_intern(const char *s)
+{
+    return s ? str_intern(s, strlen(s)) : STR_NONE;
+}
+
+static inline const char *str_get(StrId id)
+{
+    return &str_arena[id < STR_ARENA_SIZE ? id : STR_NONE];
+}
+
+#endif
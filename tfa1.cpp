@@ -1,4 +1,6 @@
 #include "tfa1.h"
+#include "asynclog.h"
+#include "frameformat.h"
 
 namespace TFA1 {
 
@@ -85,24 +87,18 @@ bool TryHandleData(uint8_t *data, int len, Frame *frame) {
     return true;
 }
 
+static const FrameField tfa1_fields[] = {
+    FRAME_FIELD(Frame, ID, " ID%04X"),
+    FRAME_FIELD(Frame, channel, " Ch%d"),
+    FRAME_FIELD(Frame, temp, " Temp%.1f°C"),
+    FRAME_FIELD(Frame, humi, " Humi%d%%"),
+    FRAME_FIELD(Frame, init, " init%d"),
+    FRAME_FIELD(Frame, batlo, " batlo%d"),
+};
+static const FrameFormat tfa1_format = FRAME_FORMAT("TFA1    ", Frame, tfa1_fields);
+
 void DisplayFrame(uint8_t *data, int len, Frame *frame) {
-    Serial.println("\n--- TFA_1 KlimaLogg Pro ---");
-    Serial.print("ID: 0x");
-    Serial.println(frame->ID, HEX);
-    Serial.print("Channel: ");
-    Serial.println(frame->channel);
-    Serial.print("Temperature: ");
-    Serial.print(frame->temp, 1);
-    Serial.println(" °C");
-    Serial.print("Humidity: ");
-    Serial.print(frame->humi);
-    Serial.println(" %");
-    Serial.print("Battery: ");
-    Serial.println(frame->batlo ? "LOW" : "OK");
-    if (frame->init) {
-        Serial.println("*** INIT MESSAGE ***");
-    }
-    Serial.println("---------------------------");
+    print_frame(tfa1_format, frame, data, len);
 }
 
 } // namespace TFA1
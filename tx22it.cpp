@@ -1,7 +1,7 @@
 #include "tx22it.h"
-#include "globals.h"
-
-extern Cache fcache[];
+#include "asynclog.h"
+#include "frameformat.h"
+#include "metrics.h"
 
 bool TX22IT::TryHandleData(byte *data, byte payLoadSize, Frame *f) {
     // TX22IT: 9 Bytes, startet mit 0x41
@@ -15,6 +15,7 @@ bool TX22IT::TryHandleData(byte *data, byte payLoadSize, Frame *f) {
         crc ^= data[i];
     }
     if (crc != 0) {
+        metrics.crc_errors[PROTO_TX22IT]++;
         return false;
     }
 
@@ -43,52 +44,23 @@ bool TX22IT::TryHandleData(byte *data, byte payLoadSize, Frame *f) {
     int windDir = ((data[7] & 0x01) << 8) | data[8];
     f->wind_direction = windDir * 360.0 / 512.0;
 
-    // Update cache
-    int idx = GetCacheIndex(f->ID, 1);
-    fcache[idx].ID = f->ID;
-    fcache[idx].temp = f->temp;
-    fcache[idx].humi = f->humi;
-    fcache[idx].batlo = f->batlo;
-    fcache[idx].init = f->init;
-    fcache[idx].wind_speed = f->wind_speed;
-    fcache[idx].wind_gust = f->wind_gust;
-    fcache[idx].wind_direction = f->wind_direction;
-    fcache[idx].wind_timestamp = millis();
-    fcache[idx].timestamp = millis();
-    fcache[idx].valid = true;
-    fcache[idx].rssi = f->rssi;
-    fcache[idx].rate = f->rate;
-    strncpy(fcache[idx].sensorType, "TX22IT", 15);
-    fcache[idx].sensorType[15] = '\0';
-
     f->valid = true;
     return true;
 }
 
+static const FrameField tx22it_fields[] = {
+    FRAME_FIELD(TX22IT::Frame, ID, " ID%-3d"),
+    FRAME_FIELD(TX22IT::Frame, temp, " Temp%-5.1f°C"),
+    FRAME_FIELD(TX22IT::Frame, humi, " Humi%d%%"),
+    FRAME_FIELD(TX22IT::Frame, wind_speed, " Wind%.1fm/s"),
+    FRAME_FIELD(TX22IT::Frame, wind_gust, " Gust%.1fm/s"),
+    FRAME_FIELD(TX22IT::Frame, wind_direction, " Dir%.0f°"),
+    FRAME_FIELD(TX22IT::Frame, init, " init%d"),
+    FRAME_FIELD(TX22IT::Frame, batlo, " batlo%d"),
+};
+static const FrameFormat tx22it_format = FRAME_FORMAT("TX22IT ", TX22IT::Frame, tx22it_fields);
+
 bool TX22IT::DisplayFrame(byte *data, byte payLoadSize, Frame *f) {
     if (!f->valid) return false;
-    
-    static unsigned long last[SENSOR_NUM];
-    DisplayRaw(last[f->ID], "TX22IT ", data, payLoadSize, f->rssi, f->rate);
-    
-    Serial.printf(" ID%-3d", f->ID);
-    Serial.printf(" Temp%-5.1f°C", f->temp);
-    Serial.printf(" Humi%d%%", f->humi);
-    Serial.printf(" Wind%.1fm/s", f->wind_speed);
-    Serial.printf(" Gust%.1fm/s", f->wind_gust);
-    Serial.printf(" Dir%.0f°", f->wind_direction);
-    Serial.printf(" init%d batlo%d", f->init, f->batlo);
-    Serial.println();
-    
-    return true;
-}
-
-void TX22IT::DisplayRaw(unsigned long &last, const char *dev, uint8_t *data, uint8_t len, int8_t rssi, int rate) {
-    unsigned long now = millis();
-    if (last == 0) last = now;
-    Serial.printf("%6ld %s [", (now - last), dev);
-    last = now;
-    for (uint8_t i = 0; i < len; i++)
-        Serial.printf("%02X%s", data[i], (i == len - 1) ? "" : " ");
-    Serial.printf("] rssi%-4d rate%-5d", rssi, rate);
+    return print_frame(tx22it_format, f, data, payLoadSize);
 }
\ No newline at end of file
@@ -20,7 +20,6 @@ namespace TX22IT {
     
     bool TryHandleData(byte *data, byte payLoadSize, Frame *f);
     bool DisplayFrame(byte *data, byte payLoadSize, Frame *f);
-    void DisplayRaw(unsigned long &last, const char *dev, uint8_t *data, uint8_t len, int8_t rssi, int rate);
 }
 
 #endif
\ No newline at end of file
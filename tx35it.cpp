@@ -1,4 +1,6 @@
 #include "tx35it.h"
+#include "asynclog.h"
+#include "frameformat.h"
 #include <Arduino.h>
 
 /*
@@ -84,37 +86,21 @@ bool TX35IT::TryHandleData(byte *data, struct Frame *f)
     return false;
 }
 
+static const FrameField tx35it_fields[] = {
+    FRAME_FIELD(TX35IT::Frame, ID, " ID%-3d"),
+    FRAME_FIELD(TX35IT::Frame, channel, " Ch%d"),
+    FRAME_FIELD(TX35IT::Frame, temp, " Temp%.1f°C"),
+    FRAME_FIELD(TX35IT::Frame, init, " init%d"),
+    FRAME_FIELD(TX35IT::Frame, batlo, " batlo%d"),
+    FRAME_FIELD_IF(TX35IT::Frame, humi, " Humi%d%%", FF_HUMI),
+};
+static const FrameFormat tx35it_format = FRAME_FORMAT("TX35IT  ", TX35IT::Frame, tx35it_fields);
+
 bool TX35IT::DisplayFrame(byte *data, struct Frame *f)
 {
-    static unsigned long last[SENSOR_NUM];
     if (!f->valid) {
-        Serial.println("TX35IT::DisplayFrame FRAME INVALID");
+        LOGW("TX35IT::DisplayFrame FRAME INVALID");
         return false;
     }
-
-    DisplayRaw(last[f->ID], "TX35IT  ", data, FRAME_LENGTH, f->rssi, f->rate);
-    
-    Serial.printf(" ID%-3d Ch%d", f->ID, f->channel);
-    Serial.printf(" Temp%.1f°C", f->temp);
-    Serial.printf(" init%d batlo%d", f->init, f->batlo);
-    
-    if (f->humi > 0 && f->humi <= 100) {
-        Serial.printf(" Humi%d%%", f->humi);
-    }
-    
-    Serial.println();
-    
-    return true;
-}
-
-void TX35IT::DisplayRaw(unsigned long &last, const char *dev, uint8_t *data, uint8_t len, int8_t rssi, int rate)
-{
-    unsigned long now = millis();
-    if (last == 0)
-        last = now;
-    Serial.printf("%6ld %s [", (now - last), dev);
-    last = now;
-    for (uint8_t i = 0; i < len; i++)
-        Serial.printf("%02X%s", data[i], (i == len - 1) ? "" : " ");
-    Serial.printf("] rssi%-4d rate%-5d", rssi, rate);
+    return print_frame(tx35it_format, f, data, FRAME_LENGTH);
 }
\ No newline at end of file
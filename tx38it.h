@@ -21,7 +21,6 @@ namespace TX38IT {
     bool TryHandleData(byte *data, struct Frame *f);
     bool DecodeFrame(byte *bytes, struct Frame *f);
     bool DisplayFrame(byte *data, struct Frame *f);
-    void DisplayRaw(unsigned long &last, const char *dev, uint8_t *data, uint8_t len, int8_t rssi, int rate);
     
     byte CalculateCRC(byte *data, byte len);
 }
@@ -6,6 +6,7 @@
 #include <ArduinoJson.h>
 #include <Update.h>
 #include <time.h>
+#include "snapshot.h"
 
 // GitHub Repository Info
 #define GITHUB_REPO_OWNER "steigerbalett"
@@ -529,6 +530,7 @@ bool installUpdate(bool forceInsecure = false) {
                         http.end();
                         updateInstallInProgress = false;
                         
+                        snapshot_save();
                         delay(3000);
                         ESP.restart();
                         return true;
@@ -0,0 +1,31 @@
+#!/usr/bin/env python3
+# Erzeugt charts_html.h (gzip, PROGMEM) aus web/charts.html.
+# Aufruf aus dem Projektverzeichnis: python3 web/embed.py
+import gzip
+import hashlib
+import os
+
+here = os.path.dirname(os.path.abspath(__file__))
+src = os.path.join(here, 'charts.html')
+dst = os.path.join(here, '..', 'charts_html.h')
+
+with open(src, 'rb') as f:
+    html = f.read()
+# mtime=0: gleiche Quelle ergibt gleiche Bytes (und gleichen ETag)
+data = gzip.compress(html, compresslevel=9, mtime=0)
+etag = hashlib.sha1(data).hexdigest()[:16]
+
+lines = []
+for i in range(0, len(data), 16):
+    lines.append('    ' + ', '.join('0x%02x' % b for b in data[i:i + 16]) + ',')
+
+with open(dst, 'w', newline='\n') as f:
+    f.write('/* generiert von web/embed.py aus web/charts.html, nicht von Hand aendern */\n')
+    f.write('#ifndef _CHARTS_HTML_H\n#define _CHARTS_HTML_H\n\n')
+    f.write('#include <Arduino.h>\n\n')
+    f.write('#define CHARTS_HTML_ETAG "\\"%s\\""\n' % etag)
+    f.write('#define CHARTS_HTML_GZ_LEN %d   // %d Bytes ungepackt\n\n' % (len(data), len(html)))
+    f.write('static const uint8_t charts_html_gz[CHARTS_HTML_GZ_LEN] PROGMEM = {\n')
+    f.write('\n'.join(lines) + '\n};\n\n#endif\n')
+
+print('%s: %d -> %d bytes' % (os.path.relpath(dst), len(html), len(data)))
@@ -1,6 +1,15 @@
 #include "webfrontend.h"
 #include "lacrosse.h"
 #include "globals.h"
+#include "metrics.h"
+#include "perfstats.h"
+#include "asynclog.h"
+#include "frameformat.h"
+#include "history.h"
+#include "charts_html.h"
+#include "snapshot.h"
+#include "heapmon.h"
+#include "configstore.h"
 #include <HTTPUpdateServer.h>
 #include <LittleFS.h>
 #include <ArduinoJson.h>
@@ -36,28 +45,11 @@ void add_debug_log(uint8_t *data, int8_t rssi, int datarate, bool valid) {
 
 extern uint32_t auto_display_on;
 extern Adafruit_SSD1306 display;
-extern unsigned long loop_count;
 extern float cpu_usage;
 
 static WebServer server(80);
 static HTTPUpdateServer httpUpdater;
 
-int name2id(const char *fname, const int start = 0)
-{
-    if (strlen(fname) - start != 2) {
-        Serial.printf("INVALID idmap file name: %s\r\n", fname);
-        return -1;
-    }
-    char *end;
-    errno = 0;
-    int id = strtol(fname + start, &end, 16);
-    if (*end != '\0' || errno != 0 || end - fname - start != 2) {
-        Serial.printf("STRTOL error, %s, errno: %d\r\n", fname, errno);
-        return -1;
-    }
-    return id;
-}
-
 String time_string(void)
 {
     uint32_t now = uptime_sec();
@@ -71,278 +63,6 @@ String time_string(void)
     return ret;
 }
 
-String read_file(File &file)
-{
-    String ret;
-    while (file.available())
-        ret += String((char)file.read());
-    return ret;
-}
-
-bool load_idmap()
-{
-    if (!littlefs_ok)
-        return false;
-    File idmapdir = LittleFS.open("/idmap");
-    if (!idmapdir) {
-        Serial.println("/idmap not found");
-        return false;
-    }
-    if (!idmapdir.isDirectory()) {
-        Serial.println("/idmap not a directory");
-        idmapdir.close();
-        return false;
-    }
-    for (int i = 0; i < SENSOR_NUM; i++)
-        id2name[i] = String();
-    int found = 0;
-    File file = idmapdir.openNextFile();
-    while (file) {
-        const char *fname = file.name();
-        int id = name2id(fname);
-        if (id > -1) {
-            Serial.printf("reading idmap file %s id:%2d ", fname, id);
-            id2name[id] = read_file(file);
-            Serial.println("content: " + id2name[id]);
-            found++;
-        }
-        file.close();
-        file = idmapdir.openNextFile();
-    }
-    idmapdir.close();
-    return (found > 0);
-}
-
-bool load_config()
-{
-    config.display_on = true; /* default */
-    config.ha_discovery = true; /* default */
-    config.debug_mode = false; /* default */
-    config.screensaver_mode = true; /* default */
-    config.mqtt_use_names = true;
-    config.proto_lacrosse = true;
-    config.proto_wh1080 = false;
-    config.proto_tx38it = false;
-    config.proto_tx35it = true;
-    config.proto_ws1600 = false;
-    config.proto_wt440xh = false;
-    config.proto_w136 = false;
-    config.proto_tx22it = false;
-    config.proto_emt7110 = false;  
-    config.proto_wh24 = false;
-    config.proto_wh25 = false;
-    config.proto_hp1000 = false;
-    config.proto_wh65b = false;    
-    config.toggle_interval_ms = 20000; /* default: 20 Sekunden */
-
-    if (!littlefs_ok)
-        return false;
-    
-    File cfg = LittleFS.open("/config.json");
-    JsonDocument doc;
-    DeserializationError error = deserializeJson(doc, cfg);
-    
-    if (error) {
-        Serial.println("Failed to read config.json");
-        Serial.print("error code: ");
-        Serial.println(error.code());
-    } else {
-        if (doc["mqtt_port"])
-            config.mqtt_port = doc["mqtt_port"];
-        if (doc["mqtt_server"]) {
-            const char *tmp = doc["mqtt_server"];
-            config.mqtt_server = String(tmp);
-        }
-        if (doc["mqtt_user"]) {
-            const char *tmp = doc["mqtt_user"];
-            config.mqtt_user = String(tmp);
-        }
-        if (doc["mqtt_pass"]) {
-            const char *tmp = doc["mqtt_pass"];
-            config.mqtt_pass = String(tmp);
-        }
-        if (!doc["display_on"].isNull())
-            config.display_on = doc["display_on"];
-        if (!doc["ha_discovery"].isNull())
-            config.ha_discovery = doc["ha_discovery"];
-        if (!doc["debug_mode"].isNull())
-            config.debug_mode = doc["debug_mode"];
-        if (!doc["screensaver_mode"].isNull()) {
-            config.screensaver_mode = doc["screensaver_mode"];
-        }
-        if (!doc["mqtt_use_names"].isNull()) {
-            config.mqtt_use_names = doc["mqtt_use_names"];
-        }
-        if (!doc["proto_lacrosse"].isNull())
-            config.proto_lacrosse = doc["proto_lacrosse"];
-        if (!doc["proto_wh1080"].isNull())
-            config.proto_wh1080 = doc["proto_wh1080"];
-        if (!doc["proto_tx38it"].isNull())
-            config.proto_tx38it = doc["proto_tx38it"];
-        if (!doc["proto_tx35it"].isNull())
-            config.proto_tx35it = doc["proto_tx35it"];
-        if (!doc["proto_ws1600"].isNull())
-            config.proto_ws1600 = doc["proto_ws1600"];
-        if (!doc["proto_wt440xh"].isNull())
-            config.proto_wt440xh = doc["proto_wt440xh"];
-        if (!doc["proto_w136"].isNull())
-            config.proto_w136 = doc["proto_w136"];
-        if (!doc["proto_tx22it"].isNull())
-            config.proto_tx22it = doc["proto_tx22it"];
-        if (!doc["proto_emt7110"].isNull())
-            config.proto_emt7110 = doc["proto_emt7110"];
-        if (!doc["proto_wh24"].isNull())
-            config.proto_wh24 = doc["proto_wh24"];
-        if (!doc["proto_wh25"].isNull())
-            config.proto_wh25 = doc["proto_wh25"];
-        if (!doc["proto_hp1000"].isNull())
-            config.proto_hp1000 = doc["proto_hp1000"];
-        if (!doc["proto_wh65b"].isNull())
-            config.proto_wh65b = doc["proto_wh65b"];
-        if (doc["toggle_interval_ms"])
-            config.toggle_interval_ms = doc["toggle_interval_ms"];
-            
-        Serial.println("result of config.json");
-        Serial.println("mqtt_server: " + config.mqtt_server);
-        Serial.println("mqtt_port: " + String(config.mqtt_port));
-        Serial.println("mqtt_user: " + config.mqtt_user);
-        Serial.println("mqtt_pass: " + String(config.mqtt_pass.length() > 0 ? "***" : "(not set)"));
-        Serial.println("ha_discovery: " + String(config.ha_discovery));
-        Serial.println("display_on: " + String(config.display_on));
-        Serial.println("debug_mode: " + String(config.debug_mode));
-        Serial.println("screensaver_mode: " + String(config.screensaver_mode));
-        Serial.println("proto_lacrosse: " + String(config.proto_lacrosse));
-        Serial.println("proto_wh1080: " + String(config.proto_wh1080));
-        Serial.println("proto_tx38it: " + String(config.proto_tx38it));
-        Serial.println("proto_tx35it: " + String(config.proto_tx35it));
-        Serial.println("proto_ws1600: " + String(config.proto_ws1600));
-        Serial.println("proto_wt440xh: " + String(config.proto_wt440xh));
-        Serial.println("proto_w136: " + String(config.proto_w136));
-        Serial.println("proto_tx22it: " + String(config.proto_tx22it));
-        Serial.println("proto_emt7110: " + String(config.proto_emt7110));
-        Serial.println("proto_wh24: " + String(config.proto_wh24));
-        Serial.println("proto_wh25: " + String(config.proto_wh25));
-        Serial.println("proto_hp1000: " + String(config.proto_hp1000));
-        Serial.println("proto_wh65b: " + String(config.proto_wh65b));
-        Serial.println("toggle_interval_ms: " + String(config.toggle_interval_ms));
-    }
-    
-    cfg.close();
-    config.changed = true;
-    return !error;
-}
-
-bool save_config()
-{
-    bool ret = true;
-    LittleFS.remove("/config.json");
-    File cfg = LittleFS.open("/config.json", FILE_WRITE);
-    
-    if (! cfg) {
-        Serial.println("Failed to open config.json for writing");
-        return false;
-    }
-    
-    JsonDocument doc;
-    doc["mqtt_port"] = config.mqtt_port;
-    doc["mqtt_server"] = config.mqtt_server;
-    doc["mqtt_user"] = config.mqtt_user;
-    doc["mqtt_pass"] = config.mqtt_pass;
-    doc["display_on"] = config.display_on;
-    doc["ha_discovery"] = config.ha_discovery;
-    doc["debug_mode"] = config.debug_mode;
-    doc["screensaver_mode"] = config.screensaver_mode;
-    doc["mqtt_use_names"] = config.mqtt_use_names;
-    doc["proto_lacrosse"] = config.proto_lacrosse;
-    doc["proto_wh1080"] = config.proto_wh1080;
-    doc["proto_tx38it"] = config.proto_tx38it;
-    doc["proto_tx35it"] = config.proto_tx35it;
-    doc["proto_ws1600"] = config.proto_ws1600;
-    doc["proto_wt440xh"] = config.proto_wt440xh;
-    doc["proto_w136"] = config.proto_w136;
-    doc["proto_tx22it"] = config.proto_tx22it;
-    doc["proto_emt7110"] = config.proto_emt7110;
-    doc["proto_wh24"] = config.proto_wh24;
-    doc["proto_wh25"] = config.proto_wh25;
-    doc["proto_hp1000"] = config.proto_hp1000;
-    doc["proto_wh65b"] = config.proto_wh65b;
-    doc["toggle_interval_ms"] = config.toggle_interval_ms;
-    
-    if (serializeJson(doc, cfg) == 0) {
-        Serial.println("FFailed to write config.json");
-        ret = false;
-    }
-    
-    cfg.close();
-    Serial.println("---written config.json");
-    cfg = LittleFS.open("/config.json");
-    Serial.println(read_file(cfg));
-    cfg.close();
-    Serial.println("---end config.json");
-    
-    return ret;
-}
-
-bool save_idmap()
-{
-    if (!littlefs_ok)
-        return false;
-    File idmapdir = LittleFS.open("/idmap");
-    if (!idmapdir) {
-        Serial.println("SAVE: /idmapdir not found");
-        if (LittleFS.mkdir("/idmap"))
-            idmapdir = LittleFS.open("/idmap");
-        else {
-            Serial.println("SAVE: mkdir /idmap failed :-(");
-            return false;
-        }
-    }
-    if (!idmapdir.isDirectory()) {
-        Serial.println("SAVE: /idmap not a directory");
-        idmapdir.close();
-        return false;
-    }
-    File file = idmapdir.openNextFile();
-    while (file) {
-        int id = name2id(file.name());
-        String fullname = "/idmap/" + String(file.name());
-        file.close();
-        if (id > -1 && id2name[id].length() == 0) {
-            Serial.print("removing ");
-            Serial.println(fullname);
-            if (!LittleFS.remove(fullname))
-                Serial.println("failed?");
-        }
-        file = idmapdir.openNextFile();
-    }
-    for (int i = 0; i < SENSOR_NUM; i++) {
-        if (id2name[i].length() == 0)
-            continue;
-        String fullname = String("/idmap/") + String((i < 0x10)?"0":"") + String(i, HEX);
-        if (LittleFS.exists(fullname)) {
-            //Serial.println("Exists: " + fullname);
-            File comp = LittleFS.open(fullname);
-            if (comp) {
-                //Serial.println("open: " + fullname);
-                String tmp = read_file(comp);
-                comp.close();
-                //Serial.print("tmp:");Serial.print(tmp);Serial.println("'");
-                //Serial.print("id2:");Serial.print(id2name[i]);Serial.println("'");
-                if (tmp == id2name[i])
-                    continue; /* skip unchanged settings */
-            }
-        }
-        Serial.println("Writing file " +fullname+" content: " + id2name[i]);
-        File file = LittleFS.open(fullname, FILE_WRITE);
-        if (! file) {
-            Serial.println("file open failed :-(");
-            continue;
-        }
-        file.print(id2name[i]);
-    }
-    return true;
-}
-
 void handle_check_update() {
     String response;
     
@@ -477,29 +197,31 @@ void add_current_table(String &s, bool rawdata)
     
     for (int i = 0; i < SENSOR_NUM; i++)
     {
+        Cache c;
+        cache_read(i, &c);
         // Filter: Überspringe ungültige, gelöschte oder rate=0 Sensoren
-        if (fcache[i].timestamp == 0 || fcache[i].ID == 0xFF || fcache[i].rate == 0)
+        if (c.timestamp == 0 || c.ID == 0xFF || c.rate == 0)
             continue;
             
-        if (fcache[i].temp_ch2 != 0 && fcache[i].temp_ch2 > -100 && fcache[i].temp_ch2 < 100)
+        if (c.temp_ch2 != 0 && c.temp_ch2 > -100 && c.temp_ch2 < 100)
             hasTempCh2 = true;
-        if (fcache[i].humi > 0 && fcache[i].humi <= 100)
+        if (c.humi > 0 && c.humi <= 100)
             hasHumidity = true;
-        if (fcache[i].wind_speed > 0)
+        if (c.wind_speed > 0)
             hasWindSpeed = true;
-        if (fcache[i].wind_direction >= 0 && fcache[i].wind_direction <= 360)
+        if (c.wind_direction >= 0 && c.wind_direction <= 360)
             hasWindDir = true;
-        if (fcache[i].wind_gust > 0)
+        if (c.wind_gust > 0)
             hasWindGust = true;
-        if (fcache[i].rain_total > 0)
+        if (c.rain_total > 0)
             hasRain = true;
-        if (fcache[i].power > 0)
+        if (c.power > 0)
             hasPower = true;
-        if (fcache[i].pressure > 0)
+        if (c.pressure > 0)
             hasPressure = true;
-        if (fcache[i].uv > 0 && fcache[i].uv <= 15)
+        if (c.uv > 0 && c.uv <= 15)
          hasUV = true;
-        if (fcache[i].light_lux > 0)
+        if (c.light_lux > 0)
             hasLight = true;
     }
     
@@ -551,20 +273,18 @@ void add_current_table(String &s, bool rawdata)
     // SCHRITT 3: Baue Tabellenzeilen dynamisch
     for (int i = 0; i < SENSOR_NUM; i++)
     {
-        if (fcache[i].timestamp == 0 || fcache[i].ID == 0xFF)
+        Cache c;
+        cache_read(i, &c);
+        if (c.timestamp == 0 || c.ID == 0xFF)
             continue;
             
         sensorCount++;
 
-        String name = id2name[fcache[i].ID];
-        if (name.length() == 0)
-            name = "-";
+        const char *name = has_sensor_name(c.ID) ? sensor_name(c.ID) : "-";
 
-        int displayID = fcache[i].ID;
+        int displayID = c.ID;
         
-        String sensorType = String(fcache[i].sensorType);
-        if (sensorType.length() == 0)
-            sensorType = "LaCrosse";
+        const char *sensorType = c.type != STR_NONE ? str_get(c.type) : "LaCrosse";
 
         s += "<tr>";
         
@@ -572,18 +292,20 @@ void add_current_table(String &s, bool rawdata)
         s += "<td>" + String(displayID) + "</td>";
         
         // Channel
-        s += "<td>" + String(fcache[i].channel) + "</td>";
+        s += "<td>" + String(c.channel) + "</td>";
         
         // Type
-        s += "<td>" + sensorType + "</td>";
+        s += "<td>";
+        s += sensorType;
+        s += "</td>";
 
         // Temperatur 1 (immer anzeigen)
-        s += "<td>" + String(fcache[i].temp, 1) + " °C</td>";
+        s += "<td>" + String(c.temp, 1) + " °C</td>";
 
         // Temperatur 2 (nur wenn Spalte sichtbar)
         if (hasTempCh2) {
-            if (fcache[i].temp_ch2 != 0 && fcache[i].temp_ch2 > -100 && fcache[i].temp_ch2 < 100) {
-                s += "<td>" + String(fcache[i].temp_ch2, 1) + " °C</td>";
+            if (c.temp_ch2 != 0 && c.temp_ch2 > -100 && c.temp_ch2 < 100) {
+                s += "<td>" + String(c.temp_ch2, 1) + " °C</td>";
             } else {
                 s += "<td>-</td>";
             }
@@ -591,8 +313,8 @@ void add_current_table(String &s, bool rawdata)
 
         // Luftfeuchtigkeit (nur wenn Spalte sichtbar)
         if (hasHumidity) {
-            if (fcache[i].humi > 0 && fcache[i].humi <= 100) {
-                s += "<td>" + String(fcache[i].humi) + " %</td>";
+            if (c.humi > 0 && c.humi <= 100) {
+                s += "<td>" + String(c.humi) + " %</td>";
             } else {
                 s += "<td>-</td>";
             }
@@ -600,8 +322,8 @@ void add_current_table(String &s, bool rawdata)
 
         // Wind Speed (nur wenn Spalte sichtbar)
         if (hasWindSpeed) {
-            if (fcache[i].wind_speed > 0) {
-                s += "<td>" + String(fcache[i].wind_speed, 1) + " km/h</td>";
+            if (c.wind_speed > 0) {
+                s += "<td>" + String(c.wind_speed, 1) + " km/h</td>";
             } else {
                 s += "<td>-</td>";
             }
@@ -609,8 +331,8 @@ void add_current_table(String &s, bool rawdata)
 
         // Wind Direction (nur wenn Spalte sichtbar)
         if (hasWindDir) {
-            if (fcache[i].wind_direction >= 0 && fcache[i].wind_direction <= 360) {
-                s += "<td>" + String(fcache[i].wind_direction) + "°</td>";
+            if (c.wind_direction >= 0 && c.wind_direction <= 360) {
+                s += "<td>" + String(c.wind_direction) + "°</td>";
             } else {
                 s += "<td>-</td>";
             }
@@ -618,8 +340,8 @@ void add_current_table(String &s, bool rawdata)
 
         // Wind Gust (nur wenn Spalte sichtbar)
         if (hasWindGust) {
-            if (fcache[i].wind_gust > 0) {
-                s += "<td>" + String(fcache[i].wind_gust) + " km/h</td>";
+            if (c.wind_gust > 0) {
+                s += "<td>" + String(c.wind_gust) + " km/h</td>";
             } else {
                 s += "<td>-</td>";
             }
@@ -627,8 +349,8 @@ void add_current_table(String &s, bool rawdata)
 
         // Rain (nur wenn Spalte sichtbar)
         if (hasRain) {
-            if (fcache[i].rain_total > 0) {
-                s += "<td>" + String(fcache[i].rain_total, 1) + " mm</td>";
+            if (c.rain_total > 0) {
+                s += "<td>" + String(c.rain_total, 1) + " mm</td>";
             } else {
                 s += "<td>-</td>";
             }
@@ -636,8 +358,8 @@ void add_current_table(String &s, bool rawdata)
 
         // Power (nur wenn Spalte sichtbar)
         if (hasPower) {
-            if (fcache[i].power > 0) {
-                s += "<td>" + String(fcache[i].power, 1) + " W</td>";
+            if (c.power > 0) {
+                s += "<td>" + String(c.power, 1) + " W</td>";
             } else {
                 s += "<td>-</td>";
             }
@@ -645,8 +367,8 @@ void add_current_table(String &s, bool rawdata)
 
         // Pressure (nur wenn Spalte sichtbar)
         if (hasPressure) {
-            if (fcache[i].pressure > 0) {
-                s += "<td>" + String(fcache[i].pressure, 1) + " hPa</td>";
+            if (c.pressure > 0) {
+                s += "<td>" + String(c.pressure, 1) + " hPa</td>";
             } else {
                 s += "<td>-</td>";
             }
@@ -654,8 +376,8 @@ void add_current_table(String &s, bool rawdata)
         
         // UV Index (nur wenn Spalte sichtbar)
         if (hasUV) {
-            if (fcache[i].uv > 0 && fcache[i].uv <= 15) {
-                s += "<td>" + String(fcache[i].uv) + "</td>";
+            if (c.uv > 0 && c.uv <= 15) {
+                s += "<td>" + String(c.uv) + "</td>";
             } else {
                 s += "<td>-</td>";
             }
@@ -663,8 +385,8 @@ void add_current_table(String &s, bool rawdata)
 
         // Light (nur wenn Spalte sichtbar)
         if (hasLight) {
-            if (fcache[i].light_lux > 0) {
-                s += "<td>" + String(fcache[i].light_lux, 0) + " lx</td>";
+            if (c.light_lux > 0) {
+                s += "<td>" + String(c.light_lux, 0) + " lx</td>";
             } else {
                 s += "<td>-</td>";
             }
@@ -672,24 +394,26 @@ void add_current_table(String &s, bool rawdata)
 
 
         // RSSI
-        s += "<td>" + String(fcache[i].rssi) + "</td>";
+        s += "<td>" + String(c.rssi) + "</td>";
 
         // Name
-        s += "<td>" + name + "</td>";
+        s += "<td>";
+        s += name;
+        s += "</td>";
 
         // Age
-        unsigned long age = now - fcache[i].timestamp;
+        unsigned long age = cache_age(c, now);
         s += "<td>" + String(age) + "</td>";
 
         // Battery
-        if (fcache[i].batlo) {
+        if (c.batlo) {
             s += "<td class='batt-weak'>weak</td>";
         } else {
             s += "<td class='batt-ok'>ok</td>";
         }
 
         // Init
-        if (fcache[i].init) {
+        if (c.init) {
             s += "<td class='init-new'>yes</td>";
         } else {
             s += "<td class='init-no'>no</td>";
@@ -700,7 +424,7 @@ void add_current_table(String &s, bool rawdata)
             s += "<td class='raw-data'>0x";
             for (int j = 0; j < FRAME_LENGTH; j++) {
                 char tmp[3];
-                snprintf(tmp, 3, "%02X", fcache[i].data[j]);
+                snprintf(tmp, 3, "%02X", c.data[j]);
                 s += String(tmp);
                 if (j < FRAME_LENGTH - 1)
                     s += " ";
@@ -727,107 +451,184 @@ void add_current_table(String &s, bool rawdata)
     s += "</div>";
 }
 
-// JSON-Endpoint für Sensordaten
+// Ein Sensor-Eintrag fuer /sensors.json; compact laesst leere Felder und Rohdaten weg
+static void add_sensor_json(JsonObject sensor, const Cache &c, unsigned long now, bool compact)
+{
+    sensor["id"] = c.ID;
+    sensor["ch"] = c.channel;
+    sensor["type"] = str_get(c.type);
+    sensor["temp"] = serialized(String(c.temp, 1));
+    
+    if (c.temp_ch2 != 0 && c.temp_ch2 > -100 && c.temp_ch2 < 100) {
+        sensor["temp2"] = serialized(String(c.temp_ch2, 1));
+    } else if (!compact) {
+        sensor["temp2"] = nullptr;
+    }
+    
+    if (!compact || (c.humi > 0 && c.humi <= 100))
+        sensor["humi"] = c.humi;
+    
+    // Wetterdaten
+    if (c.wind_speed > 0) {
+        sensor["wind_speed"] = serialized(String(c.wind_speed, 1));
+    } else if (!compact) {
+        sensor["wind_speed"] = nullptr;
+    }
+    
+    if (c.wind_direction >= 0 && c.wind_direction <= 360) {
+        sensor["wind_dir"] = c.wind_direction;
+    } else if (!compact) {
+        sensor["wind_dir"] = nullptr;
+    }
+    
+    if (c.wind_gust > 0) {
+        sensor["wind_gust"] = c.wind_gust;
+    } else if (!compact) {
+        sensor["wind_gust"] = nullptr;
+    }
+    
+    if (c.rain_total > 0) {
+        sensor["rain"] = serialized(String(c.rain_total, 1));
+    } else if (!compact) {
+        sensor["rain"] = nullptr;
+    }
+    
+    if (c.power > 0) {
+        sensor["power"] = serialized(String(c.power, 1));
+    } else if (!compact) {
+        sensor["power"] = nullptr;
+    }
+    if (c.pressure > 0) {
+        sensor["pressure"] = serialized(String(c.pressure, 1));
+    } else if (!compact) {
+        sensor["pressure"] = nullptr;
+    }
+    if (c.uv > 0 && c.uv <= 15) {
+        sensor["uv"] = c.uv;
+    } else if (!compact) {
+        sensor["uv"] = nullptr;
+    }
+    if (c.light_lux > 0) {
+        sensor["light_lux"] = serialized(String(c.light_lux, 0));
+    } else if (!compact) {
+        sensor["light_lux"] = nullptr;
+    }
+    
+    sensor["rssi"] = c.rssi;
+    if (!compact || has_sensor_name(c.ID))
+        sensor["name"] = sensor_name(c.ID);
+    sensor["age"] = cache_age(c, now);
+    sensor["batlo"] = c.batlo;
+    sensor["init"] = c.init;
+    sensor["seq"] = c.seq;
+    
+    if (compact)
+        return;
+
+    // Raw Data
+    String rawData = "";
+    for (int j = 0; j < FRAME_LENGTH; j++) {
+        char tmp[3];
+        snprintf(tmp, 3, "%02X", c.data[j]);
+        rawData += String(tmp);
+        if (j < FRAME_LENGTH - 1)
+            rawData += " ";
+    }
+    sensor["raw"] = rawData;
+}
+
+static inline bool sensor_listed(const Cache &c)
+{
+    // Filter: Überspringe ungültige, gelöschte oder rate=0 Sensoren
+    return !(c.timestamp == 0 || c.ID == 0xFF || c.rate == 0);
+}
+
+/*
+ * JSON-Endpoint für Sensordaten
+ *   ?since=<seq>  only sensors changed after update sequence <seq>, plus a
+ *                 "removed" list of expired IDs
+ *   &epoch=<e>    boot epoch of the answer <seq> came from; after a reboot
+ *                 (other epoch, or <seq> ahead of ours) the answer is a full
+ *                 list with "full": true
+ *   ?compact=1    skip null fields, raw data and the system block
+ * A weak ETag carries boot epoch and update sequence, If-None-Match => 304.
+ */
 void handle_sensors_json() {
+    uint32_t seq = sensor_seq;
+    bool compact = server.hasArg("compact") && server.arg("compact") != "0";
+    bool want_delta = server.hasArg("since");
+    uint32_t since = want_delta ? strtoul(server.arg("since").c_str(), NULL, 10) : 0;
+    bool same_boot = !server.hasArg("epoch") ||
+                     strtoul(server.arg("epoch").c_str(), NULL, 10) == boot_epoch;
+    bool delta = want_delta && same_boot && since <= seq;
+
+    // der System-Block gehoert mit zum Inhalt, ages/uptime nicht (daher weak)
+    String etag = "W/\"" + String(boot_epoch, HEX) + "-" + String(seq);
+    if (want_delta && !delta)
+        etag += "f";
+    if (compact)
+        etag += "c";
+    else
+        etag += "-" + String(mqtt_ok) + String(WiFi.status() == WL_CONNECTED) + "-" + String(get_current_datarate());
+    etag += "\"";
+    server.sendHeader("ETag", etag);
+    // Browser nicht revalidieren lassen, sonst frieren die Age-Spalten ein
+    server.sendHeader("Cache-Control", "no-store");
+    if (server.header("If-None-Match") == etag) {
+        server.send(304);
+        return;
+    }
+
     unsigned long now = millis();
     JsonDocument doc;
     JsonArray sensors = doc["sensors"].to<JsonArray>();
+    JsonArray removed;
+    if (delta)
+        removed = doc["removed"].to<JsonArray>();
     
     int sensorCount = 0;
-    for (int i = 0; i < SENSOR_NUM; i++) {
-        // Filter: Überspringe ungültige, gelöschte oder rate=0 Sensoren
-        if (fcache[i].timestamp == 0 || fcache[i].ID == 0xFF || fcache[i].rate == 0)
-            continue;
-        
-        JsonObject sensor = sensors.add<JsonObject>();
-        sensor["id"] = fcache[i].ID;
-        sensor["ch"] = fcache[i].channel;
-        sensor["type"] = String(fcache[i].sensorType);
-        sensor["temp"] = serialized(String(fcache[i].temp, 1));
-        
-        if (fcache[i].temp_ch2 != 0 && fcache[i].temp_ch2 > -100 && fcache[i].temp_ch2 < 100) {
-            sensor["temp2"] = serialized(String(fcache[i].temp_ch2, 1));
-        } else {
-            sensor["temp2"] = nullptr;
-        }
-        
-        sensor["humi"] = fcache[i].humi;
-        
-        // Wetterdaten
-        if (fcache[i].wind_speed > 0) {
-            sensor["wind_speed"] = serialized(String(fcache[i].wind_speed, 1));
-        } else {
-            sensor["wind_speed"] = nullptr;
-        }
-        
-        if (fcache[i].wind_direction >= 0 && fcache[i].wind_direction <= 360) {
-            sensor["wind_dir"] = fcache[i].wind_direction;
-        } else {
-            sensor["wind_dir"] = nullptr;
-        }
-        
-        if (fcache[i].wind_gust > 0) {
-            sensor["wind_gust"] = fcache[i].wind_gust;
-        } else {
-            sensor["wind_gust"] = nullptr;
-        }
-        
-        if (fcache[i].rain_total > 0) {
-            sensor["rain"] = serialized(String(fcache[i].rain_total, 1));
-        } else {
-            sensor["rain"] = nullptr;
-        }
-        
-        if (fcache[i].power > 0) {
-            sensor["power"] = serialized(String(fcache[i].power, 1));
-        } else {
-            sensor["power"] = nullptr;
-        }
-        if (fcache[i].pressure > 0) {
-            sensor["pressure"] = serialized(String(fcache[i].pressure, 1));
-        } else {
-            sensor["pressure"] = nullptr;
-        }
-        if (fcache[i].uv > 0 && fcache[i].uv <= 15) {
-            sensor["uv"] = fcache[i].uv;
-        } else {
-            sensor["uv"] = nullptr;
-        }
-        if (fcache[i].light_lux > 0) {
-            sensor["light_lux"] = serialized(String(fcache[i].light_lux, 0));
-        } else {
-            sensor["light_lux"] = nullptr;
+    Cache c;
+    if (delta && seq - since <= SEQ_LOG_SIZE) {
+        // O(changed): nur die Eintraege seit <since> aus dem Log ansehen
+        for (uint32_t s = since + 1; s <= seq; s++) {
+            cache_read(seq_log[s % SEQ_LOG_SIZE], &c);
+            if (c.seq != s)
+                continue; /* later update of the same sensor follows */
+            if (sensor_listed(c)) {
+                add_sensor_json(sensors.add<JsonObject>(), c, now, compact);
+                sensorCount++;
+            } else if (c.ID != 0xFF) {
+                removed.add(c.ID);
+            }
         }
-        
-        sensor["rssi"] = fcache[i].rssi;
-        sensor["name"] = id2name[fcache[i].ID];
-        sensor["age"] = now - fcache[i].timestamp;
-        sensor["batlo"] = fcache[i].batlo;
-        sensor["init"] = fcache[i].init;
-        
-        // Raw Data
-        String rawData = "";
-        for (int j = 0; j < FRAME_LENGTH; j++) {
-            char tmp[3];
-            snprintf(tmp, 3, "%02X", fcache[i].data[j]);
-            rawData += String(tmp);
-            if (j < FRAME_LENGTH - 1)
-                rawData += " ";
+    } else {
+        for (int i = 0; i < SENSOR_NUM; i++) {
+            cache_read(i, &c);
+            if (delta && c.seq <= since)
+                continue;
+            if (sensor_listed(c)) {
+                add_sensor_json(sensors.add<JsonObject>(), c, now, compact);
+                sensorCount++;
+            } else if (delta && c.ID != 0xFF) {
+                removed.add(c.ID);
+            }
         }
-        sensor["raw"] = rawData;
-        
-        sensorCount++;
     }
     
     doc["count"] = sensorCount;
-    doc["loop_count"] = loop_count;
-    doc["uptime"] = time_string();
-    doc["mqtt_ok"] = mqtt_ok;
-    doc["wifi_ok"] = (WiFi.status() == WL_CONNECTED);
-    doc["wifi_ssid"] = WiFi.SSID();
-    doc["wifi_ip"] = WiFi.localIP().toString();
-    doc["cpu_usage"] = serialized(String(cpu_usage, 1));
-    doc["current_datarate"] = get_current_datarate();
+    doc["seq"] = seq;
+    doc["epoch"] = boot_epoch;
+    if (want_delta)
+        doc["full"] = !delta;
+    if (!compact) {
+        doc["uptime"] = time_string();
+        doc["mqtt_ok"] = mqtt_ok;
+        doc["wifi_ok"] = (WiFi.status() == WL_CONNECTED);
+        doc["wifi_ssid"] = WiFi.SSID();
+        doc["wifi_ip"] = WiFi.localIP().toString();
+        doc["cpu_usage"] = serialized(String(cpu_usage, 1));
+        doc["current_datarate"] = get_current_datarate();
+    }
     
     String output;
     serializeJson(doc, output);
@@ -1894,6 +1695,7 @@ void handle_api_reboot() {
     
     // Warte kurz, damit Antwort gesendet wird
     delay(1000);
+    snapshot_save();
     
     // Führe Reboot durch
     ESP.restart();
@@ -1909,14 +1711,303 @@ void handle_api_system() {
     doc["wifi_ssid"] = WiFi.SSID();
     doc["wifi_ip"] = WiFi.localIP().toString();
     doc["cpu_usage"] = serialized(String(cpu_usage, 1));
-    doc["loop_count"] = loop_count;
     doc["version"] = LACROSSE2MQTT_VERSION;
+
+    JsonArray cores = doc["cpu_load"].to<JsonArray>();
+    for (int core = 0; core < portNUM_PROCESSORS; core++)
+        cores.add(serialized(String(perf_cpu_load(core), 1)));
+
+    // Laufzeit je Stufe in us
+    JsonObject perf = doc["perf"].to<JsonObject>();
+    for (int s = 0; s < PERF_NUM; s++) {
+        PerfStage stage = (PerfStage)s;
+        JsonObject st = perf[perf_stage_name(stage)].to<JsonObject>();
+        st["count"] = perf_hist(stage).count;
+        st["p50"] = perf_percentile(stage, 0.50);
+        st["p99"] = perf_percentile(stage, 0.99);
+        st["max"] = perf_hist(stage).max_us;
+    }
+
+    // Zeit vom Funk bis zur jeweiligen Station in us
+    trace_report(doc["latency"].to<JsonObject>());
+
+    // Heap, Fragmentierung und Verlauf (heapmon.h)
+    heap_report(doc["heap"].to<JsonObject>(), true);
+
+    // Startablauf in ms seit dem Boot, null = noch nicht erreicht
+    JsonObject boot = doc["boot_ms"].to<JsonObject>();
+    const uint32_t steps[] = { boot_times.radio, boot_times.first_frame, boot_times.wifi,
+                               boot_times.ntp, boot_times.mqtt };
+    const char *names[] = { "radio", "first_frame", "wifi", "ntp", "mqtt" };
+    for (int i = 0; i < 5; i++) {
+        if (steps[i])
+            boot[names[i]] = steps[i];
+        else
+            boot[names[i]] = nullptr;
+    }
     
     String output;
     serializeJson(doc, output);
     server.send(200, "application/json", output);
 }
 
+// Konfiguration und Namen als JSON, ?secrets=1 mit MQTT-Passwort; POST importiert
+void handle_api_config() {
+    if (server.method() == HTTP_POST) {
+        JsonDocument doc;
+        DeserializationError error = deserializeJson(doc, server.arg("plain"));
+        if (error) {
+            server.send(400, "text/plain", String("invalid JSON: ") + error.c_str() + "\n");
+            return;
+        }
+        state_lock();
+        config_from_json(doc);
+        config.changed = true;
+        state_unlock();
+        log_set_level(config.debug_mode ? LL_DEBUG : LL_INFO);
+        if (!config_save()) {
+            server.send(500, "text/plain", "saving the configuration failed\n");
+            return;
+        }
+    }
+    JsonDocument doc;
+    config_to_json(doc, server.arg("secrets") == "1");
+    String output;
+    serializeJson(doc, output);
+    server.send(200, "application/json", output);
+}
+
+// Ende des Logs (asynclog), ?since=<n> nur neuere Zeilen, ?level= setzt das Log-Level bis zum Neustart
+void handle_log() {
+    if (server.hasArg("level")) {
+        LogLevel level;
+        if (!log_parse_level(server.arg("level").c_str(), &level)) {
+            server.send(400, "text/plain", "level: error, warn, info or debug\n");
+            return;
+        }
+        log_set_level(level);
+    }
+    uint32_t since = server.hasArg("since") ? server.arg("since").toInt() : 0;
+    String out;
+    uint32_t last = log_tail(out, since);
+    server.sendHeader("X-Log-Seq", String(last));
+    server.sendHeader("X-Log-Level", log_level_name((LogLevel)log_level));
+    server.send(200, "text/plain; charset=utf-8", out);
+}
+
+static void metrics_send_chunk(const char *buf, size_t len)
+{
+    server.sendContent(buf, len);
+}
+
+// Prometheus Scrape-Endpoint, wird stueckweise gestreamt statt als ein String gebaut
+void handle_metrics() {
+    server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+    server.send(200, "text/plain; version=0.0.4; charset=utf-8", "");
+    metrics_write(metrics_send_chunk);
+    server.sendContent("");
+}
+
+/* statische Seite aus dem Flash, gzip wie abgelegt; Quelle web/charts.html */
+void handle_charts()
+{
+    server.sendHeader("ETag", CHARTS_HTML_ETAG);
+    server.sendHeader("Cache-Control", "no-cache");
+    if (server.header("If-None-Match") == CHARTS_HTML_ETAG) {
+        server.send(304);
+        return;
+    }
+    server.sendHeader("Content-Encoding", "gzip");
+    server.send_P(200, "text/html", (const char *)charts_html_gz, CHARTS_HTML_GZ_LEN);
+}
+
+/* Antwort in einem festen Puffer sammeln und als Chunks schicken */
+struct ChunkOut {
+    char buf[1024];
+    size_t len = 0;
+
+    void printf(const char *fmt, ...) __attribute__((format(printf, 2, 3))) {
+        if (len > sizeof(buf) - 128)
+            flush();
+        va_list ap;
+        va_start(ap, fmt);
+        int n = vsnprintf(buf + len, sizeof(buf) - len, fmt, ap);
+        va_end(ap);
+        if (n > 0)
+            len += min((size_t)n, sizeof(buf) - len - 1);
+    }
+    void flush() {
+        if (len)
+            server.sendContent(buf, len);
+        len = 0;
+    }
+};
+
+/* Sensor per ID (dezimal) oder Name */
+static int history_sensor_arg(const String &key)
+{
+    char *end;
+    long id = strtol(key.c_str(), &end, 10);
+    if (key.length() && *end == '\0' && id >= 0 && id < SENSOR_NUM)
+        return GetCacheIndex(id, 1);
+    for (int i = 0; i < SENSOR_NUM; i++)
+        if (has_sensor_name(i) && key == sensor_name(i))
+            return GetCacheIndex(i, 1);
+    return -1;
+}
+
+/* feinste Stufe, die nicht feiner als step ist und bis from zurueckreicht */
+static HistTier history_tier(const HistInfo &info, uint32_t from, uint32_t step)
+{
+    // Minutenring reicht bis from; nur aus Stundensegmenten: keine Minuten
+    bool minutes = info.raw_last && info.raw_last < HIST_MINUTES * 60UL + from;
+    if (step < 60 && info.raw_first && from >= info.raw_first)
+        return HT_RAW;
+    if (step < 3600 && minutes)
+        return HT_MINUTE;
+    return HT_HOUR;
+}
+
+static void history_list()
+{
+    JsonDocument doc;
+    doc["raw_retention"] = history_raw_retention();
+    JsonArray list = doc["series"].to<JsonArray>();
+    HistInfo info;
+    for (int i = 0; history_info(i, &info); i++) {
+        JsonObject s = list.add<JsonObject>();
+        s["id"] = info.sensor;
+        if (has_sensor_name(info.sensor))
+            s["name"] = sensor_name(info.sensor);
+        s["metric"] = info.metric;
+        s["first"] = info.first;
+        s["last"] = info.last;
+        s["samples"] = info.samples;
+    }
+    String out;
+    serializeJson(doc, out);
+    server.send(200, "application/json", out);
+}
+
+/*
+ * Verlauf eines Messwerts, ohne sensor= die Liste der Serien.
+ *   sensor=<ID|Name> metric=temp from=/to= (Unix-Zeit, Standard: letzte 24 h)
+ *   step=<s> Bucket-Laenge, Standard (to - from) / 500; 0 = Rohwerte
+ *   format=csv|json
+ * Gestreamt in Portionen aus dem Verlauf, nie als ganzes Dokument im RAM.
+ * Liegt der Bereich komplett vor dem offenen Intervall und noch ganz im
+ * Speicher, aendert er sich nicht mehr: ETag, If-None-Match => 304.
+ */
+void handle_api_history()
+{
+    if (!server.hasArg("sensor")) {
+        history_list();
+        return;
+    }
+    int sensor = history_sensor_arg(server.arg("sensor"));
+    String metric = server.hasArg("metric") ? server.arg("metric") : String("temp");
+    int series = sensor < 0 ? -1 : history_find(sensor, metric.c_str());
+    HistInfo info;
+    if (series < 0 || !history_info(series, &info)) {
+        server.send(404, "text/plain", "no history for this sensor/metric\n");
+        return;
+    }
+    uint32_t now = time(nullptr);
+    if (now < HIST_MIN_EPOCH && !server.hasArg("to")) {
+        server.send(503, "text/plain", "time not synced yet\n");
+        return;
+    }
+    uint32_t to = server.hasArg("to") ? strtoul(server.arg("to").c_str(), NULL, 10) : now;
+    uint32_t from = server.hasArg("from") ? strtoul(server.arg("from").c_str(), NULL, 10)
+                                          : (to > 86400 ? to - 86400 : 0);
+    if (from > to) {
+        server.send(400, "text/plain", "from > to\n");
+        return;
+    }
+    uint32_t step = server.hasArg("step") ? strtoul(server.arg("step").c_str(), NULL, 10)
+                                          : (to - from) / 500 + 1;
+    bool csv = server.arg("format") == "csv";
+    // gelesen wird nur, was es gibt; from/to in der Antwort bleiben wie angefragt
+    uint32_t read_from = max(from, info.first);
+    uint32_t read_to = min(to, info.last);
+    HistTier tier = history_tier(info, read_from, step);
+
+    // abgeschlossen: neue Werte kommen nur nach dem letzten, nichts ist schon verdraengt
+    static const uint32_t tier_len[HT_NUM] = { 1, 60, 3600 };
+    uint32_t last = tier == HT_HOUR ? info.last : info.raw_last;
+    uint32_t oldest = tier == HT_RAW ? info.raw_first
+                    : last - last % tier_len[tier] - (tier == HT_MINUTE ? HIST_MINUTES - 1 : HIST_HOURS - 1) * tier_len[tier];
+    bool closed = to < last - last % tier_len[tier] && from >= oldest;
+    if (closed) {
+        char etag[64];
+        snprintf(etag, sizeof(etag), "\"h%d-%lu-%lu-%lu-%d%c\"", series, (unsigned long)from,
+                 (unsigned long)to, (unsigned long)step, tier, csv ? 'c' : 'j');
+        server.sendHeader("ETag", etag);
+        server.sendHeader("Cache-Control", "no-cache");
+        if (server.header("If-None-Match") == etag) {
+            server.send(304);
+            return;
+        }
+    }
+
+    server.setContentLength(CONTENT_LENGTH_UNKNOWN);
+    server.send(200, csv ? "text/csv" : "application/json", "");
+    ChunkOut out;
+    int dec = info.decimals;
+    if (csv)
+        out.printf("time,min,avg,max,count\n");
+    else
+        out.printf("{\"id\":%u,\"metric\":\"%s\",\"from\":%lu,\"to\":%lu,\"step\":%lu,\"points\":[",
+                   info.sensor, info.metric, (unsigned long)from, (unsigned long)to, (unsigned long)step);
+
+    HistPoint pts[32];
+    bool first = true;
+    // aktueller Bucket: min/max, nach count gewichtetes Mittel
+    uint32_t bt = 0, bcount = 0;
+    float bmin = 0, bmax = 0;
+    double bsum = 0;
+    auto emit = [&]() {
+        if (!bcount)
+            return;
+        if (csv)
+            out.printf("%lu,%.*f,%.*f,%.*f,%lu\n", (unsigned long)bt,
+                       dec, bmin, dec + 1, bsum / bcount, dec, bmax, (unsigned long)bcount);
+        else
+            out.printf("%s[%lu,%.*f,%.*f,%.*f,%lu]", first ? "" : ",", (unsigned long)bt,
+                       dec, bmin, dec + 1, bsum / bcount, dec, bmax, (unsigned long)bcount);
+        first = false;
+        bcount = 0;
+    };
+    for (uint32_t t = read_from; t <= read_to; ) {
+        uint32_t next;
+        size_t n = history_read(series, tier, t, read_to, pts, sizeof(pts) / sizeof(pts[0]), &next);
+        for (size_t i = 0; i < n; i++) {
+            const HistPoint &p = pts[i];
+            uint32_t b = step ? p.t - p.t % step : p.t;
+            if (bcount && b != bt)
+                emit();
+            if (!bcount) {
+                bt = b;
+                bmin = p.min;
+                bmax = p.max;
+                bsum = 0;
+            }
+            bmin = min(bmin, p.min);
+            bmax = max(bmax, p.max);
+            bsum += (double)p.avg * p.count;
+            bcount += p.count;
+        }
+        if (n == 0 || next <= t)
+            break;
+        t = next;
+    }
+    emit();
+    if (!csv)
+        out.printf("]}\n");
+    out.flush();
+    server.sendContent("");
+}
+
 void handle_index()
 {
     String index;
@@ -1953,6 +2044,7 @@ void handle_index()
     index += "<h2>Quick Actions</h2>";
     index += "<div class='action-buttons'>";
     index += "<a href='/config.html' class='action-button'>⚙️ Configuration</a>";
+    index += "<a href='/charts.html' class='action-button'>📈 Charts</a>";
     if (config.debug_mode) {
         index += "<a href='/debug.html' class='action-button action-button-warning'>🐛 Debug Log</a>";
     }
@@ -2205,7 +2297,10 @@ static bool config_changed = false;
 void handle_config() {
     static unsigned long token = millis();
     static bool just_saved = false;
+    bool do_save = false;
     
+    // Aenderungen unter dem Lock, der Empfang liest id2name/config parallel
+    state_lock();
     if (server.hasArg("id") && server.hasArg("name")) {
         String _id = server.arg("id");
         String name = server.arg("name");
@@ -2213,7 +2308,7 @@ void handle_config() {
         if (_id[0] >= '0' && _id[0] <= '9') {
             int id = _id.toInt();
             if (id >= 0 && id < SENSOR_NUM) {
-                id2name[id] = name;
+                id2name[id] = str_intern(name.c_str());
                 config_changed = true;
             }
         }
@@ -2242,8 +2337,7 @@ void handle_config() {
     if (server.hasArg("save")) {
         if (server.arg("save") == String(token)) {
             Serial.println("SAVE!");
-            save_idmap();
-            save_config();
+            do_save = true;
             config_changed = false;
             just_saved = true;
         }
@@ -2254,6 +2348,7 @@ void handle_config() {
         if (tmp != config.debug_mode) {
             config_changed = true;
             config.debug_mode = tmp;
+            log_set_level(config.debug_mode ? LL_DEBUG : LL_INFO);
             Serial.println("Debug mode changed to: " + String(config.debug_mode));
         }
     }
@@ -2276,10 +2371,34 @@ void handle_config() {
             Serial.println("MQTT use names changed to " + String(config.mqtt_use_names));
         }
     }
+    if (server.hasArg("lacrosse_fec")) {
+        String on = server.arg("lacrosse_fec");
+        int tmp = on.toInt();
+        if (tmp != config.lacrosse_fec) {
+            config_changed = true;
+            config.lacrosse_fec = tmp;
+            Serial.println("LaCrosse error correction changed to " + String(config.lacrosse_fec));
+        }
+    }
+    if (server.hasArg("filter_temp_step")) {
+        float tmp = server.arg("filter_temp_step").toFloat();
+        if (tmp >= 0 && tmp <= 50 && tmp != config.filter_temp_step) {
+            config_changed = true;
+            config.filter_temp_step = tmp;
+            Serial.println("Outlier filter temperature step changed to " + String(tmp, 1));
+        }
+    }
+    if (server.hasArg("filter_humi_step")) {
+        float tmp = server.arg("filter_humi_step").toFloat();
+        if (tmp >= 0 && tmp <= 100 && tmp != config.filter_humi_step) {
+            config_changed = true;
+            config.filter_humi_step = tmp;
+            Serial.println("Outlier filter humidity step changed to " + String(tmp, 1));
+        }
+    }
     if (server.hasArg("cancel")) {
         if (server.arg("cancel") == String(token)) {
-            load_idmap();
-            load_config();
+            config_load();
             config_changed = false;
         }
     }
@@ -2298,12 +2417,10 @@ void handle_config() {
             config_changed = true;
             config.display_on = tmp;
         
-            if (!config.display_on) {
-                display.ssd1306_command(SSD1306_DISPLAYOFF);
-            } else {
-                display.ssd1306_command(SSD1306_DISPLAYON);
+            // Ein-/Ausschalten uebernimmt update_display() im Display-Task,
+            // kein I2C-Zugriff aus dem Webserver-Task
+            if (config.display_on)
                 auto_display_on = uptime_sec();
-            }
         }
     }
     if (server.hasArg("ha_disc")) {
@@ -2436,6 +2553,12 @@ void handle_config() {
         }
 
     }
+    state_unlock();
+
+    // LittleFS-Schreibzugriffe ohne Lock, nur dieser Task aendert die Daten
+    if (do_save) {
+        config_save();
+    }
 
     token = millis();
     
@@ -2493,7 +2616,6 @@ if (just_saved) {
     resp += "<p class='info-text' id='wifi-rssi'>RSSI: " + String(WiFi.RSSI()) + " dBm </p>";
     resp += "<p class='info-text' id='system-uptime'>Uptime: " + time_string() + "</p>";
     resp += "<p class='info-text' id='current-datarate'>Current Data Rate: <span id='datarate-value'>" + String(get_current_datarate()) + "</span> bps</p>";
-    resp += "<p class='info-text'>Loop Count: " + String(loop_count) + "</p>";
     resp += "<p class='info-text'>Software: " + String(LACROSSE2MQTT_VERSION) + "</p>";
     resp += "<p class='info-text'>Built: " + String(__DATE__) + " " + String(__TIME__) + "</p>";
     resp += "<p class='info-text'>Reset reason: " + ESP32GetResetReason(0) + "</p>";
@@ -2755,6 +2877,40 @@ if (any_active && interval_sec > 0) {
     resp += "</form>";
     resp += "</div>";
 
+    resp += "<div class='card'>";
+    resp += "<h2>LaCrosse Error Correction</h2>";
+    resp += "<form action='/config.html'>";
+    resp += "<div class='radio-group'>";
+    resp += "  <div class='radio-item'>";
+    resp += "    <label>";
+    resp += "      <input type='radio' name='lacrosse_fec' value='1'" + (config.lacrosse_fec ? checked : "") + "/>";
+    resp += "      Correct single-bit errors";
+    resp += "    </label>";
+    resp += "    <div class='option-description'>Repair LaCrosse IT+ frames that fail the CRC by one bit, if the result matches the last value of that sensor</div>";
+    resp += "  </div>";
+    resp += "  <div class='radio-item'>";
+    resp += "    <label>";
+    resp += "      <input type='radio' name='lacrosse_fec' value='0'" + (!config.lacrosse_fec ? checked : "") + "/>";
+    resp += "      Disable";
+    resp += "    </label>";
+    resp += "  </div>";
+    resp += "</div>";
+    resp += "<button type='submit'>Update Error Correction</button>";
+    resp += "</form>";
+    resp += "</div>";
+
+    resp += "<div class='card'>";
+    resp += "<h2>Outlier Filter</h2>";
+    resp += "<form action='/config.html'>";
+    resp += "<div class='option-description'>A reading that jumps further than this from the last one is held back until the next frame confirms it (0 = off)</div>";
+    resp += "<label>Temperature step (&deg;C):</label>";
+    resp += "<input type='number' name='filter_temp_step' min='0' max='50' step='0.1' value='" + String(config.filter_temp_step, 1) + "'>";
+    resp += "<label>Humidity step (%):</label>";
+    resp += "<input type='number' name='filter_humi_step' min='0' max='100' step='1' value='" + String(config.filter_humi_step, 0) + "'>";
+    resp += "<button type='submit'>Update Filter</button>";
+    resp += "</form>";
+    resp += "</div>";
+
     resp += "<div class=\"card\">";
     resp += "<h2>MQTT Topic Settings</h2>";
     resp += "<form action=\"config.html\">";
@@ -3077,13 +3233,10 @@ void handle_debug() {
         resp += "<td>" + String(age) + "</td>";
         
         // Raw Data
+        char raw[3 * FRAME_LENGTH + 1];
+        format_raw(raw, sizeof(raw), debug_log[idx].data, FRAME_LENGTH);
         resp += "<td class=\"rawdata\">0x";
-        for (int j = 0; j < FRAME_LENGTH; j++) {
-            char tmp[3];
-            snprintf(tmp, 3, "%02X", debug_log[idx].data[j]);
-            resp += String(tmp);
-            if (j < FRAME_LENGTH - 1) resp += " ";
-        }
+        resp += raw;
         resp += "</td>";
         
         resp += "<td>" + String(debug_log[idx].rssi) + "</td>";
@@ -3232,19 +3385,44 @@ void handle_update_page() {
     server.send(200, "text/html", page);
 }
 
+/* Der Webserver laeuft als eigener Task auf Core 0, damit Config-Speichern,
+ * Update-Check (bis zu 15s Timeout) oder grosse Seiten den Empfang im
+ * Loop-Task (Core 1) nicht mehr aufhalten. */
+#define WEB_TASK_STACK 12288
+#define WEB_TASK_CORE 0
+
+// Laufzeit der Seiten/API-Handler fuer perfstats (Updates laufen bewusst ungemessen)
+template <void (*handler)()>
+static void timed()
+{
+    PerfTimer t(PERF_WEB);
+    handler();
+}
+
+static void web_task(void *arg)
+{
+    for (;;) {
+        server.handleClient();
+        delay(2);
+    }
+}
+
+/* vor dem Funkmodul, braucht nur LittleFS */
+void setup_config()
+{
+    if (!config_load())
+        Serial.println("setup_config ERROR: config_load() failed?");
+}
+
+/* erst mit WLAN, der Konfigurationsportal von WiFiManager belegt Port 80 */
 void setup_web()
 {
-    if (!load_idmap())
-        Serial.println("setup_web ERROR: load_idmap() failed?");
-    if (!load_config())
-        Serial.println("setup_web ERROR: load_config() failed?");
-    
-    server.on("/", handle_index);
-    server.on("/index.html", handle_index);
-    server.on("/sensors.json", handle_sensors_json);
-    server.on("/config.html", handle_config);
-    server.on("/debug.html", handle_debug);
-    server.on("/licenses.html", handle_licenses);
+    server.on("/", timed<handle_index>);
+    server.on("/index.html", timed<handle_index>);
+    server.on("/sensors.json", timed<handle_sensors_json>);
+    server.on("/config.html", timed<handle_config>);
+    server.on("/debug.html", timed<handle_debug>);
+    server.on("/licenses.html", timed<handle_licenses>);
     server.on("/update", HTTP_GET, handle_update_page);
     server.on("/check-update", handle_check_update);
     server.on("/check-update-insecure", handle_check_update_insecure);
@@ -3252,8 +3430,16 @@ void setup_web()
     server.on("/install-update-insecure", HTTP_POST, handle_install_update_insecure);
     server.on("/update-progress", handle_update_progress);
     server.on("/api/reboot", HTTP_POST, handle_api_reboot);
-    server.on("/api/system", handle_api_system);
+    server.on("/api/system", timed<handle_api_system>);
+    server.on("/api/config", timed<handle_api_config>);
+    server.on("/metrics", timed<handle_metrics>);
+    server.on("/log.txt", timed<handle_log>);
+    server.on("/api/history", timed<handle_api_history>);
+    server.on("/charts.html", timed<handle_charts>);
     
+    const char *headerkeys[] = { "If-None-Match" };
+    server.collectHeaders(headerkeys, sizeof(headerkeys) / sizeof(headerkeys[0]));
+
     server.onNotFound([]() {
         server.send(404, "text/plain", "The content you are looking for was not found.\n");
         Serial.println("404: " + server.uri());
@@ -3261,9 +3447,8 @@ void setup_web()
     
     httpUpdater.setup(&server);
     server.begin();
-}
 
-void handle_client()
-{
-    server.handleClient();
-}
\ No newline at end of file
+    TaskHandle_t handle;
+    xTaskCreatePinnedToCore(web_task, "web", WEB_TASK_STACK, NULL, 1, &handle, WEB_TASK_CORE);
+    metrics_register_task(MT_WEB, handle);
+}
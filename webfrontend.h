@@ -3,10 +3,10 @@
 
 #include <Arduino.h>
 
+void setup_config();
 void setup_web();
 void handle_index();
 void handle_config();
-void handle_client();
 void handle_licenses();
 void add_debug_log(uint8_t *data, int8_t rssi, int datarate, bool valid);
 
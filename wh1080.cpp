@@ -1,4 +1,7 @@
 #include "wh1080.h"
+#include "asynclog.h"
+#include "frameformat.h"
+#include "metrics.h"
 #include <Arduino.h>
 
 /*
@@ -48,7 +51,8 @@ bool WH1080::DecodeFrame(byte *bytes, byte len, struct Frame *f)
     // CRC Prüfung
     byte crc_calc = CalculateCRC(bytes, len - 1);
     if (crc_calc != bytes[len - 1]) {
-        Serial.printf(" [WH1080 CRC fail: calc=%02X got=%02X]", crc_calc, bytes[len-1]);
+        LogInfo.printf(" [WH1080 CRC fail: calc=%02X got=%02X]", crc_calc, bytes[len-1]);
+        metrics.crc_errors[PROTO_WH1080]++;
         f->valid = false;
         return false;
     }
@@ -93,36 +97,27 @@ bool WH1080::TryHandleData(byte *data, byte len, struct Frame *f)
     return false;
 }
 
+static const char *wh1080_dir(const void *f)
+{
+    return WH1080::GetWindDirection(((WH1080::Frame *)f)->wind_bearing);
+}
+
+static const FrameField wh1080_fields[] = {
+    FRAME_FIELD(WH1080::Frame, station_id, " ID%02X"),
+    FRAME_FIELD(WH1080::Frame, temp, " Temp%.1f°C"),
+    FRAME_FIELD(WH1080::Frame, humi, " Humi%d%%"),
+    FRAME_FIELD(WH1080::Frame, rain, " Rain%.1fmm"),
+    FRAME_FIELD(WH1080::Frame, wind_speed, " Wind%.1fm/s"),
+    FRAME_FIELD(WH1080::Frame, wind_gust, " Gust%.1fm/s"),
+    FRAME_TEXT(" Dir%s", wh1080_dir),
+};
+static const FrameFormat wh1080_format = FRAME_FORMAT("WH1080  ", WH1080::Frame, wh1080_fields);
+
 bool WH1080::DisplayFrame(byte *data, byte len, struct Frame *f)
 {
-    static unsigned long last[SENSOR_NUM];
     if (!f->valid) {
-        Serial.println("WH1080::DisplayFrame FRAME INVALID");
+        LOGW("WH1080::DisplayFrame FRAME INVALID");
         return false;
     }
-
-    DisplayRaw(last[f->ID], "WH1080  ", data, len, f->rssi, f->rate);
-    
-    Serial.printf(" ID%02X", f->station_id);
-    Serial.printf(" Temp%.1f°C", f->temp);
-    Serial.printf(" Humi%d%%", f->humi);
-    Serial.printf(" Rain%.1fmm", f->rain);
-    Serial.printf(" Wind%.1fm/s", f->wind_speed);
-    Serial.printf(" Gust%.1fm/s", f->wind_gust);
-    Serial.printf(" Dir%s", GetWindDirection(f->wind_bearing));
-    Serial.println();
-    
-    return true;
-}
-
-void WH1080::DisplayRaw(unsigned long &last, const char *dev, uint8_t *data, uint8_t len, int8_t rssi, int rate)
-{
-    unsigned long now = millis();
-    if (last == 0)
-        last = now;
-    Serial.printf("%6ld %s [", (now - last), dev);
-    last = now;
-    for (uint8_t i = 0; i < len; i++)
-        Serial.printf("%02X%s", data[i], (i == len - 1) ? "" : " ");
-    Serial.printf("] rssi%-4d rate%-5d", rssi, rate);
+    return print_frame(wh1080_format, f, data, len);
 }
\ No newline at end of file
@@ -24,7 +24,6 @@ namespace WH1080 {
     bool TryHandleData(byte *data, byte len, struct Frame *f);
     bool DecodeFrame(byte *bytes, byte len, struct Frame *f);
     bool DisplayFrame(byte *data, byte len, struct Frame *f);
-    void DisplayRaw(unsigned long &last, const char *dev, uint8_t *data, uint8_t len, int8_t rssi, int rate);
     
     byte CalculateCRC(byte *data, byte len);
     const char* GetWindDirection(byte bearing);
@@ -1,4 +1,6 @@
 #include "wh24.h"
+#include "asynclog.h"
+#include "frameformat.h"
 #include "globals.h"
 
 // Hilfsfunktion für Windrichtung
@@ -29,7 +31,7 @@ bool WH24::TryHandleData(byte *payload, int payloadSize, Frame *frame) {
     frame->crc = payload[WH24_FRAME_LENGTH - 1];
     
     if (calculated_crc != frame->crc) {
-        Serial.println("WH24: CRC error");
+        LogInfo.println("WH24: CRC error");
         frame->valid = false;
         return false;
     }
@@ -75,60 +77,26 @@ bool WH24::TryHandleData(byte *payload, int payloadSize, Frame *frame) {
     return true;
 }
 
-void WH24::DisplayFrame(byte *payload, int payloadSize, Frame *frame) {
-    Serial.println();
-    Serial.println("===== WH24 Weather Station =====");
-    Serial.print("ID: ");
-    Serial.println(frame->ID, HEX);
-    Serial.print("Temperature: ");
-    Serial.print(frame->temp, 1);
-    Serial.println(" °C");
-    Serial.print("Humidity: ");
-    Serial.print(frame->humi);
-    Serial.println(" %");
-    Serial.print("Pressure: ");
-    Serial.print(frame->pressure, 1);
-    Serial.println(" hPa");
-    Serial.print("Wind Speed: ");
-    Serial.print(frame->wind_speed, 1);
-    Serial.println(" km/h");
-    Serial.print("Wind Gust: ");
-    Serial.print(frame->wind_gust, 1);
-    Serial.println(" km/h");
-    Serial.print("Wind Direction: ");
-    Serial.print(GetWindDirection(frame->wind_bearing));
-    Serial.print(" (");
-    Serial.print(frame->wind_bearing);
-    Serial.println("°)");
-    Serial.print("Rain: ");
-    Serial.print(frame->rain, 1);
-    Serial.println(" mm");
-    Serial.print("UV Index: ");
-    Serial.println(frame->uv_index);
-    Serial.print("Battery: ");
-    Serial.println(frame->batlo ? "LOW" : "OK");
-    Serial.print("RSSI: ");
-    Serial.print(frame->rssi);
-    Serial.println(" dBm");
-    Serial.println("================================");
+static const char *wh24_dir(const void *f)
+{
+    return GetWindDirection(((WH24::Frame *)f)->wind_bearing);
 }
 
-void WH24::DisplayRaw(unsigned long &last, const char *dev, uint8_t *data, uint8_t len, int8_t rssi, int rate) {
-    unsigned long now = millis();
-    if (now - last < 1000)
-        return;
-    last = now;
-    
-    Serial.print(dev);
-    Serial.print(": ");
-    for (int i = 0; i < len; i++) {
-        if (data[i] < 0x10)
-            Serial.print("0");
-        Serial.print(data[i], HEX);
-        Serial.print(" ");
-    }
-    Serial.print(" RSSI: ");
-    Serial.print(rssi);
-    Serial.print(" Rate: ");
-    Serial.println(rate);
+static const FrameField wh24_fields[] = {
+    FRAME_FIELD(WH24::Frame, ID, " ID%02X"),
+    FRAME_FIELD(WH24::Frame, temp, " Temp%.1f°C"),
+    FRAME_FIELD(WH24::Frame, humi, " Humi%d%%"),
+    FRAME_FIELD(WH24::Frame, pressure, " Press%.1fhPa"),
+    FRAME_FIELD(WH24::Frame, wind_speed, " Wind%.1fkm/h"),
+    FRAME_FIELD(WH24::Frame, wind_gust, " Gust%.1fkm/h"),
+    FRAME_TEXT(" Dir%s", wh24_dir),
+    FRAME_FIELD(WH24::Frame, wind_bearing, "(%d°)"),
+    FRAME_FIELD(WH24::Frame, rain, " Rain%.1fmm"),
+    FRAME_FIELD(WH24::Frame, uv_index, " UV%d"),
+    FRAME_FIELD(WH24::Frame, batlo, " batlo%d"),
+};
+static const FrameFormat wh24_format = FRAME_FORMAT("WH24    ", WH24::Frame, wh24_fields);
+
+void WH24::DisplayFrame(byte *payload, int payloadSize, Frame *frame) {
+    print_frame(wh24_format, frame, payload, payloadSize);
 }
\ No newline at end of file
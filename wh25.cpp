@@ -1,4 +1,6 @@
 #include "wh25.h"
+#include "asynclog.h"
+#include "frameformat.h"
 #include "globals.h"
 
 bool WH25::TryHandleData(byte *payload, int payloadSize, Frame *frame) {
@@ -16,7 +18,7 @@ bool WH25::TryHandleData(byte *payload, int payloadSize, Frame *frame) {
     frame->crc = payload[WH25_FRAME_LENGTH - 1];
     
     if (sum != frame->crc) {
-        Serial.println("WH25: CRC error");
+        LogInfo.println("WH25: CRC error");
         frame->valid = false;
         return false;
     }
@@ -43,44 +45,15 @@ bool WH25::TryHandleData(byte *payload, int payloadSize, Frame *frame) {
     return true;
 }
 
-void WH25::DisplayFrame(byte *payload, int payloadSize, Frame *frame) {
-    Serial.println();
-    Serial.println("===== WH25 Pressure Sensor =====");
-    Serial.print("ID: ");
-    Serial.println(frame->ID, HEX);
-    Serial.print("Temperature: ");
-    Serial.print(frame->temp, 1);
-    Serial.println(" °C");
-    Serial.print("Humidity: ");
-    Serial.print(frame->humi);
-    Serial.println(" %");
-    Serial.print("Pressure: ");
-    Serial.print(frame->pressure, 1);
-    Serial.println(" hPa");
-    Serial.print("Battery: ");
-    Serial.println(frame->batlo ? "LOW" : "OK");
-    Serial.print("RSSI: ");
-    Serial.print(frame->rssi);
-    Serial.println(" dBm");
-    Serial.println("================================");
-}
+static const FrameField wh25_fields[] = {
+    FRAME_FIELD(WH25::Frame, ID, " ID%02X"),
+    FRAME_FIELD(WH25::Frame, temp, " Temp%.1f°C"),
+    FRAME_FIELD(WH25::Frame, humi, " Humi%d%%"),
+    FRAME_FIELD(WH25::Frame, pressure, " Press%.1fhPa"),
+    FRAME_FIELD(WH25::Frame, batlo, " batlo%d"),
+};
+static const FrameFormat wh25_format = FRAME_FORMAT("WH25    ", WH25::Frame, wh25_fields);
 
-void WH25::DisplayRaw(unsigned long &last, const char *dev, uint8_t *data, uint8_t len, int8_t rssi, int rate) {
-    unsigned long now = millis();
-    if (now - last < 1000)
-        return;
-    last = now;
-    
-    Serial.print(dev);
-    Serial.print(": ");
-    for (int i = 0; i < len; i++) {
-        if (data[i] < 0x10)
-            Serial.print("0");
-        Serial.print(data[i], HEX);
-        Serial.print(" ");
-    }
-    Serial.print(" RSSI: ");
-    Serial.print(rssi);
-    Serial.print(" Rate: ");
-    Serial.println(rate);
+void WH25::DisplayFrame(byte *payload, int payloadSize, Frame *frame) {
+    print_frame(wh25_format, frame, payload, payloadSize);
 }
\ No newline at end of file
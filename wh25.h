@@ -20,7 +20,6 @@ namespace WH25 {
     
     bool TryHandleData(byte *payload, int payloadSize, Frame *frame);
     void DisplayFrame(byte *payload, int payloadSize, Frame *frame);
-    void DisplayRaw(unsigned long &last, const char *dev, uint8_t *data, uint8_t len, int8_t rssi, int rate);
 }
 
 #endif
\ No newline at end of file
@@ -1,4 +1,7 @@
 #include "wh65b.h"
+#include "asynclog.h"
+#include "frameformat.h"
+#include "metrics.h"
 
 namespace WH65B {
 
@@ -35,7 +38,10 @@ bool TryHandleData(uint8_t *data, int len, Frame *frame) {
     if (data[0] != 0xFF) return false;
     
     // CRC Check
-    if (crc8(data, 15) != data[15]) return false;
+    if (crc8(data, 15) != data[15]) {
+        metrics.crc_errors[PROTO_WH65B]++;
+        return false;
+    }
     
     frame->ID = data[1];
     frame->channel = 1;
@@ -75,36 +81,22 @@ bool TryHandleData(uint8_t *data, int len, Frame *frame) {
     return true;
 }
 
+static const FrameField wh65b_fields[] = {
+    FRAME_FIELD(Frame, ID, " ID%02X"),
+    FRAME_FIELD(Frame, temp, " Temp%.1f°C"),
+    FRAME_FIELD(Frame, humi, " Humi%d%%"),
+    FRAME_FIELD(Frame, wind_speed, " Wind%.2fm/s"),
+    FRAME_FIELD(Frame, wind_gust, " Gust%.2fm/s"),
+    FRAME_FIELD(Frame, wind_direction, " Dir%d°"),
+    FRAME_FIELD(Frame, rain, " Rain%.1fmm"),
+    FRAME_FIELD(Frame, uv, " UV%d"),
+    FRAME_FIELD(Frame, light_lux, " Light%.0flux"),
+    FRAME_FIELD(Frame, batlo, " batlo%d"),
+};
+static const FrameFormat wh65b_format = FRAME_FORMAT("WH65B   ", Frame, wh65b_fields);
+
 void DisplayFrame(uint8_t *data, int len, Frame *frame) {
-    Serial.println("\n--- WH65B Weather Sensor ---");
-    Serial.print("ID: ");
-    Serial.println(frame->ID, HEX);
-    Serial.print("Temperature: ");
-    Serial.print(frame->temp, 1);
-    Serial.println(" °C");
-    Serial.print("Humidity: ");
-    Serial.print(frame->humi);
-    Serial.println(" %");
-    Serial.print("Wind Speed: ");
-    Serial.print(frame->wind_speed, 2);
-    Serial.println(" m/s");
-    Serial.print("Wind Gust: ");
-    Serial.print(frame->wind_gust, 2);
-    Serial.println(" m/s");
-    Serial.print("Wind Direction: ");
-    Serial.print(frame->wind_direction);
-    Serial.println("°");
-    Serial.print("Rain: ");
-    Serial.print(frame->rain, 1);
-    Serial.println(" mm");
-    Serial.print("UV Index: ");
-    Serial.println(frame->uv);
-    Serial.print("Light: ");
-    Serial.print(frame->light_lux, 0);
-    Serial.println(" lux");
-    Serial.print("Battery: ");
-    Serial.println(frame->batlo ? "LOW" : "OK");
-    Serial.println("-------------------------");
+    print_frame(wh65b_format, frame, data, len);
 }
 
 } // namespace WH65B
\ No newline at end of file
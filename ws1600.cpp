@@ -1,4 +1,6 @@
 #include "ws1600.h"
+#include "asynclog.h"
+#include "frameformat.h"
 #include <Arduino.h>
 
 /*
@@ -53,36 +55,23 @@ bool WS1600::TryHandleData(byte *data, byte len, struct Frame *f)
     return false;
 }
 
+static const FrameField ws1600_fields[] = {
+    FRAME_FIELD(WS1600::Frame, ID, " ID%d"),
+    FRAME_FIELD(WS1600::Frame, channel, " Ch%d"),
+    FRAME_FIELD(WS1600::Frame, temp, " Temp%.1f°C"),
+    FRAME_FIELD(WS1600::Frame, humi, " Humi%d%%"),
+    FRAME_FIELD(WS1600::Frame, rain, " Rain%.1fmm"),
+    FRAME_FIELD(WS1600::Frame, wind_speed, " Wind%.1fm/s"),
+    FRAME_FIELD(WS1600::Frame, wind_direction, " Dir%d"),
+    FRAME_FIELD(WS1600::Frame, batlo, " batlo%d"),
+};
+static const FrameFormat ws1600_format = FRAME_FORMAT("WS1600  ", WS1600::Frame, ws1600_fields);
+
 bool WS1600::DisplayFrame(byte *data, byte len, struct Frame *f)
 {
-    static unsigned long last[SENSOR_NUM];
     if (!f->valid) {
-        Serial.println("WS1600::DisplayFrame FRAME INVALID");
+        LOGW("WS1600::DisplayFrame FRAME INVALID");
         return false;
     }
-
-    DisplayRaw(last[f->ID], "WS1600  ", data, len, f->rssi, f->rate);
-    
-    Serial.printf(" ID%d Ch%d", f->ID, f->channel);
-    Serial.printf(" Temp%.1f°C", f->temp);
-    Serial.printf(" Humi%d%%", f->humi);
-    Serial.printf(" Rain%.1fmm", f->rain);
-    Serial.printf(" Wind%.1fm/s", f->wind_speed);
-    Serial.printf(" Dir%d", f->wind_direction);
-    Serial.printf(" batlo%d", f->batlo);
-    Serial.println();
-    
-    return true;
-}
-
-void WS1600::DisplayRaw(unsigned long &last, const char *dev, uint8_t *data, uint8_t len, int8_t rssi, int rate)
-{
-    unsigned long now = millis();
-    if (last == 0)
-        last = now;
-    Serial.printf("%6ld %s [", (now - last), dev);
-    last = now;
-    for (uint8_t i = 0; i < len; i++)
-        Serial.printf("%02X%s", data[i], (i == len - 1) ? "" : " ");
-    Serial.printf("] rssi%-4d rate%-5d", rssi, rate);
+    return print_frame(ws1600_format, f, data, len);
 }
\ No newline at end of file
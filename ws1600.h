@@ -23,7 +23,6 @@ namespace WS1600 {
     bool TryHandleData(byte *data, byte len, struct Frame *f);
     bool DecodeFrame(byte *bytes, byte len, struct Frame *f);
     bool DisplayFrame(byte *data, byte len, struct Frame *f);
-    void DisplayRaw(unsigned long &last, const char *dev, uint8_t *data, uint8_t len, int8_t rssi, int rate);
 }
 
 #endif
\ No newline at end of file
@@ -1,4 +1,6 @@
 #include "wt440xh.h"
+#include "asynclog.h"
+#include "frameformat.h"
 #include <Arduino.h>
 
 /*
@@ -50,33 +52,20 @@ bool WT440XH::TryHandleData(byte *data, struct Frame *f)
     return DecodeFrame(data, f);
 }
 
+static const FrameField wt440xh_fields[] = {
+    FRAME_FIELD(WT440XH::Frame, ID, " ID%d"),
+    FRAME_FIELD(WT440XH::Frame, channel, " Ch%d"),
+    FRAME_FIELD(WT440XH::Frame, temp, " Temp%.1f°C"),
+    FRAME_FIELD(WT440XH::Frame, humi, " Humi%d%%"),
+    FRAME_FIELD(WT440XH::Frame, batlo, " batlo%d"),
+};
+static const FrameFormat wt440xh_format = FRAME_FORMAT("WT440XH ", WT440XH::Frame, wt440xh_fields);
+
 bool WT440XH::DisplayFrame(byte *data, struct Frame *f)
 {
-    static unsigned long last[SENSOR_NUM];
     if (!f->valid) {
-        Serial.println("WT440XH::DisplayFrame FRAME INVALID");
+        LOGW("WT440XH::DisplayFrame FRAME INVALID");
         return false;
     }
-
-    DisplayRaw(last[f->ID], "WT440XH ", data, 4, f->rssi, f->rate);
-    
-    Serial.printf(" ID%d Ch%d", f->ID, f->channel);
-    Serial.printf(" Temp%.1f°C", f->temp);
-    Serial.printf(" Humi%d%%", f->humi);
-    Serial.printf(" batlo%d", f->batlo);
-    Serial.println();
-    
-    return true;
-}
-
-void WT440XH::DisplayRaw(unsigned long &last, const char *dev, uint8_t *data, uint8_t len, int8_t rssi, int rate)
-{
-    unsigned long now = millis();
-    if (last == 0)
-        last = now;
-    Serial.printf("%6ld %s [", (now - last), dev);
-    last = now;
-    for (uint8_t i = 0; i < len; i++)
-        Serial.printf("%02X%s", data[i], (i == len - 1) ? "" : " ");
-    Serial.printf("] rssi%-4d rate%-5d", rssi, rate);
+    return print_frame(wt440xh_format, f, data, 4);
 }
\ No newline at end of file
@@ -20,7 +20,6 @@ namespace WT440XH {
     bool TryHandleData(byte *data, struct Frame *f);
     bool DecodeFrame(byte *bytes, struct Frame *f);
     bool DisplayFrame(byte *data, struct Frame *f);
-    void DisplayRaw(unsigned long &last, const char *dev, uint8_t *data, uint8_t len, int8_t rssi, int rate);
 }
 
 #endif
\ No newline at end of file